@@ -57,7 +57,7 @@ namespace Library
 		if (parent == nullptr) { return nullptr; } //if no parent, there is no entity. Return nullptr.
 
 		//if parent is an ActionList, go up the hierarchy and see if you can find an entity
-		if (parent->Is(ActionList::TypeIdClass())) 
+		if (parent->Is<ActionList>()) 
 		{ 
 			return static_cast<ActionList*>(parent)->GetEntity(); 
 		}
@@ -89,10 +89,7 @@ namespace Library
 
 	Vector<Signature> Action::Signatures()
 	{
-		return Vector<Signature>
-		{
-			Signature("Name", DatumType::String, 1, offsetof(Action, mName))
-		};
+		return ToSignatures(StaticSignatures());
 	}
 
 
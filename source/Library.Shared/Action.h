@@ -107,6 +107,12 @@ namespace Library
 		/// <returns>The prescribed attributes for an action</returns>
 		static Vector<Signature> Signatures();
 
+		/// <summary>
+		/// The prescribed attributes as a constexpr table, see Signatures()
+		/// </summary>
+		/// <returns>A StaticSignature for each prescribed attribute</returns>
+		static constexpr std::array<StaticSignature, 1> StaticSignatures();
+
 	protected:
 		/// <summary>
 		/// "Virtual Constructor" passes correct typeID to Attributed so it can get signatures
@@ -135,5 +141,13 @@ namespace Library
 		std::string mName;
 		bool bRunOnce = false; //todo: make this a prescribed attribute
 	};
+
+	constexpr std::array<StaticSignature, 1> Action::StaticSignatures()
+	{
+		return
+		{
+			SIGNATURE(Action, "Name", DatumType::String, 1, mName)
+		};
+	}
 }
 
@@ -55,14 +55,14 @@ namespace Library
 		return new ActionCreateAction(*this);
 	}
 
+	gsl::owner<Scope*> ActionCreateAction::Relocate()
+	{
+		return RelocateAs(*this);
+	}
+
 	Vector<Signature> ActionCreateAction::Signatures()
 	{
-		return Vector<Signature>
-		{
-			Signature("Name", DatumType::String, 1, offsetof(ActionCreateAction, mName)),
-			Signature("Prototype", DatumType::String, 1, offsetof(ActionCreateAction, mPrototype)),
-			Signature("ActionName", DatumType::String, 1, offsetof(ActionCreateAction, mActionName))
-		};
+		return ToSignatures(StaticSignatures());
 	}
 }
 
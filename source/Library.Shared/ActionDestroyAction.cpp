@@ -2,6 +2,8 @@
 #include "ActionDestroyAction.h"
 #include "World.h"
 #include "WorldState.h"
+#include "Entity.h"
+#include "ActionList.h"
 
 namespace Library
 {
@@ -26,12 +28,27 @@ namespace Library
 				throw std::runtime_error("Action name cannot be empty");
 			}
 
-			//find action
-			auto actionDatum = Search("Actions");
+			//find action: the nearest entity or action list above this holds it
+			Datum* actionDatum = nullptr;
+			for (Scope* scope = mParent; scope != nullptr && actionDatum == nullptr; scope = scope->GetParent())
+			{
+				if (scope->Is<Entity>())
+				{
+					actionDatum = &static_cast<Entity*>(scope)->Actions();
+				}
+				else if (scope->Is<ActionList>())
+				{
+					actionDatum = &static_cast<ActionList*>(scope)->Actions();
+				}
+			}
+			if (actionDatum == nullptr)
+			{
+				throw std::runtime_error("No entity or action list to remove action from");
+			}
 			for (size_t i = 0; i < actionDatum->Size(); i++)
 			{
 				Scope& actionScope = actionDatum->Get<Scope>(i);
-				assert(actionScope.Is(Action::TypeIdClass()));
+				assert(actionScope.Is<Action>());
 				Action* action = static_cast<Action*>(&actionScope);
 				//remove action
 				if (action->Name() == mActionName)
@@ -60,12 +77,13 @@ namespace Library
 		return new ActionDestroyAction(*this);
 	}
 
+	gsl::owner<Scope*> ActionDestroyAction::Relocate()
+	{
+		return RelocateAs(*this);
+	}
+
 	Vector<Signature> ActionDestroyAction::Signatures()
 	{
-		return Vector<Signature>
-		{
-			Signature("Name", DatumType::String, 1, offsetof(ActionDestroyAction, mName)),
-			Signature("ActionName", DatumType::String, 1, offsetof(ActionDestroyAction, mActionName))
-		};
+		return ToSignatures(StaticSignatures());
 	}
 }
\ No newline at end of file
@@ -45,15 +45,35 @@ namespace Library
 		/// <returns>a heap allocated copy of this</returns>
 		gsl::owner<ActionDestroyAction*> Clone() const override;
 
+		/// <summary>
+		/// Moves this into a new heap allocated ActionDestroyAction, see Scope::Relocate
+		/// </summary>
+		/// <returns>the relocated scope</returns>
+		gsl::owner<Scope*> Relocate() override;
+
 		/// <summary>
 		/// Gets signatures to populate this
 		/// </summary>
 		/// <returns>The signatures used to populate this on construction</returns>
 		static Vector<Signature> Signatures();
+
+		/// <summary>
+		/// The prescribed attributes as a constexpr table, see Signatures(). Only those added to Action's: register with Action as the parent type.
+		/// </summary>
+		/// <returns>A StaticSignature for each prescribed attribute not inherited</returns>
+		static constexpr std::array<StaticSignature, 1> StaticSignatures();
 	private:
 		std::string mActionName;
 		bool bHasUpdated = false;
 	};
+
+	constexpr std::array<StaticSignature, 1> ActionDestroyAction::StaticSignatures()
+	{
+		return
+		{
+			SIGNATURE(ActionDestroyAction, "ActionName", DatumType::String, 1, mActionName)
+		};
+	}
 	ConcreteFactory(ActionDestroyAction, Scope)
 }
 
@@ -66,14 +66,14 @@ namespace Library
 		return new ActionEvent(*this);
 	}
 
+	gsl::owner<Scope*> ActionEvent::Relocate()
+	{
+		return RelocateAs(*this);
+	}
+
 	Vector<Signature> ActionEvent::Signatures()
 	{
-		return Vector<Signature>
-		{
-			Signature("Name", DatumType::String, 1, offsetof(ActionEvent, mName)),
-			Signature("Subtype", DatumType::String, 1, offsetof(ActionEvent, mSubtype)),
-			Signature("Delay", DatumType::Integer, 1, offsetof(ActionEvent, mDelay))
-		};
+		return ToSignatures(StaticSignatures());
 	}
 
 }
\ No newline at end of file
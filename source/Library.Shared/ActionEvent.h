@@ -57,15 +57,36 @@ namespace Library
 		/// <returns>Create a heap allocated copy of this</returns>
 		gsl::owner<ActionEvent*> Clone() const override;
 
+		/// <summary>
+		/// Moves this into a new heap allocated ActionEvent, see Scope::Relocate
+		/// </summary>
+		/// <returns>the relocated scope</returns>
+		gsl::owner<Scope*> Relocate() override;
+
 		/// <summary>
 		/// Get the signatures to populate this
 		/// </summary>
 		/// <returns>the signatures to populate this class</returns>
 		static Vector<Signature> Signatures();
+
+		/// <summary>
+		/// The prescribed attributes as a constexpr table, see Signatures(). Only those added to Action's: register with Action as the parent type.
+		/// </summary>
+		/// <returns>A StaticSignature for each prescribed attribute not inherited</returns>
+		static constexpr std::array<StaticSignature, 2> StaticSignatures();
 	private:
 		std::string mSubtype;
 		int mDelay;
 	};
+
+	constexpr std::array<StaticSignature, 2> ActionEvent::StaticSignatures()
+	{
+		return
+		{
+			SIGNATURE(ActionEvent, "Subtype", DatumType::String, 1, mSubtype),
+			SIGNATURE(ActionEvent, "Delay", DatumType::Integer, 1, mDelay)
+		};
+	}
 	ConcreteFactory(ActionEvent, Scope)
 }
 
@@ -10,18 +10,20 @@ namespace Library
 
 	void ActionIncrement::Update([[maybe_unused]] WorldState& state)
 	{
-		//if operand not yet set, search for it.
-		if (mOperandDatum == nullptr)
+		//the Operand attribute can be written directly, not just through SetOperandString
+		if (mOperandPath.ToString() != mOperandString)
 		{
-			mOperandDatum = Search(mOperandString);
-			if (mOperandDatum == nullptr)
-			{
-				throw std::runtime_error("Operand not found");
-			}
+			mOperandPath = ScopePath(mOperandString);
 		}
 
-		//todo: maybe cache another int reference so don't have to do the checks every time?
-		mOperandDatum->Get<int>() += mStep;
+		//resolve every update rather than keeping the Datum*, which goes stale if the hierarchy changes. The path caches it until then.
+		Datum* operand = mOperandPath.Resolve(*this);
+		if (operand == nullptr)
+		{
+			throw std::runtime_error("Operand not found");
+		}
+
+		operand->Get<int>(mOperandPath.Index()) += mStep;
 	}
 
 	void ActionIncrement::SetOperandString(const std::string& operand)
@@ -49,13 +51,13 @@ namespace Library
 		return new ActionIncrement(*this);
 	}
 
+	gsl::owner<Scope*> ActionIncrement::Relocate()
+	{
+		return RelocateAs(*this);
+	}
+
 	Vector<Signature> ActionIncrement::Signatures()
 	{
-		return Vector<Signature>
-		{
-			Signature("Name", DatumType::String, 1, offsetof(ActionIncrement, mName)),
-			Signature("Operand", DatumType::String, 1, offsetof(ActionIncrement, mOperandString)),
-			Signature("Step", DatumType::Integer, 1, offsetof(ActionIncrement, mStep))
-		};
+		return ToSignatures(StaticSignatures());
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "Action.h"
 #include "Factory.h"
+#include "ScopePath.h"
 
 namespace Library
 {
@@ -16,8 +17,8 @@ namespace Library
 
 		/// <summary>
 		/// Increment the given operand by step amount. 
-		/// If operand datum not yet set, searches using operand string. 
-		/// Does not yet support any kind of addressing yet. Just takes the first datum search gives.
+		/// The operand is a ScopePath: its first key is searched for from this action up, e.g. "Health" or "Entities[2].Health".
+		/// The resolved datum is cached until the hierarchy changes.
 		/// </summary>
 		/// <param name="state">The current world state</param>
 		/// <exception cref="std::runtime_error">Throws exception if operand cannot be found</exception>
@@ -53,16 +54,37 @@ namespace Library
 		/// <returns>A heap allocated copy of this</returns>
 		gsl::owner<ActionIncrement*> Clone() const override;
 
+		/// <summary>
+		/// Moves this into a new heap allocated ActionIncrement, see Scope::Relocate
+		/// </summary>
+		/// <returns>the relocated scope</returns>
+		gsl::owner<Scope*> Relocate() override;
+
 		/// <summary>
 		/// Signatures for prescribed attributes of this class
 		/// </summary>
 		/// <returns>Signatures for prescribed attributes of this class</returns>
 		static Vector<Signature> Signatures();
+
+		/// <summary>
+		/// The prescribed attributes as a constexpr table, see Signatures(). Only those added to Action's: register with Action as the parent type.
+		/// </summary>
+		/// <returns>A StaticSignature for each prescribed attribute not inherited</returns>
+		static constexpr std::array<StaticSignature, 2> StaticSignatures();
 	private:
 		std::string mOperandString; //the name of the operand
+		ScopePath mOperandPath; //mOperandString compiled, recompiled when the Operand attribute changes
 		int mStep = 1;
-		Datum* mOperandDatum = nullptr;
 	};
+
+	constexpr std::array<StaticSignature, 2> ActionIncrement::StaticSignatures()
+	{
+		return
+		{
+			SIGNATURE(ActionIncrement, "Operand", DatumType::String, 1, mOperandString),
+			SIGNATURE(ActionIncrement, "Step", DatumType::Integer, 1, mStep)
+		};
+	}
 	ConcreteFactory(ActionIncrement, Scope)
 }
 
@@ -9,30 +9,26 @@ namespace Library
 
 	ActionList::ActionList() : Action(TypeIdClass())
 	{
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
 	}
 
 	ActionList::ActionList(const std::string& name, Entity* entity) :
 		Action(TypeIdClass(), name, entity)
 	{
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
 	}
 
 	ActionList::ActionList(std::string&& name, Entity* entity) :
 		Action(TypeIdClass(), std::move(name), entity)
 	{
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
 	}
 
 	void ActionList::Update(WorldState& state)
 	{
-		for (size_t i = 0; i < mActionsDatum->Size(); i++)
+		if (!IsMaterialized()) { return; }	//nothing was added to a deferred Actions table, resolving it would only materialize the layout
+		Datum& actions = Actions();
+		for (size_t i = 0; i < actions.Size(); i++)
 		{
-			Scope& action = mActionsDatum->Get<Scope>(i);
-			assert(action.Is(Action::TypeIdClass()));
+			Scope& action = actions.Get<Scope>(i);
+			assert(action.Is<Action>());
 			state.mAction = &static_cast<Action&>(action);
 			static_cast<Action&>(action).Update(state);
 		}
@@ -41,14 +37,12 @@ namespace Library
 
 	Datum& ActionList::Actions()
 	{
-		assert(mActionsDatum != nullptr); //sanity check
-		return *mActionsDatum;
+		return PrescribedAttribute(ACTIONS_INDEX);
 	}
 
 	const Datum& ActionList::Actions() const
 	{
-		assert(mActionsDatum != nullptr); //sanity check
-		return *mActionsDatum;
+		return PrescribedAttribute(ACTIONS_INDEX);
 	}
 
 	Action* ActionList::CreateAction(const std::string& className, const std::string& instanceName)
@@ -70,35 +64,30 @@ namespace Library
 		return new ActionList(*this);
 	}
 
+	gsl::owner<Scope*> ActionList::Relocate()
+	{
+		return RelocateAs(*this);
+	}
+
 	Vector<Signature> ActionList::Signatures()
 	{
-		return Vector<Signature>
-		{
-			Signature("Name", DatumType::String, 1, offsetof(ActionList, mName)),
-			Signature(ACTIONS_STRING, DatumType::Table, START_ACTIONS_CAPACITY, 0)
-		};
+		return ToSignatures(StaticSignatures());
 	}
 
 	//protected
 	ActionList::ActionList(RTTI::IdType typeID) : Action(typeID)
 	{
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
 	}
 
 	//protected
 	ActionList::ActionList(RTTI::IdType typeID, const std::string& name, Entity* entity) :
 		Action(typeID, name, entity)
 	{
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
 	}
 
 	//protected
 	ActionList::ActionList(RTTI::IdType typeID, std::string&& name, Entity* entity) :
 		Action(typeID, std::move(name), entity)
 	{
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
 	}
 }
\ No newline at end of file
@@ -29,7 +29,7 @@ namespace Library
 		explicit ActionList(std::string&& name, Entity* entity = nullptr);
 
 		/// <summary>
-		/// Copy constructor: Default scope copy constructor
+		/// Copy constructor: default scope copy constructor
 		/// </summary>
 		/// <param name="rhs">the actionlist to copy</param>
 		ActionList(const ActionList& rhs) = default;
@@ -49,7 +49,7 @@ namespace Library
 		/// Copy assignment: default scope copy assignment
 		/// </summary>
 		/// <param name="rhs">the actionlist to copy</param>
-		/// <returns>A copy of the actionlist</returns>
+		/// <returns>A reference to this actionlist</returns>
 		ActionList& operator=(const ActionList& rhs) = default;
 
 		/// <summary>
@@ -99,13 +99,26 @@ namespace Library
 		/// <returns>a pointer to a new ActionList (that is a copy of this)</returns>
 		virtual gsl::owner<ActionList*> Clone() const override;
 
+		/// <summary>
+		/// Moves this into a new heap allocated ActionList, see Scope::Relocate
+		/// </summary>
+		/// <returns>the relocated scope</returns>
+		virtual gsl::owner<Scope*> Relocate() override;
+
 		/// <summary>
 		/// Gets the prescribed attributes for an actionlist
 		/// </summary>
 		/// <returns>The prescribed attributes for an actionlist</returns>
 		static Vector<Signature> Signatures();
 
+		/// <summary>
+		/// The prescribed attributes as a constexpr table, see Signatures(). Only those added to Action's: register with Action as the parent type.
+		/// </summary>
+		/// <returns>A StaticSignature for each prescribed attribute not inherited</returns>
+		static constexpr std::array<StaticSignature, 1> StaticSignatures();
+
 		static const inline std::string ACTIONS_STRING = "Actions";
+		static const size_t ACTIONS_INDEX;	//index of ACTIONS_STRING in the registered signatures, after Action's. Looked up in StaticSignatures() below, see PrescribedAttribute
 
 	protected:
 		/// <summary>
@@ -130,8 +143,19 @@ namespace Library
 		/// <param name="entity">The entity this actionlist belongs to</param>
 		ActionList(RTTI::IdType typeID, std::string&& name, Entity* entity = nullptr);
 
-		Datum* mActionsDatum = nullptr;
 		static const size_t START_ACTIONS_CAPACITY = 23;
 	};
+
+	constexpr std::array<StaticSignature, 1> ActionList::StaticSignatures()
+	{
+		return
+		{
+			TABLE_SIGNATURE("Actions", START_ACTIONS_CAPACITY)
+		};
+	}
+
+	//the registered signatures start with the ones inherited from Action
+	inline constexpr size_t ActionList::ACTIONS_INDEX = Action::StaticSignatures().size() + SignatureIndex(ActionList::StaticSignatures(), "Actions");
+
 	ConcreteFactory(ActionList, Scope)
 }
\ No newline at end of file
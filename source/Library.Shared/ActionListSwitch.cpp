@@ -7,8 +7,23 @@ namespace Library {
 	ActionListSwitch::ActionListSwitch() :
 		ActionList(TypeIdClass(), "Switch"), mCaseCache(DEFAULT_CACHE_CAPACITY)
 	{
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
+	}
+
+	ActionListSwitch::ActionListSwitch(const ActionListSwitch& rhs) :
+		ActionList(rhs), mValue(rhs.mValue), mCaseCache(DEFAULT_CACHE_CAPACITY)
+	{
+		CopyCases(rhs);
+	}
+
+	ActionListSwitch& ActionListSwitch::operator=(const ActionListSwitch& rhs)
+	{
+		if (this != &rhs)
+		{
+			ActionList::operator=(rhs);
+			mValue = rhs.mValue;
+			CopyCases(rhs);
+		}
+		return *this;
 	}
 
 	void ActionListSwitch::Update([[maybe_unused]] WorldState& state)
@@ -20,12 +35,13 @@ namespace Library {
 			//Paul: I was thinking that maybe all actions (and maybe entities?) should have an initialize method
 			//that world would call before the first update (like Start in unity or BeginPlay in UE4)
 			//Is there a reason we don't have this?
-			if (mCaseCache.Size() == 0 && !mActionsDatum->IsEmpty())
+			Datum& actions = Actions();
+			if (mCaseCache.Size() == 0 && !actions.IsEmpty())
 			{
-				for (size_t i = 0; i < mActionsDatum->Size(); i++)
+				for (size_t i = 0; i < actions.Size(); i++)
 				{
-					auto& caseScope = mActionsDatum->Get<Scope>(i);
-					assert(caseScope.Is(Action::TypeIdClass()));
+					auto& caseScope = actions.Get<Scope>(i);
+					assert(caseScope.Is<Action>());
 					Action* casePtr = static_cast<Action*>(&caseScope);
 					assert(casePtr != nullptr);
 					mCaseCache.Insert({ casePtr->Name(), casePtr });
@@ -90,13 +106,44 @@ namespace Library {
 		return new ActionListSwitch(*this);
 	}
 
-	Vector<Signature> ActionListSwitch::Signatures()
+	gsl::owner<Scope*> ActionListSwitch::Relocate()
 	{
-		return Vector<Signature>
+		return RelocateAs(*this);
+	}
+
+	void ActionListSwitch::CopyCases(const ActionListSwitch& rhs)
+	{
+		//rhs's cases point at rhs's actions, the copies are at the same indices of our Actions datum
+		mCaseCache.Clear();
+		for (const auto& pair : rhs.mCaseCache)
 		{
-			Signature("Name", DatumType::String, 1, offsetof(ActionListSwitch, mName)),
-			Signature(ACTIONS_STRING, DatumType::Table, START_ACTIONS_CAPACITY, 0),
-			Signature("CaseValue", DatumType::String, 1, offsetof(ActionListSwitch, mValue))
-		};
+			if (pair.second == nullptr) { continue; }	//a name Update looked up and did not find
+			const Datum& rhsActions = rhs.Actions();
+			for (size_t i = 0; i < rhsActions.Size(); ++i)
+			{
+				if (&rhsActions.Get<Scope>(i) == pair.second)
+				{
+					mCaseCache.Insert({ pair.first, static_cast<Action*>(&Actions().Get<Scope>(i)) });
+					break;
+				}
+			}
+		}
+		mCurrentAction = nullptr;
+		bValueChanged = true;
+	}
+
+	void ActionListSwitch::ChildRelocated(const Scope& old, Scope& relocated)
+	{
+		assert(relocated.Is<Action>());
+		for (auto& pair : mCaseCache)
+		{
+			if (pair.second == &old) { pair.second = static_cast<Action*>(&relocated); }
+		}
+		if (mCurrentAction == &old) { mCurrentAction = static_cast<Action*>(&relocated); }
+	}
+
+	Vector<Signature> ActionListSwitch::Signatures()
+	{
+		return ToSignatures(StaticSignatures());
 	}
 }
\ No newline at end of file
@@ -17,6 +17,37 @@ namespace Library
 		/// </summary>
 		ActionListSwitch();
 
+		/// <summary>
+		/// Copy constructor: deep copies rhs. Its cases name the copied actions, and the case to run is looked up again on the next update.
+		/// </summary>
+		/// <param name="rhs">the switch to copy</param>
+		ActionListSwitch(const ActionListSwitch& rhs);
+
+		/// <summary>
+		/// Move constructor: default scope move constructor, the cases move with the actions
+		/// </summary>
+		/// <param name="rhs">the switch to move</param>
+		ActionListSwitch(ActionListSwitch&& rhs) noexcept = default;
+
+		/// <summary>
+		/// Default scope destructor
+		/// </summary>
+		~ActionListSwitch() = default;
+
+		/// <summary>
+		/// Copy assignment: deep copies rhs. Its cases name the copied actions, and the case to run is looked up again on the next update.
+		/// </summary>
+		/// <param name="rhs">the switch to copy</param>
+		/// <returns>A reference to this switch</returns>
+		ActionListSwitch& operator=(const ActionListSwitch& rhs);
+
+		/// <summary>
+		/// Move assignment: default scope move assignment
+		/// </summary>
+		/// <param name="rhs">the switch to move</param>
+		/// <returns>rhs switch moved into this one</returns>
+		ActionListSwitch& operator=(ActionListSwitch&& rhs) = default;
+
 		/// <summary>
 		/// Update: Calls update on the action that is specified by Value.
 		/// If value was changed between updates, searches for and caches the new action.
@@ -70,17 +101,50 @@ namespace Library
 		/// <returns>A heap allocated copy of this</returns>
 		gsl::owner<ActionListSwitch*> Clone() const;
 
+		/// <summary>
+		/// Moves this into a new heap allocated ActionListSwitch, see Scope::Relocate
+		/// </summary>
+		/// <returns>the relocated scope</returns>
+		gsl::owner<Scope*> Relocate() override;
+
 		/// <summary>
 		/// Gets the signatures used to populate this object
 		/// </summary>
 		/// <returns>the signatures used to populate this object</returns>
 		static Vector<Signature> Signatures();
+
+		/// <summary>
+		/// The prescribed attributes as a constexpr table, see Signatures(). Only those added to ActionList's: register with ActionList as the parent type.
+		/// </summary>
+		/// <returns>A StaticSignature for each prescribed attribute not inherited</returns>
+		static constexpr std::array<StaticSignature, 1> StaticSignatures();
 	private:
+		/// <summary>
+		/// Points this switch's cases at its own copies of the actions rhs's cases point at, and forgets the current case
+		/// </summary>
+		/// <param name="rhs">the switch this one was copied from</param>
+		void CopyCases(const ActionListSwitch& rhs);
+
+		/// <summary>
+		/// Points the cases, and the current case, that were old at relocated
+		/// </summary>
+		/// <param name="old">the case action Compact relocated</param>
+		/// <param name="relocated">the action that took its place</param>
+		void ChildRelocated(const Scope& old, Scope& relocated) override;
+
 		static const size_t DEFAULT_CACHE_CAPACITY = 11;
 		std::string mValue;
 		CacheType mCaseCache;
 		Action* mCurrentAction = nullptr;
 		bool bValueChanged = true; //used to indicate when value is changed
 	};
+
+	constexpr std::array<StaticSignature, 1> ActionListSwitch::StaticSignatures()
+	{
+		return
+		{
+			SIGNATURE(ActionListSwitch, "CaseValue", DatumType::String, 1, mValue)
+		};
+	}
 	ConcreteFactory(ActionListSwitch, Scope)
 }
\ No newline at end of file
@@ -8,24 +8,23 @@ namespace Library
 {
 	RTTI_DEFINITIONS(Attributed)
 
-	Attributed::Attributed(RTTI::IdType typeID)
+	Attributed::Attributed(RTTI::IdType typeID) :
+		Scope(TypeRegistry::GetLayout(typeID), TypeRegistry::GetMaterialization(typeID) == TypeRegistry::Materialization::OnFirstAccess), mTypeID(typeID)
 	{
-		(*this)["this"] = this;
-		Populate(typeID);
+		//the layout has "this" and every prescribed attribute in order, typed, so only the storage is left to point at this object
+		UpdateExternalStorage(typeID);
 	}
 
 	Attributed::Attributed(const Attributed& rhs) :
-		Scope(rhs)
+		Scope(rhs), mTypeID(rhs.mTypeID)
 	{
-		(*this)["this"] = this;
-		UpdateExternalStorage(rhs.TypeIdInstance());
+		UpdateExternalStorage(mTypeID);
 	}
 
 	Attributed::Attributed(Attributed&& rhs) noexcept :
-		Scope(rhs)
+		Scope(std::move(rhs)), mTypeID(rhs.mTypeID)
 	{
-		(*this)["this"] = this;
-		UpdateExternalStorage(rhs.TypeIdInstance());
+		UpdateExternalStorage(mTypeID);
 	}
 
 	Attributed& Attributed::operator=(const Attributed& rhs)
@@ -33,8 +32,8 @@ namespace Library
 		if (this != &rhs)
 		{
 			Scope::operator=(rhs);
-			(*this)["this"] = this;
-			UpdateExternalStorage(rhs.TypeIdInstance());
+			mTypeID = rhs.mTypeID;
+			UpdateExternalStorage(mTypeID);
 		}
 		return *this;
 	}
@@ -43,58 +42,40 @@ namespace Library
 	{
 		if (this != &rhs)
 		{
-			Scope::operator=(rhs);
-			(*this)["this"] = this;
-			UpdateExternalStorage(rhs.TypeIdInstance());
+			Scope::operator=(std::move(rhs));
+			mTypeID = rhs.mTypeID;
+			UpdateExternalStorage(mTypeID);
 		}
 		return *this;
 	}
 
-	bool Attributed::IsAttribute(std::string name) const
+	RTTI::IdType Attributed::RegisteredTypeId() const noexcept
 	{
-		return (Find(name) != nullptr);
+		return mTypeID;
 	}
 
-	bool Attributed::IsPrescribedAttribute(std::string name) const
+	bool Attributed::IsAttribute(const std::string& name) const
 	{
-		const auto& signatures = TypeRegistry::GetSignatures(TypeIdInstance());
-		for (const auto& signature : signatures)
-		{
-			if (signature.mName == name) { return true; }
-		}
-		return false; //if here, not found in signatures.
+		return (Find(name) != nullptr);
 	}
 
-	bool Attributed::IsAuxiliaryAttribute(std::string name) const
+	bool Attributed::IsPrescribedAttribute(const std::string& name) const
 	{
-		return (IsAttribute(name) && !IsPrescribedAttribute(name));
+		return (TypeRegistry::FindSignature(mTypeID, name) != nullptr);
 	}
 
-	void Attributed::Populate(RTTI::IdType typeID)
+	bool Attributed::IsAuxiliaryAttribute(const std::string& name) const
 	{
-		const auto& signatures = TypeRegistry::GetSignatures(typeID);
-		for (const auto& signature : signatures)
-		{
-			Datum& dat = Append(signature.mName);
-			dat.SetType(signature.mType);
-			if (signature.mType != DatumType::Table)
-			{
-				dat.SetStorage(reinterpret_cast<uint8_t*>(this) + signature.mOffset, signature.mSize);
-			}
-			else
-			{
-				dat.Reserve(signature.mSize);
-			}
-		}
+		return (IsAttribute(name) && !IsPrescribedAttribute(name));
 	}
 
-	Datum& Attributed::AppendAuxiliaryAttribute(std::string name)
+	Datum& Attributed::AppendAuxiliaryAttribute(const std::string& name)
 	{
 		if (IsPrescribedAttribute(name)) { throw std::runtime_error("Cannot append prescribed scope"); }
 		return Append(name);
 	}
 
-	Datum& Attributed::AppendAuxiliaryAttribute(std::string name, bool& EntryCreated)
+	Datum& Attributed::AppendAuxiliaryAttribute(const std::string& name, bool& EntryCreated)
 	{
 		if (IsPrescribedAttribute(name)) { throw std::runtime_error("Cannot append prescribed scope"); }
 		return Append(name, EntryCreated);
@@ -110,13 +91,15 @@ namespace Library
 
 	const Vector<std::pair<const std::string, Datum>*>& Attributed::Attributes() const
 	{
+		EnsureMaterialized();
 		return mOrderVector;
 	}
 
 	Vector<std::pair<const std::string, Datum>*> Attributed::PrescribedAttributes() const
 	{
+		EnsureMaterialized();
 		Vector<std::pair<const std::string, Datum>*> list;
-		auto numPrescribed = TypeRegistry::GetSignatures(TypeIdInstance()).Size() + 1; //+1 because "this"
+		auto numPrescribed = TypeRegistry::GetSignatures(mTypeID).Size() + 1; //+1 because "this"
 		if (Size() == numPrescribed) { list = mOrderVector; } //no auxiliary, so just pass mordervector
 		else 
 		{
@@ -132,7 +115,7 @@ namespace Library
 	Vector<std::pair<const std::string, Datum>*> Attributed::AuxiliaryAttributes() const
 	{
 		Vector<std::pair<const std::string, Datum>*> list;
-		auto numPrescribed = TypeRegistry::GetSignatures(TypeIdInstance()).Size() + 1; //+1 because "this"
+		auto numPrescribed = TypeRegistry::GetSignatures(mTypeID).Size() + 1; //+1 because "this"
 		if (Size() > numPrescribed)
 		{
 			for (size_t i = numPrescribed; i < mOrderVector.Size(); i++)
@@ -143,14 +126,47 @@ namespace Library
 		return list;
 	}
 
+	Datum& Attributed::PrescribedAttribute(size_t index)
+	{
+		return const_cast<Datum&>(const_cast<const Attributed*>(this)->PrescribedAttribute(index));
+	}
+
+	const Datum& Attributed::PrescribedAttribute(size_t index) const
+	{
+		if (index >= TypeRegistry::GetSignatures(mTypeID).Size())
+		{
+			throw std::runtime_error("Prescribed attribute index out of range");
+		}
+		EnsureMaterialized();
+		return mOrderVector[index + 1]->second;	//+1 because "this"
+	}
+
+	void Attributed::Materialize()
+	{
+		if (IsMaterialized()) { return; }
+		Scope::Materialize();
+		UpdateExternalStorage(mTypeID);
+	}
+
 	void Attributed::UpdateExternalStorage(RTTI::IdType typeID)
 	{
+		if (!IsMaterialized()) { return; }	//Materialize does it
+
+		//a copy keeps rhs's order, so "this" is first and the prescribed attributes follow in signature order: fix them up by index instead of by key
 		const auto& signatures = TypeRegistry::GetSignatures(typeID);
-		for (const auto& signature : signatures)
+		assert(mOrderVector.Size() > signatures.Size() && mOrderVector[0]->first == "this");
+		mOrderVector[0]->second = this;
+		for (size_t i = 0; i < signatures.Size(); ++i)
 		{
-			Datum& dat = Append(signature.mName);
-			dat;
-			if (signature.mType != DatumType::Table)
+			const Signature& signature = signatures[i];
+			Datum& dat = mOrderVector[i + 1]->second;
+			assert(mOrderVector[i + 1]->first == signature.mName);
+			if (signature.mType == DatumType::Table) { continue; }
+			if (dat.mIsExternal && dat.mCapacity > 0)
+			{
+				dat.mData.byte = reinterpret_cast<uint8_t*>(this) + signature.mOffset;	//moved with the table, still pointing into rhs
+			}
+			else
 			{
 				dat.SetStorage(reinterpret_cast<uint8_t*>(this) + signature.mOffset, signature.mSize);
 			}
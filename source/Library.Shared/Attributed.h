@@ -14,7 +14,8 @@ namespace Library
 		virtual ~Attributed() = default;
 
 		/// <summary>
-		/// Constructor: Uses the given typeId to retrieve signatures from the type registry
+		/// Constructor: copies the type's prebuilt layout from the type registry, then points the prescribed attributes at this object's members
+		/// If the type was registered with Materialization::OnFirstAccess, both are deferred until the attributes are first accessed through the scope.
 		/// Will explode if type register is not created or if type is not registered.
 		/// </summary>
 		/// <param name="typeID">the rtti type id of the class</param>
@@ -53,29 +54,21 @@ namespace Library
 		/// <param name="name">the name of the attribute to search for</param>
 		/// <returns>True if an attribute with the given name exists in this scope, false otherwise</returns>
 		/// <remarks>Uses scope::find</remarks>
-		bool IsAttribute(std::string name) const;
+		bool IsAttribute(const std::string& name) const;
 
 		/// <summary>
 		/// Checks to see if an attribute with the given name is a prescribed attribute
 		/// </summary>
 		/// <param name="name">The name of the attribute to search for</param>
 		/// <returns>True if an attribute with the given name is prescribed, false otherwise</returns>
-		bool IsPrescribedAttribute(std::string name) const;
+		bool IsPrescribedAttribute(const std::string& name) const;
 
 		/// <summary>
 		/// Checks to see if attribute exists within scope and is not prescribed.
 		/// </summary>
 		/// <param name="name">The name of the attribute to search for </param>
 		/// <returns>True if the attribute exists and is not prescribed, false otherwise</returns>
-		bool IsAuxiliaryAttribute(std::string name) const;
-
-		/// <summary>
-		/// Populates the scope that mirrors this class. 
-		/// Populates string datum pairs from signatures retrieved from TypeManager
-		/// NOTE: IF TYPE IS NOT REGISTERED IN TYPEMANAGER, EVERYTHING WILL EXPLODE.
-		/// </summary>
-		/// <param name="typeID">The typeID of this instance (used to get signatures)</param>
-		void Populate(RTTI::IdType typeID);
+		bool IsAuxiliaryAttribute(const std::string& name) const;
 
 		/// <summary>
 		/// Appends an auxiliary attribute
@@ -85,7 +78,7 @@ namespace Library
 		/// <returns>A reference to the datum with the given name</returns>
 		/// <exception cref="std::runtime_error">Throws if attribute is a prescribed attribute, or if string is empty</exception>
 		/// <remarks>Is a thin wrapper to Scope::Append</remarks>
-		Datum& AppendAuxiliaryAttribute(std::string name);
+		Datum& AppendAuxiliaryAttribute(const std::string& name);
 
 		/// <summary>
 		/// Appends an auxiliary attribute
@@ -96,7 +89,7 @@ namespace Library
 		/// <returns>A reference to the datum with the given name</returns>
 		/// <exception cref="std::runtime_error">Throws if attribute is a prescribed attribute, or if string is empty</exception>
 		/// <remarks>Is a thin wrapper to Scope::Append</remarks>
-		Datum& AppendAuxiliaryAttribute(std::string name, bool& EntryCreated);
+		Datum& AppendAuxiliaryAttribute(const std::string& name, bool& EntryCreated);
 
 		/// <summary>
 		/// RTTI Equals overload
@@ -124,8 +117,44 @@ namespace Library
 		/// <returns>a vector of all attributes</returns>
 		Vector<std::pair<const std::string, Datum>*> AuxiliaryAttributes() const;
 
+		/// <summary>
+		/// Gets a prescribed attribute by its index in the type's signatures, without hashing its name.
+		/// Prescribed attributes always follow "this" in signature order, so the index is fixed for a type and can be a constant, e.g. Entity::ACTIONS_INDEX.
+		/// Usable from constructors, before the object's dynamic type is the registered one.
+		/// </summary>
+		/// <param name="index">the index of the attribute's signature in the registered signatures</param>
+		/// <returns>The datum of the prescribed attribute</returns>
+		/// <exception cref="std::runtime_error">Throws exception if index is not less than the number of prescribed attributes</exception>
+		Datum& PrescribedAttribute(size_t index);
+
+		/// <summary>
+		/// Gets a prescribed attribute by its index in the type's signatures, without hashing its name.
+		/// </summary>
+		/// <param name="index">the index of the attribute's signature in the registered signatures</param>
+		/// <returns>The datum of the prescribed attribute</returns>
+		/// <exception cref="std::runtime_error">Throws exception if index is not less than the number of prescribed attributes</exception>
+		const Datum& PrescribedAttribute(size_t index) const;
+
+		/// <summary>
+		/// The type this was constructed as, whose prescribed attributes it has. Differs from TypeIdInstance for types defined by an AttributedSchema.
+		/// </summary>
+		/// <returns>The registered type id</returns>
+		RTTI::IdType RegisteredTypeId() const noexcept;
+
+	protected:
+		/// <summary>
+		/// Copies in the deferred prescribed attributes and points them at this object's members
+		/// </summary>
+		void Materialize() override;
+
 	private:
+		/// <summary>
+		/// Points "this" and the prescribed attributes of a freshly copied or laid out scope at this object
+		/// </summary>
+		/// <param name="typeID">the type of the object that was copied</param>
 		void UpdateExternalStorage(RTTI::IdType typeID);
+
+		RTTI::IdType mTypeID;	//the registered type this was constructed as. TypeIdInstance is not it inside base constructors, or for types defined in data (see AttributedSchema).
 	};
 }
 
@@ -0,0 +1,341 @@
+#include "pch.h"
+#include "AttributedSchema.h"
+#include "SchemaInstance.h"
+#include "TypeRegistry.h"
+#include "JsonTableParseHelper.h"
+#include "Attributed.h"
+#include "Entity.h"
+
+namespace Library
+{
+	struct AttributedSchema::NativeParent final
+	{
+		std::string mClassName;
+		RTTI::IdType (*mTypeId)();
+		bool mIsRegistered;	//whether the class has a type registry entry of its own to inherit attributes from
+		size_t (*mStorageOffset)();
+		gsl::owner<Scope*> (*mCreate)(const AttributedSchema& schema);
+	};
+
+	namespace
+	{
+		template <typename TBase>
+		gsl::owner<Scope*> CreateInstance(const AttributedSchema& schema)
+		{
+			return SchemaInstance<TBase>::Create(schema);
+		}
+
+		//the largest alignment elements of this size can need
+		size_t ElementAlignment(size_t size)
+		{
+			const size_t lowestBit = size & (~size + 1);
+			return std::min(lowestBit, alignof(std::max_align_t));
+		}
+	}
+
+	const AttributedSchema::NativeParent AttributedSchema::sNativeParents[] =
+	{
+		{ Attributed::TypeName(), &Attributed::TypeIdClass, false, &SchemaInstance<Attributed>::StorageOffset, &CreateInstance<Attributed> },
+		{ Entity::TypeName(), &Entity::TypeIdClass, true, &SchemaInstance<Entity>::StorageOffset, &CreateInstance<Entity> }
+	};
+
+	AttributedSchema::SchemaTable AttributedSchema::sSchemas{ 23 };
+
+	void AttributedSchema::Load(const std::string& json)
+	{
+		JSONCPP_STRING err;
+		Json::Value root;
+		Json::CharReaderBuilder builder;
+		std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+		if (!reader->parse(json.c_str(), json.c_str() + json.length(), &root, &err))
+		{
+			throw std::runtime_error("Invalid schema json: " + err);
+		}
+		DefineAll(root);
+	}
+
+	void AttributedSchema::LoadFromFile(const std::string& filename)
+	{
+		std::ifstream file(filename);
+		if (!file.good())
+		{
+			throw std::runtime_error("Cannot open schema file: " + filename);
+		}
+
+		JSONCPP_STRING err;
+		Json::Value root;
+		Json::CharReaderBuilder builder;
+		if (!parseFromStream(builder, file, &root, &err))
+		{
+			throw std::runtime_error("Invalid schema json in " + filename + ": " + err);
+		}
+		DefineAll(root);
+	}
+
+	const AttributedSchema* AttributedSchema::Find(const std::string& className)
+	{
+		auto it = sSchemas.Find(className);
+		return (it != sSchemas.end() ? it->second : nullptr);
+	}
+
+	size_t AttributedSchema::Size()
+	{
+		return sSchemas.Size();
+	}
+
+	void AttributedSchema::Clear()
+	{
+		//instances read their schema's attributes until they are deleted
+		for (const auto& pair : sSchemas)
+		{
+			if (pair.second->InstanceCount() > 0)
+			{
+				throw std::runtime_error("Cannot clear schemas while instances of " + pair.first + " exist");
+			}
+		}
+		for (auto& pair : sSchemas)
+		{
+			delete(pair.second);
+		}
+		sSchemas.Clear();
+	}
+
+	AttributedSchema::AttributedSchema(const std::string& className, const NativeParent& native, const AttributedSchema* parent) :
+		mClassName(className), mParentName(parent != nullptr ? parent->mClassName : native.mClassName), mNative(native), mParent(parent)
+	{
+		if (parent != nullptr)
+		{
+			mAttributes = parent->mAttributes;
+			mStorageSize = parent->mStorageSize;
+		}
+	}
+
+	AttributedSchema::~AttributedSchema()
+	{
+		assert(mInstanceCount == 0);
+		if (mIsRegistered)
+		{
+			Unregister();
+		}
+		delete(mFactory);
+	}
+
+	AttributedSchema::SchemaTable::~SchemaTable()
+	{
+		//the registry and the factories may already be destroyed, and schemas with live instances are left to the process
+		for (const auto& pair : *this)
+		{
+			if (pair.second->InstanceCount() > 0) { return; }
+		}
+		for (auto& pair : *this)
+		{
+			pair.second->mIsRegistered = false;
+			delete(pair.second);
+		}
+	}
+
+	const std::string& AttributedSchema::ClassName() const noexcept
+	{
+		return mClassName;
+	}
+
+	const std::string& AttributedSchema::ParentName() const noexcept
+	{
+		return mParentName;
+	}
+
+	RTTI::IdType AttributedSchema::TypeId() const noexcept
+	{
+		//unique for as long as the class is defined, like the address RTTI uses for a C++ class
+		return reinterpret_cast<RTTI::IdType>(this);
+	}
+
+	bool AttributedSchema::Is(const std::string& className) const
+	{
+		for (const AttributedSchema* schema = this; schema != nullptr; schema = schema->mParent)
+		{
+			if (schema->mClassName == className) { return true; }
+		}
+		return (mNative.mClassName == className);
+	}
+
+	const Vector<AttributedSchema::Attribute>& AttributedSchema::Attributes() const noexcept
+	{
+		return mAttributes;
+	}
+
+	size_t AttributedSchema::StorageSize() const noexcept
+	{
+		return mStorageSize;
+	}
+
+	gsl::owner<Scope*> AttributedSchema::Create() const
+	{
+		return mNative.mCreate(*this);
+	}
+
+	size_t AttributedSchema::InstanceCount() const noexcept
+	{
+		return mInstanceCount;
+	}
+
+	void AttributedSchema::DefineAll(const Json::Value& root)
+	{
+		const Json::Value& classes = root["classes"];
+		if (!classes.isArray())
+		{
+			throw std::runtime_error("A schema document needs a \"classes\" array");
+		}
+		for (const Json::Value& definition : classes)
+		{
+			Define(definition);
+		}
+	}
+
+	void AttributedSchema::Define(const Json::Value& definition)
+	{
+		if (!definition.isObject() || !definition["class"].isString() || definition["class"].asString().empty())
+		{
+			throw std::runtime_error("A class definition needs a class name");
+		}
+		const std::string className = definition["class"].asString();
+		if (sSchemas.ContainsKey(className) || FindNative(className) != nullptr || Factory<Scope>::Find(className) != nullptr)
+		{
+			throw std::runtime_error("Class is already defined: " + className);
+		}
+
+		const Json::Value& parentValue = definition["parent"];
+		if (!parentValue.isNull() && !parentValue.isString())
+		{
+			throw std::runtime_error("The parent of " + className + " must be a class name");
+		}
+		const std::string parentName = (parentValue.isNull() ? Attributed::TypeName() : parentValue.asString());
+		const AttributedSchema* parent = Find(parentName);
+		const NativeParent* native = (parent != nullptr ? &parent->mNative : FindNative(parentName));
+		if (native == nullptr)
+		{
+			throw std::runtime_error("Unknown parent class " + parentName + " of " + className);
+		}
+
+		std::unique_ptr<AttributedSchema> schema(new AttributedSchema(className, *native, parent));
+		const Json::Value& attributes = definition["attributes"];
+		if (!attributes.isNull() && !attributes.isArray())
+		{
+			throw std::runtime_error("The attributes of " + className + " must be an array");
+		}
+		for (const Json::Value& attribute : attributes)
+		{
+			if (!attribute.isObject() || !attribute["name"].isString() || !attribute["type"].isString())
+			{
+				throw std::runtime_error("Every attribute of " + className + " needs a name and a type");
+			}
+			const DatumType type = JsonTableParseHelper::FindType(attribute["type"].asString());
+			if (type == DatumType::Unknown)
+			{
+				throw std::runtime_error("Unknown attribute type " + attribute["type"].asString() + " in " + className);
+			}
+			const Json::Value& size = attribute["size"];
+			if (!size.isNull() && !size.isUInt())
+			{
+				throw std::runtime_error("The size of an attribute must be a positive integer");
+			}
+			schema->AddAttribute(attribute["name"].asString(), type, (size.isNull() ? 1 : size.asUInt()));
+		}
+
+		schema->Register();
+		sSchemas.Insert(std::make_pair(className, schema.release()));
+	}
+
+	void AttributedSchema::AddAttribute(const std::string& name, DatumType type, size_t size)
+	{
+		if (name.empty() || name == "this") { throw std::runtime_error("Invalid attribute name in " + mClassName); }
+		if (size == 0 && type != DatumType::Table) { throw std::runtime_error("Attribute " + name + " needs at least one element"); }
+		for (const Attribute& attribute : mAttributes)
+		{
+			if (attribute.mName == name) { throw std::runtime_error("Attribute " + name + " is already declared by " + mClassName + " or its parents"); }
+		}
+		if (mNative.mIsRegistered && TypeRegistry::FindSignature(mNative.mTypeId(), name) != nullptr)
+		{
+			throw std::runtime_error("Attribute " + name + " is already declared by " + mNative.mClassName);
+		}
+
+		size_t offset = 0;
+		if (type != DatumType::Table)
+		{
+			const size_t elementSize = Datum::TypeSize(type);
+			const size_t alignment = ElementAlignment(elementSize);
+			offset = (mStorageSize + alignment - 1) & ~(alignment - 1);
+			mStorageSize = offset + elementSize * size;
+		}
+		mAttributes.PushBack(Attribute{ name, type, size, offset });
+		++mOwnAttributes;
+	}
+
+	void AttributedSchema::Register()
+	{
+		//the inherited signatures come from the parent's registration, only this class's own are added
+		const size_t storageOffset = mNative.mStorageOffset();
+		Vector<Signature> signatures(std::max<size_t>(mOwnAttributes, 1));
+		for (size_t i = mAttributes.Size() - mOwnAttributes; i < mAttributes.Size(); ++i)
+		{
+			const Attribute& attribute = mAttributes[i];
+			const size_t offset = (attribute.mType == DatumType::Table ? 0 : storageOffset + attribute.mOffset);
+			signatures.PushBack(Signature(attribute.mName, attribute.mType, attribute.mSize, offset));
+		}
+
+		if (mParent != nullptr)
+		{
+			TypeRegistry::RegisterType(TypeId(), signatures, mParent->TypeId());
+		}
+		else if (mNative.mIsRegistered)
+		{
+			TypeRegistry::RegisterType(TypeId(), signatures, mNative.mTypeId());
+		}
+		else
+		{
+			TypeRegistry::RegisterType(TypeId(), signatures);
+		}
+		mIsRegistered = true;
+		mFactory = new SchemaFactory(*this);
+	}
+
+	void AttributedSchema::Unregister()
+	{
+		if (mFactory != nullptr)
+		{
+			mFactory->Deregister();
+		}
+		TypeRegistry::DeregisterType(TypeId());
+		mIsRegistered = false;
+	}
+
+	const AttributedSchema::NativeParent* AttributedSchema::FindNative(const std::string& className)
+	{
+		for (const NativeParent& native : sNativeParents)
+		{
+			if (native.mClassName == className) { return &native; }
+		}
+		return nullptr;
+	}
+
+	AttributedSchema::SchemaFactory::SchemaFactory(const AttributedSchema& schema) :
+		mSchema(schema)
+	{
+		Factory<Scope>::Add(*this);
+	}
+
+	void AttributedSchema::SchemaFactory::Deregister()
+	{
+		Factory<Scope>::Remove(*this);
+	}
+
+	const std::string& AttributedSchema::SchemaFactory::ClassName() const
+	{
+		return mSchema.mClassName;
+	}
+
+	gsl::owner<Scope*> AttributedSchema::SchemaFactory::Create() const
+	{
+		return mSchema.Create();
+	}
+}
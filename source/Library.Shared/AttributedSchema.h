@@ -0,0 +1,212 @@
+#pragma once
+#include <string>
+#include <atomic>
+#include <gsl/gsl>
+#include <json/json.h>
+#include "RTTI.h"
+#include "Datum.h"
+#include "vector.h"
+#include "Hashmap.h"
+#include "Factory.h"
+
+namespace Library
+{
+	class Scope;
+
+	/// <summary>
+	/// An attributed class defined in content rather than in C++.
+	/// A schema names a parent class and a list of typed attributes. Loading it registers a TypeRegistry entry and a Factory&lt;Scope&gt; under its class name,
+	/// so its instances are created like any other class (e.g. the "class" key of JsonTableParseHelper) and get the attributes as prescribed attributes,
+	/// stored in one block at the end of the instance instead of as per instance auxiliary entries.
+	/// </summary>
+	/// <remarks>
+	/// Schemas are read from json of the form
+	/// { "classes": [ { "class": "Enemy", "parent": "Entity", "attributes": [ { "name": "Health", "type": "integer", "size": 1 } ] } ] }
+	/// where "parent" is Attributed (the default), Entity, or a class defined earlier, "type" is any type name JsonTableParseHelper accepts, and "size" defaults to 1
+	/// (the starting capacity for tables).
+	/// The type registry must exist while schemas are loaded, and Clear must be called before it is shut down. Clear throws while instances exist.
+	/// Schemas still defined when the program exits are freed then, without touching the type registry or the factories.
+	/// </remarks>
+	class AttributedSchema final
+	{
+	public:
+		/// <summary>
+		/// An attribute a schema adds to its instances
+		/// </summary>
+		struct Attribute final
+		{
+			std::string mName;
+			DatumType mType;
+			size_t mSize;
+			size_t mOffset;	//from the start of the instance's attribute storage, unused for tables
+		};
+
+		/// <summary>
+		/// Defines the classes in a json document, in order
+		/// </summary>
+		/// <param name="json">the schema document</param>
+		/// <exception cref="std::runtime_error">Throws exception if the document is malformed, a class is already defined, or a parent is unknown</exception>
+		static void Load(const std::string& json);
+
+		/// <summary>
+		/// Defines the classes in a json file, in order
+		/// </summary>
+		/// <param name="filename">the path of the schema document</param>
+		/// <exception cref="std::runtime_error">Throws exception if the file cannot be read, or for anything Load throws for</exception>
+		static void LoadFromFile(const std::string& filename);
+
+		/// <summary>
+		/// Finds a class defined by a schema
+		/// </summary>
+		/// <param name="className">the name of the class</param>
+		/// <returns>The class's schema, or nullptr if no schema defines it</returns>
+		static const AttributedSchema* Find(const std::string& className);
+
+		/// <summary>
+		/// The number of classes defined by schemas
+		/// </summary>
+		/// <returns>The number of loaded schemas</returns>
+		static size_t Size();
+
+		/// <summary>
+		/// Removes every class defined by a schema from the type registry and the factories
+		/// </summary>
+		/// <exception cref="std::runtime_error">Throws exception, and removes nothing, if any class still has instances</exception>
+		static void Clear();
+
+		AttributedSchema(const AttributedSchema& rhs) = delete;
+		AttributedSchema(AttributedSchema&& rhs) noexcept = delete;
+		AttributedSchema& operator=(const AttributedSchema& rhs) = delete;
+		AttributedSchema& operator=(AttributedSchema&& rhs) noexcept = delete;
+		~AttributedSchema();
+
+		/// <summary>
+		/// The name instances are created by
+		/// </summary>
+		/// <returns>The class name</returns>
+		const std::string& ClassName() const noexcept;
+
+		/// <summary>
+		/// The name of the class this one derives from
+		/// </summary>
+		/// <returns>The parent class name</returns>
+		const std::string& ParentName() const noexcept;
+
+		/// <summary>
+		/// The id the class is registered with in the type registry. Instances are attributed with this type, while their RTTI type is the native parent's.
+		/// </summary>
+		/// <returns>The class's type id</returns>
+		RTTI::IdType TypeId() const noexcept;
+
+		/// <summary>
+		/// Checks whether this class is, or derives from, the class with the given name
+		/// </summary>
+		/// <param name="className">the class name to check for</param>
+		/// <returns>True if className names this class or one of its ancestors</returns>
+		bool Is(const std::string& className) const;
+
+		/// <summary>
+		/// The attributes stored in an instance's attribute storage: the parent schema's first, then this class's own
+		/// </summary>
+		/// <returns>The stored attributes</returns>
+		const Vector<Attribute>& Attributes() const noexcept;
+
+		/// <summary>
+		/// The size of the attribute storage at the end of every instance
+		/// </summary>
+		/// <returns>The storage size in bytes</returns>
+		size_t StorageSize() const noexcept;
+
+		/// <summary>
+		/// Creates an instance of this class
+		/// </summary>
+		/// <returns>A heap allocated instance</returns>
+		gsl::owner<Scope*> Create() const;
+
+		/// <summary>
+		/// The number of instances of this class (not of classes derived from it) that have not been deleted
+		/// </summary>
+		/// <returns>The live instance count</returns>
+		size_t InstanceCount() const noexcept;
+
+	private:
+		template <typename TBase>
+		friend class SchemaInstance;	//counts itself in mInstanceCount
+
+		//a C++ class schemas can derive from, see sNativeParents
+		struct NativeParent;
+
+		//registers the class with Factory<Scope>
+		class SchemaFactory final : public Factory<Scope>
+		{
+		public:
+			explicit SchemaFactory(const AttributedSchema& schema);
+			void Deregister();	//removes the factory from Factory<Scope>, which the destructor does not do so the factory can be freed at exit
+			const std::string& ClassName() const override;
+			gsl::owner<Scope*> Create() const override;
+
+		private:
+			const AttributedSchema& mSchema;
+		};
+
+		//owns the schemas, and frees those still defined at exit
+		struct SchemaTable final : public Hashmap<std::string, gsl::owner<AttributedSchema*>>
+		{
+			using Hashmap::Hashmap;
+			~SchemaTable();
+		};
+
+		AttributedSchema(const std::string& className, const NativeParent& native, const AttributedSchema* parent);
+
+		/// <summary>
+		/// Defines one class from its json description, and registers it
+		/// </summary>
+		/// <param name="definition">the class's json object</param>
+		static void Define(const Json::Value& definition);
+
+		/// <summary>
+		/// Appends an attribute to this class, after everything it inherits
+		/// </summary>
+		/// <param name="name">the attribute's name</param>
+		/// <param name="type">the attribute's type</param>
+		/// <param name="size">the number of elements, or the starting capacity of a table</param>
+		void AddAttribute(const std::string& name, DatumType type, size_t size);
+
+		/// <summary>
+		/// Registers this class with the type registry and the factories
+		/// </summary>
+		void Register();
+
+		/// <summary>
+		/// Removes this class from the type registry and the factories
+		/// </summary>
+		void Unregister();
+
+		/// <summary>
+		/// Finds a native class that schemas can derive from
+		/// </summary>
+		/// <param name="className">the name of the class</param>
+		/// <returns>The native parent, or nullptr if className is not one</returns>
+		static const NativeParent* FindNative(const std::string& className);
+
+		/// <summary>
+		/// Defines each class listed under "classes" in a parsed schema document
+		/// </summary>
+		/// <param name="root">the root of the document</param>
+		static void DefineAll(const Json::Value& root);
+
+		std::string mClassName;
+		std::string mParentName;
+		const NativeParent& mNative;
+		const AttributedSchema* mParent;
+		Vector<Attribute> mAttributes;
+		size_t mOwnAttributes = 0;	//the number of attributes at the end of mAttributes this class declares itself
+		size_t mStorageSize = 0;
+		gsl::owner<SchemaFactory*> mFactory = nullptr;
+		bool mIsRegistered = false;	//whether the destructor has registrations to remove
+		mutable std::atomic<size_t> mInstanceCount = 0;	//counted by SchemaInstance, through const schemas
+
+		static const NativeParent sNativeParents[];
+		static SchemaTable sSchemas;
+	};
+}
@@ -0,0 +1,216 @@
+#include "pch.h"
+#include "CapacityProfile.h"
+#include "Scope.h"
+#include "Attributed.h"
+
+namespace Library
+{
+	Hashmap<std::string, CapacityProfile::TypeProfile> CapacityProfile::sProfiles{ 31 };
+	size_t CapacityProfile::sScopeCapacity = Scope::DEFAULT_CAPACITY;
+
+	namespace
+	{
+		void KeepLarger(size_t& size, size_t observed)
+		{
+			size = std::max(size, observed);
+		}
+	}
+
+	size_t CapacityProfile::TypeProfile::Capacity() const noexcept
+	{
+		return std::max(mEntries, mBuckets);
+	}
+
+	void CapacityProfile::Observe(const Scope& root)
+	{
+		//breadth first through a list used as a queue, like Scope::Clear, so deep trees do not recurse
+		Vector<const Scope*> scopes;
+		scopes.PushBack(&root);
+		for (size_t i = 0; i < scopes.Size(); ++i)
+		{
+			Record(*scopes[i], scopes);
+		}
+
+		UpdateScopeCapacity();
+	}
+
+	void CapacityProfile::Record(const Scope& scope, Vector<const Scope*>& children)
+	{
+		//a type defined in data is attributed with its schema's id, which has no name to save it under
+		const Attributed* attributed = scope.As<Attributed>();
+		const std::string* typeName = RTTI::FindTypeName(attributed != nullptr ? attributed->RegisteredTypeId() : scope.TypeIdInstance());
+		TypeProfile* profile = (typeName != nullptr ? &sProfiles[*typeName] : nullptr);
+		if (profile != nullptr)
+		{
+			KeepLarger(profile->mEntries, scope.Size());
+		}
+
+		//a scope that has not materialized its layout has nothing in its table yet, and no children
+		if (!scope.IsMaterialized()) { return; }
+
+		if (profile != nullptr)
+		{
+			const size_t longestChain = scope.mTable.LongestChain();
+			KeepLarger(profile->mLongestChain, longestChain);
+			if (longestChain > LONG_CHAIN)
+			{
+				KeepLarger(profile->mBuckets, std::max(scope.mTable.Capacity() * 2, scope.Size()));
+			}
+		}
+
+		for (const auto* pair : scope.mOrderVector)
+		{
+			const Datum& datum = pair->second;
+			if (datum.Type() != DatumType::Table) { continue; }
+			if (profile != nullptr)
+			{
+				KeepLarger(profile->mTables[pair->first], datum.Size());
+			}
+			for (size_t i = 0; i < datum.Size(); ++i)
+			{
+				children.PushBack(&datum.Get<Scope>(i));
+			}
+		}
+	}
+
+	const CapacityProfile::TypeProfile* CapacityProfile::Find(const std::string& typeName)
+	{
+		auto it = sProfiles.Find(typeName);
+		return (it != sProfiles.end() ? &it->second : nullptr);
+	}
+
+	const CapacityProfile::TypeProfile* CapacityProfile::Find(RTTI::IdType type)
+	{
+		if (sProfiles.Size() == 0) { return nullptr; }	//spares registration the name lookup when no profile is loaded
+		const std::string* typeName = RTTI::FindTypeName(type);
+		return (typeName != nullptr ? Find(*typeName) : nullptr);
+	}
+
+	size_t CapacityProfile::EntryCapacity(RTTI::IdType type)
+	{
+		const TypeProfile* profile = Find(type);
+		return (profile != nullptr ? profile->Capacity() : 0);
+	}
+
+	size_t CapacityProfile::TableCapacity(RTTI::IdType type, const std::string& name)
+	{
+		const TypeProfile* profile = Find(type);
+		if (profile == nullptr) { return 0; }
+		auto it = profile->mTables.Find(name);
+		return (it != profile->mTables.end() ? it->second : 0);
+	}
+
+	size_t CapacityProfile::ScopeCapacity() noexcept
+	{
+		return sScopeCapacity;
+	}
+
+	void CapacityProfile::Save(const std::string& filename)
+	{
+		Json::Value types(Json::objectValue);
+		for (const auto& pair : sProfiles)
+		{
+			const TypeProfile& profile = pair.second;
+			Json::Value type(Json::objectValue);
+			type["entries"] = static_cast<unsigned int>(profile.mEntries);
+			type["buckets"] = static_cast<unsigned int>(profile.mBuckets);
+			type["longestChain"] = static_cast<unsigned int>(profile.mLongestChain);
+			Json::Value tables(Json::objectValue);
+			for (const auto& table : profile.mTables)
+			{
+				tables[table.first] = static_cast<unsigned int>(table.second);
+			}
+			type["tables"] = tables;
+			types[pair.first] = type;
+		}
+		Json::Value root;
+		root["types"] = types;
+
+		std::ofstream file(filename);
+		if (!file.good())
+		{
+			throw std::runtime_error("Cannot write capacity profile: " + filename);
+		}
+		Json::StreamWriterBuilder builder;
+		const std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+		writer->write(root, &file);
+	}
+
+	void CapacityProfile::Load(const std::string& filename)
+	{
+		std::ifstream file(filename);
+		if (!file.good())
+		{
+			throw std::runtime_error("Cannot open capacity profile: " + filename);
+		}
+
+		JSONCPP_STRING err;
+		Json::Value root;
+		Json::CharReaderBuilder builder;
+		if (!parseFromStream(builder, file, &root, &err))
+		{
+			throw std::runtime_error("Invalid capacity profile " + filename + ": " + err);
+		}
+		const Json::Value& types = root["types"];
+		if (!types.isObject())
+		{
+			throw std::runtime_error("A capacity profile needs a \"types\" object");
+		}
+
+		const auto size = [](const Json::Value& value)
+		{
+			if (!value.isNull() && !value.isUInt()) { throw std::runtime_error("Capacity profile sizes must be positive integers"); }
+			if (!value.isNull() && value.asUInt() > MAX_SIZE) { throw std::runtime_error("Capacity profile size " + std::to_string(value.asUInt()) + " is above the maximum"); }
+			return static_cast<size_t>(value.isNull() ? 0 : value.asUInt());
+		};
+		//validate the whole file before merging any of it, so a bad entry leaves the recorded profile as it was
+		Hashmap<std::string, TypeProfile> loaded(std::max<size_t>(types.size(), 1));
+		for (const std::string& typeName : types.getMemberNames())
+		{
+			const Json::Value& type = types[typeName];
+			TypeProfile& profile = loaded[typeName];
+			profile.mEntries = size(type["entries"]);
+			profile.mBuckets = size(type["buckets"]);
+			profile.mLongestChain = size(type["longestChain"]);
+			const Json::Value& tables = type["tables"];
+			if (tables.isObject())
+			{
+				for (const std::string& tableName : tables.getMemberNames())
+				{
+					profile.mTables[tableName] = size(tables[tableName]);
+				}
+			}
+		}
+
+		for (const auto& pair : loaded)
+		{
+			const TypeProfile& source = pair.second;
+			TypeProfile& profile = sProfiles[pair.first];
+			KeepLarger(profile.mEntries, source.mEntries);
+			KeepLarger(profile.mBuckets, source.mBuckets);
+			KeepLarger(profile.mLongestChain, source.mLongestChain);
+			for (const auto& table : source.mTables)
+			{
+				KeepLarger(profile.mTables[table.first], table.second);
+			}
+		}
+		UpdateScopeCapacity();
+	}
+
+	void CapacityProfile::UpdateScopeCapacity()
+	{
+		const TypeProfile* scopeProfile = Find(Scope::TypeName());
+		sScopeCapacity = (scopeProfile != nullptr ? std::max<size_t>(scopeProfile->Capacity(), 1) : Scope::DEFAULT_CAPACITY);
+	}
+
+	void CapacityProfile::Clear()
+	{
+		sProfiles.Clear();
+		sScopeCapacity = Scope::DEFAULT_CAPACITY;
+	}
+
+	size_t CapacityProfile::Size()
+	{
+		return sProfiles.Size();
+	}
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <string>
+#include "RTTI.h"
+#include "Hashmap.h"
+#include "vector.h"
+
+namespace Library
+{
+	class Scope; //forward declaration
+
+	/// <summary>
+	/// Sizes scopes from what content actually needed instead of from constants.
+	/// Observe records, per concrete type, the peak number of attributes, the hash chains those produced and the peak number of children in each table attribute.
+	/// The profile is saved to a file at the end of a run and loaded at the start of the next, where TypeRegistry builds each type's layout with room for the
+	/// recorded sizes, and Scope::AppendScope gives plain scopes the recorded capacity. Sizes only grow: a hint is the peak of every run observed.
+	/// </summary>
+	/// <remarks>
+	/// Types are recorded under their RTTI type name so a profile is valid across runs. Types defined by an AttributedSchema have no RTTI name and are not profiled.
+	/// Profiles are files of the form
+	/// { "types": { "Entity": { "entries": 9, "buckets": 9, "longestChain": 2, "tables": { "Actions": 4 } } } }
+	/// </remarks>
+	class CapacityProfile final
+	{
+	public:
+		/// <summary>
+		/// What was observed of one type
+		/// </summary>
+		struct TypeProfile final
+		{
+			size_t mEntries = 0;	//the most attributes an instance had, "this" included
+			size_t mBuckets = 0;	//the table capacity that keeps hash chains short for mEntries
+			size_t mLongestChain = 0;	//the longest hash chain observed
+			Hashmap<std::string, size_t> mTables{ 7 };	//the most children each table attribute had
+
+			/// <summary>
+			/// The capacity instances should start with
+			/// </summary>
+			/// <returns>The larger of the entry count and the bucket count</returns>
+			size_t Capacity() const noexcept;
+		};
+
+		static const size_t LONG_CHAIN = 3;	//a chain longer than this means the table needed more buckets
+		static const size_t MAX_SIZE = 4096;	//the largest size Load accepts: every instance of a type reserves its sizes, so this is sized for one scope, not a world
+
+		CapacityProfile() = delete;
+
+		/// <summary>
+		/// Records the sizes of root and every scope below it
+		/// </summary>
+		/// <param name="root">the tree to record, e.g. the world at the end of a session</param>
+		static void Observe(const Scope& root);
+
+		/// <summary>
+		/// Finds what was recorded of the type with the given name
+		/// </summary>
+		/// <param name="typeName">the RTTI type name</param>
+		/// <returns>The type's profile, or nullptr if nothing was recorded of it</returns>
+		static const TypeProfile* Find(const std::string& typeName);
+
+		/// <summary>
+		/// Finds what was recorded of the type with the given id
+		/// </summary>
+		/// <param name="type">the RTTI type id</param>
+		/// <returns>The type's profile, or nullptr if nothing was recorded of it or type has no RTTI name</returns>
+		static const TypeProfile* Find(RTTI::IdType type);
+
+		/// <summary>
+		/// The number of entries instances of a type should have room for
+		/// </summary>
+		/// <param name="type">the RTTI type id</param>
+		/// <returns>The recorded capacity, or 0 if there is none</returns>
+		static size_t EntryCapacity(RTTI::IdType type);
+
+		/// <summary>
+		/// The number of children a table attribute of a type should have room for
+		/// </summary>
+		/// <param name="type">the RTTI type id</param>
+		/// <param name="name">the name of the table attribute</param>
+		/// <returns>The recorded child count, or 0 if there is none</returns>
+		static size_t TableCapacity(RTTI::IdType type, const std::string& name);
+
+		/// <summary>
+		/// The capacity plain scopes (not of a derived type) are constructed with by Scope::AppendScope
+		/// </summary>
+		/// <returns>The recorded capacity of Scope, or Scope::DEFAULT_CAPACITY if there is none</returns>
+		static size_t ScopeCapacity() noexcept;
+
+		/// <summary>
+		/// Writes every recorded type to a file
+		/// </summary>
+		/// <param name="filename">the path of the profile</param>
+		/// <exception cref="std::runtime_error">Throws exception if the file cannot be written</exception>
+		static void Save(const std::string& filename);
+
+		/// <summary>
+		/// Merges a saved profile into the recorded one, keeping the larger of each size
+		/// </summary>
+		/// <param name="filename">the path of the profile</param>
+		/// <exception cref="std::runtime_error">Throws exception if the file cannot be read, is not a profile, or has a size above MAX_SIZE. Nothing is merged then.</exception>
+		static void Load(const std::string& filename);
+
+		/// <summary>
+		/// Forgets every recorded type
+		/// </summary>
+		static void Clear();
+
+		/// <summary>
+		/// The number of recorded types
+		/// </summary>
+		/// <returns>The number of types in the profile</returns>
+		static size_t Size();
+
+	private:
+		/// <summary>
+		/// Records one scope's sizes, and queues its children
+		/// </summary>
+		/// <param name="scope">the scope to record</param>
+		/// <param name="children">where to append the scope's children</param>
+		static void Record(const Scope& scope, Vector<const Scope*>& children);
+
+		/// <summary>
+		/// Caches the capacity of plain scopes after the profile changes
+		/// </summary>
+		static void UpdateScopeCapacity();
+
+		static Hashmap<std::string, TypeProfile> sProfiles;
+		static size_t sScopeCapacity;	//cached for AppendScope
+	};
+}
@@ -1,20 +1,411 @@
 #include "pch.h"
 #include "Datum.h"
 #include "Scope.h"
-
-#pragma warning(push)
-#pragma warning(disable:4201)
-#include <glm/gtx/string_cast.hpp>
-#pragma warning(pop)
+#include "DefaultHash.h"
+#include <charconv>
+#include <string_view>
 
 namespace Library
 {
+	namespace
+	{
+		template<typename T>
+		void DefaultConstructRange(void* data, size_t count)
+		{
+			T* elements = reinterpret_cast<T*>(data);
+			for (size_t i = 0; i < count; i++)
+			{
+				new(elements + i)T();
+			}
+		}
+
+		template<typename T>
+		void CopyConstructRange(void* destination, const void* source, size_t count)
+		{
+			T* elements = reinterpret_cast<T*>(destination);
+			const T* sourceElements = reinterpret_cast<const T*>(source);
+			for (size_t i = 0; i < count; i++)
+			{
+				new(elements + i)T(sourceElements[i]);
+			}
+		}
+
+		template<typename T>
+		void DestructRange(void* data, size_t count)
+		{
+			T* elements = reinterpret_cast<T*>(data);
+			for (size_t i = 0; i < count; i++)
+			{
+				elements[i].~T();
+			}
+		}
+
+		template<typename T>
+		bool EqualRange(const void* lhs, const void* rhs, size_t count)
+		{
+			const T* lhsElements = reinterpret_cast<const T*>(lhs);
+			const T* rhsElements = reinterpret_cast<const T*>(rhs);
+			return std::equal(lhsElements, lhsElements + count, rhsElements);
+		}
+
+		//std::find instead of a hand written loop, the standard library vectorizes it for arithmetic types
+		template<typename T>
+		size_t FindInRange(const T* data, size_t count, const T& value)
+		{
+			return static_cast<size_t>(std::find(data, data + count, value) - data);
+		}
+
+		//Tables and pointers compare what they point to, not the pointers themselves
+		template<typename T>
+		bool EqualPointedToRange(const void* lhs, const void* rhs, size_t count)
+		{
+			T* const* lhsElements = reinterpret_cast<T* const*>(lhs);
+			T* const* rhsElements = reinterpret_cast<T* const*>(rhs);
+			for (size_t i = 0; i < count; i++)
+			{
+				if (lhsElements[i] != nullptr && !lhsElements[i]->Equals(rhsElements[i])) { return false; }
+			}
+			return true;
+		}
+
+		//Same layouts glm::to_string uses. '#' stands for a float, a space for optional whitespace when parsing
+		const char* const VectorPattern = "vec4(#, #, #, #)";
+		const char* const MatrixPattern = "mat4x4((#, #, #, #), (#, #, #, #), (#, #, #, #), (#, #, #, #))";
+		const char* const Vector2Pattern = "vec2(#, #)";
+		const char* const Vector3Pattern = "vec3(#, #, #)";
+		//w first, the same order as glm::quat's constructor
+		const char* const QuaternionPattern = "quat(#, #, #, #)";
+
+		//Appends characters to a caller supplied buffer, counting the ones that didn't fit so the caller knows the full length
+		class CharWriter final
+		{
+		public:
+			CharWriter(char* buffer, size_t bufferSize) :
+				mBuffer(buffer), mBufferSize(bufferSize)
+			{
+			}
+
+			void Append(const char* characters, size_t count)
+			{
+				if (mLength < mBufferSize)
+				{
+					memcpy(mBuffer + mLength, characters, std::min(count, mBufferSize - mLength));
+				}
+				mLength += count;
+			}
+
+			void Append(const std::string& str)
+			{
+				Append(str.data(), str.size());
+			}
+
+			void Append(int value)
+			{
+				char digits[16];
+				auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+				assert(error == std::errc());
+				Append(digits, end - digits);
+			}
+
+			void Append(std::int64_t value)
+			{
+				char digits[32];
+				auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+				assert(error == std::errc());
+				Append(digits, end - digits);
+			}
+
+			//Shortest representation that reads back to the same value, doubles are used where float precision isn't enough
+			void Append(double value)
+			{
+				char digits[32];
+				auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+				assert(error == std::errc());
+				Append(digits, end - digits);
+			}
+
+			void Append(bool value)
+			{
+				if (value)
+				{
+					Append("true", 4);
+				}
+				else
+				{
+					Append("false", 5);
+				}
+			}
+
+			//Formats like printf's %f (six decimals), which is what std::to_string and glm::to_string produce
+			void Append(float value)
+			{
+				char digits[64];
+				auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, 6);
+				assert(error == std::errc());
+				Append(digits, end - digits);
+			}
+
+			void AppendPattern(const char* pattern, const float* values)
+			{
+				for (; *pattern != '\0'; ++pattern)
+				{
+					if (*pattern == '#')
+					{
+						Append(*values++);
+					}
+					else
+					{
+						Append(pattern, 1);
+					}
+				}
+			}
+
+			size_t Length() const
+			{
+				return mLength;
+			}
+
+		private:
+			char* mBuffer;
+			size_t mBufferSize;
+			size_t mLength = 0;
+		};
+
+		//locale independent, unlike isspace
+		const char* SkipWhitespace(const char* first, const char* last)
+		{
+			while (first != last && (*first == ' ' || *first == '\t' || *first == '\n' || *first == '\r' || *first == '\f' || *first == '\v'))
+			{
+				++first;
+			}
+			return first;
+		}
+
+		//Accepts what std::stoi/std::stof accept (leading whitespace, optional sign) without allocating or consulting the locale
+		template<typename T>
+		std::from_chars_result ParseNumber(const char* first, const char* last, T& value)
+		{
+			first = SkipWhitespace(first, last);
+			if (first != last && *first == '+' && (first + 1 == last || first[1] != '-'))
+			{
+				++first;
+			}
+			return std::from_chars(first, last, value);
+		}
+
+		//Matches the same inputs as the sscanf formats this replaced
+		bool ParsePattern(const char* first, const char* last, const char* pattern, float* values)
+		{
+			for (; *pattern != '\0'; ++pattern)
+			{
+				if (*pattern == ' ')
+				{
+					first = SkipWhitespace(first, last);
+				}
+				else if (*pattern == '#')
+				{
+					auto [end, error] = ParseNumber(first, last, *values++);
+					if (error != std::errc()) { return false; }
+					first = end;
+				}
+				else
+				{
+					if (first == last || *first != *pattern) { return false; }
+					++first;
+				}
+			}
+			return true;
+		}
+
+		//the whole input must be one of true, false, 1 or 0, apart from surrounding whitespace
+		bool ParseBool(const char* first, const char* last, bool& value)
+		{
+			first = SkipWhitespace(first, last);
+			while (last != first && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\n' || last[-1] == '\r' || last[-1] == '\f' || last[-1] == '\v'))
+			{
+				--last;
+			}
+			const std::string_view text(first, last - first);
+			if (text == "true" || text == "1")
+			{
+				value = true;
+				return true;
+			}
+			if (text == "false" || text == "0")
+			{
+				value = false;
+				return true;
+			}
+			return false;
+		}
+
+		//Throws the same exceptions std::stoi/std::stof would
+		void ThrowIfParseFailed(std::errc error)
+		{
+			if (error == std::errc::invalid_argument)
+			{
+				throw std::invalid_argument("invalid string input");
+			}
+			if (error == std::errc::result_out_of_range)
+			{
+				throw std::out_of_range("string input is out of range");
+			}
+		}
+
+		template<typename T>
+		size_t NumberToString(const void* data, char* buffer, size_t bufferSize)
+		{
+			CharWriter writer(buffer, bufferSize);
+			writer.Append(*reinterpret_cast<const T*>(data));
+			return writer.Length();
+		}
+
+		size_t VectorToString(const void* data, char* buffer, size_t bufferSize)
+		{
+			CharWriter writer(buffer, bufferSize);
+			writer.AppendPattern(VectorPattern, &(*reinterpret_cast<const glm::vec4*>(data))[0]);
+			return writer.Length();
+		}
+
+		size_t MatrixToString(const void* data, char* buffer, size_t bufferSize)
+		{
+			CharWriter writer(buffer, bufferSize);
+			writer.AppendPattern(MatrixPattern, &(*reinterpret_cast<const glm::mat4*>(data))[0][0]);
+			return writer.Length();
+		}
+
+		size_t Vector2ToString(const void* data, char* buffer, size_t bufferSize)
+		{
+			CharWriter writer(buffer, bufferSize);
+			writer.AppendPattern(Vector2Pattern, &(*reinterpret_cast<const glm::vec2*>(data))[0]);
+			return writer.Length();
+		}
+
+		size_t Vector3ToString(const void* data, char* buffer, size_t bufferSize)
+		{
+			CharWriter writer(buffer, bufferSize);
+			writer.AppendPattern(Vector3Pattern, &(*reinterpret_cast<const glm::vec3*>(data))[0]);
+			return writer.Length();
+		}
+
+		size_t QuaternionToString(const void* data, char* buffer, size_t bufferSize)
+		{
+			const glm::quat& quaternion = *reinterpret_cast<const glm::quat*>(data);
+			const float values[] = { quaternion.w, quaternion.x, quaternion.y, quaternion.z };
+			CharWriter writer(buffer, bufferSize);
+			writer.AppendPattern(QuaternionPattern, values);
+			return writer.Length();
+		}
+
+		size_t StringToString(const void* data, char* buffer, size_t bufferSize)
+		{
+			CharWriter writer(buffer, bufferSize);
+			writer.Append(*reinterpret_cast<const std::string*>(data));
+			return writer.Length();
+		}
+
+		size_t PointerToString(const void* data, char* buffer, size_t bufferSize)
+		{
+			CharWriter writer(buffer, bufferSize);
+			writer.Append((*reinterpret_cast<RTTI* const*>(data))->ToString());
+			return writer.Length();
+		}
+	}
+
+	namespace
+	{
+		void ThrowCannotDefaultConstruct(void*, size_t)
+		{
+			throw std::runtime_error("cannot default construct Scope* objects");
+		}
+
+		size_t HashStrings(const void* data, size_t count)
+		{
+			const std::string* strings = reinterpret_cast<const std::string*>(data);
+			size_t hash = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				hash = HashCombine(hash, std::hash<std::string>{}(strings[i]));
+			}
+			return hash;
+		}
+
+		size_t HashScopes(const void* data, size_t count)
+		{
+			Scope* const* scopes = reinterpret_cast<Scope* const*>(data);
+			size_t hash = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				hash = HashCombine(hash, scopes[i]->StructuralHash());
+			}
+			return hash;
+		}
+
+		//floats that compare equal can differ in bytes (-0 and 0), so they are hashed by value. Adding 0 turns -0 into 0.
+		template<typename TScalar, size_t Components>
+		size_t HashScalars(const void* data, size_t count)
+		{
+			const TScalar* scalars = reinterpret_cast<const TScalar*>(data);
+			size_t hash = 0;
+			for (size_t i = 0; i < count * Components; i++)
+			{
+				hash = HashCombine(hash, std::hash<TScalar>{}(scalars[i] + TScalar(0)));
+			}
+			return hash;
+		}
+
+		//EqualPointedToRange treats a null pointer as equal to anything, so pointed to objects cannot contribute to a hash that agrees with ==
+		size_t HashPointers(const void*, size_t)
+		{
+			return 0;
+		}
+	}
+
+	const Datum::TypeOperations Datum::DatumOperations[] =
+	{
+		//Unknown
+		{ nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr },
+		//Integer
+		{ DefaultConstructRange<int>, nullptr, nullptr, nullptr, NumberToString<int>, &Datum::SetFromString<int>, nullptr },
+		//Float
+		{ DefaultConstructRange<float>, nullptr, nullptr, EqualRange<float>, NumberToString<float>, &Datum::SetFromString<float>, HashScalars<float, 1> },
+		//Vector
+		{ DefaultConstructRange<glm::vec4>, nullptr, nullptr, EqualRange<glm::vec4>, VectorToString, &Datum::SetFromString<glm::vec4>, HashScalars<float, 4> },
+		//Matrix
+		{ DefaultConstructRange<glm::mat4>, nullptr, nullptr, EqualRange<glm::mat4>, MatrixToString, &Datum::SetFromString<glm::mat4>, HashScalars<float, 16> },
+		//Table: cannot default construct Scope* objects, and cannot be converted to or from a string
+		{ ThrowCannotDefaultConstruct, nullptr, nullptr, EqualPointedToRange<Scope>, nullptr, nullptr, HashScopes },
+		//String
+		{ DefaultConstructRange<std::string>, CopyConstructRange<std::string>, DestructRange<std::string>, EqualRange<std::string>, StringToString, &Datum::SetFromString<std::string>, HashStrings },
+		//Pointer
+		{ DefaultConstructRange<RTTI*>, nullptr, nullptr, EqualPointedToRange<RTTI>, PointerToString, nullptr, HashPointers },
+		//Boolean
+		{ DefaultConstructRange<bool>, nullptr, nullptr, nullptr, NumberToString<bool>, &Datum::SetFromString<bool>, nullptr },
+		//Integer64
+		{ DefaultConstructRange<std::int64_t>, nullptr, nullptr, nullptr, NumberToString<std::int64_t>, &Datum::SetFromString<std::int64_t>, nullptr },
+		//Double
+		{ DefaultConstructRange<double>, nullptr, nullptr, EqualRange<double>, NumberToString<double>, &Datum::SetFromString<double>, HashScalars<double, 1> },
+		//Vector2
+		{ DefaultConstructRange<glm::vec2>, nullptr, nullptr, EqualRange<glm::vec2>, Vector2ToString, &Datum::SetFromString<glm::vec2>, HashScalars<float, 2> },
+		//Vector3
+		{ DefaultConstructRange<glm::vec3>, nullptr, nullptr, EqualRange<glm::vec3>, Vector3ToString, &Datum::SetFromString<glm::vec3>, HashScalars<float, 3> },
+		//Quaternion
+		{ DefaultConstructRange<glm::quat>, nullptr, nullptr, EqualRange<glm::quat>, QuaternionToString, &Datum::SetFromString<glm::quat>, HashScalars<float, 4> },
+		//Custom: value types are trivially copyable and zero initialized, their ValueType compares and hashes them. They have no string form
+		{ nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr }
+	};
+
 	Datum::Datum(DatumType type, size_t capacity) :
 		mType(type), mCapacity(capacity)
 	{
-		if (capacity != 0)
+		if (type == DatumType::Custom)
+		{
+			mCapacity = 0;	//element size isn't known until SetType(const ValueType&)
+		}
+
+		if (mCapacity != 0)
 		{
-			void* newData = malloc(capacity * DatumSizes[static_cast<int>(mType)]);
+			void* newData = malloc(capacity * ElementSize());
 			assert(newData != nullptr);
 			mData.vo = newData;
 		}
@@ -26,44 +417,43 @@ namespace Library
 	}
 
 	Datum::Datum(const Datum& rhs) :
-		mIsExternal(rhs.mIsExternal), mSize(rhs.mSize), mType(rhs.mType) 
+		mIsExternal(rhs.mIsExternal), mSize(rhs.mSize), mType(rhs.mType), mValueType(rhs.mValueType)
 	{
 		if (mIsExternal)
 		{
 			mData.vo = rhs.mData.vo;
 		}
+		else if (rhs.mShareCount != nullptr)
+		{
+			//copy on write, share the array until one of us modifies it
+			mData.vo = rhs.mData.vo;
+			mCapacity = rhs.mCapacity;
+			mShareCount = rhs.mShareCount;
+			++(*mShareCount);
+		}
 		else
 		{
 			mData.vo = nullptr;
 			ReallocData(rhs.mCapacity);
-			if (rhs.mType == DatumType::String)
-			{
-				for (size_t i = 0; i < mSize; i++)
-				{
-					new(mData.s + i)std::string(rhs.Get<std::string>(i));
-				}
-			}
-			else
-			{
-				memcpy(mData.vo, rhs.mData.vo, rhs.mSize * DatumSizes[static_cast<int>(mType)]); //deep copy
-			}
+			CopyElements(rhs.mData.vo, rhs.mSize); //deep copy
 		}
 	}
 
 	Datum::Datum(Datum&& rhs) noexcept :
-		mSize(rhs.mSize), mIsExternal(rhs.mIsExternal), mData(rhs.mData), mCapacity(rhs.mCapacity), mType(rhs.mType)
+		mSize(rhs.mSize), mIsExternal(rhs.mIsExternal), mData(rhs.mData), mCapacity(rhs.mCapacity), mType(rhs.mType), mValueType(rhs.mValueType), mShareCount(rhs.mShareCount)
 	{
 		rhs.mSize = 0;
 		rhs.mCapacity = 0;
 		rhs.mData.vo = nullptr;
+		rhs.mShareCount = nullptr;
+		RelinkScopes(&rhs, 0, mSize);
 	}
 
 	Datum::~Datum()
 	{
 		if (!mIsExternal)
 		{
-			Clear();
-			free(mData.vo);
+			ReleaseStorage();
 		}
 	}
 
@@ -71,32 +461,35 @@ namespace Library
 	{
 		if (this != &rhs)
 		{
-			if (!mIsExternal) { Clear(); }
+			MarkDirty();	//the owner stays with this datum, it is not copied from rhs
+			if (!mIsExternal)
+			{
+				//a shared array can't be reused, and rhs's shared array replaces ours anyway
+				if (mShareCount != nullptr || rhs.mShareCount != nullptr) { ReleaseStorage(); }
+				else { Clear(); }
+			}
 
 			mSize = rhs.mSize;
 			mCapacity = rhs.mCapacity;
 			mType = rhs.mType;
+			mValueType = rhs.mValueType;
 
 			if (rhs.mIsExternal)
 			{
 				if (!mIsExternal) { free(mData.vo); }	//don't leak memory
 				mData.vo = rhs.mData.vo;	//shallow copy
 			}
+			else if (rhs.mShareCount != nullptr)
+			{
+				mData.vo = rhs.mData.vo;	//copy on write
+				mShareCount = rhs.mShareCount;
+				++(*mShareCount);
+			}
 			else
 			{
 				if (mIsExternal) { mData.vo = nullptr; } //protect external storage pointer
 				ReallocData(rhs.mCapacity);
-				if (rhs.mType == DatumType::String)
-				{
-					for (size_t i = 0; i < mSize; i++)
-					{
-						new(mData.s + i)std::string(rhs.Get<std::string>(i));
-					}
-				}
-				else
-				{
-					memcpy(mData.vo, rhs.mData.vo, rhs.mSize * DatumSizes[static_cast<int>(mType)]); //deep copy
-				}
+				CopyElements(rhs.mData.vo, rhs.mSize); //deep copy
 			}
 			mIsExternal = rhs.mIsExternal;
 		}
@@ -108,11 +501,11 @@ namespace Library
 	{
 		if (this != &rhs)
 		{
+			MarkDirty();	//the owner stays with this datum, it is not moved from rhs
 			//if have internal storage, clear and free it
 			if (!mIsExternal)
 			{
-				Clear();
-				free(mData.vo);
+				ReleaseStorage();
 			}
 
 			//copy
@@ -121,11 +514,15 @@ namespace Library
 			mData = rhs.mData;
 			mCapacity = rhs.mCapacity;
 			mType = rhs.mType;
+			mValueType = rhs.mValueType;
+			mShareCount = rhs.mShareCount;
 
 			//invalidate
 			rhs.mSize = 0;
 			rhs.mCapacity = 0;
 			rhs.mData.vo = nullptr;
+			rhs.mShareCount = nullptr;
+			RelinkScopes(&rhs, 0, mSize);
 		}
 		return *this;
 	}
@@ -133,6 +530,7 @@ namespace Library
 	Datum& Datum::operator=(int value)
 	{
 		SetType(DatumType::Integer); //will throw exception if type isn't this or unknown
+		MarkDirty();
 		ReallocData(1);
 		mData.i[0] = value;
 		mSize = 1;
@@ -143,6 +541,7 @@ namespace Library
 	Datum& Datum::operator=(float value)
 	{
 		SetType(DatumType::Float);	//will throw exception if type isn't this or unknown
+		MarkDirty();
 		ReallocData(1);
 		mData.f[0] = value;
 		mSize = 1;
@@ -153,6 +552,7 @@ namespace Library
 	Datum& Datum::operator=(const glm::vec4& value)
 	{
 		SetType(DatumType::Vector);	//will throw exception if type isn't this or unknown
+		MarkDirty();
 		ReallocData(1);
 		mData.v[0] = value;
 		mSize = 1;
@@ -163,6 +563,7 @@ namespace Library
 	Datum& Datum::operator=(const glm::mat4& value)
 	{
 		SetType(DatumType::Matrix);	//will throw exception if type isn't this or unknown
+		MarkDirty();
 		ReallocData(1);
 		mData.m[0] = value;
 		mSize = 1;
@@ -173,6 +574,7 @@ namespace Library
 	Datum& Datum::operator=(Scope& value)
 	{
 		SetType(DatumType::Table);	//will throw exception if type isn't this or unknown
+		MarkDirty();
 		ReallocData(1);
 		mData.t[0] = &value;
 		mSize = 1;
@@ -194,42 +596,139 @@ namespace Library
 	Datum& Datum::operator=(RTTI* value)
 	{
 		SetType(DatumType::Pointer);	//will throw exception if type isn't this or unknown
+		MarkDirty();
 		ReallocData(1);
 		mData.p[0] = value;
 		mSize = 1;
 
 		return *this;
 	}
+
+	Datum& Datum::operator=(bool value)
+	{
+		SetType(DatumType::Boolean);	//will throw exception if type isn't this or unknown
+		MarkDirty();
+		ReallocData(1);
+		mData.b[0] = value;
+		mSize = 1;
+
+		return *this;
+	}
+
+	Datum& Datum::operator=(std::int64_t value)
+	{
+		SetType(DatumType::Integer64);	//will throw exception if type isn't this or unknown
+		MarkDirty();
+		ReallocData(1);
+		mData.l[0] = value;
+		mSize = 1;
+
+		return *this;
+	}
+
+	Datum& Datum::operator=(double value)
+	{
+		SetType(DatumType::Double);	//will throw exception if type isn't this or unknown
+		MarkDirty();
+		ReallocData(1);
+		mData.d[0] = value;
+		mSize = 1;
+
+		return *this;
+	}
+
+	Datum& Datum::operator=(const glm::vec2& value)
+	{
+		SetType(DatumType::Vector2);	//will throw exception if type isn't this or unknown
+		MarkDirty();
+		ReallocData(1);
+		mData.v2[0] = value;
+		mSize = 1;
+
+		return *this;
+	}
+
+	Datum& Datum::operator=(const glm::vec3& value)
+	{
+		SetType(DatumType::Vector3);	//will throw exception if type isn't this or unknown
+		MarkDirty();
+		ReallocData(1);
+		mData.v3[0] = value;
+		mSize = 1;
+
+		return *this;
+	}
+
+	Datum& Datum::operator=(const glm::quat& value)
+	{
+		SetType(DatumType::Quaternion);	//will throw exception if type isn't this or unknown
+		MarkDirty();
+		ReallocData(1);
+		mData.q[0] = value;
+		mSize = 1;
+
+		return *this;
+	}
 	
 	bool Datum::operator==(const Datum& rhs) const noexcept
 	{
-		if (mData.vo == rhs.mData.vo && mType == rhs.mType) { return true; } //early exit
-		if (mType == rhs.mType && mSize == rhs.mSize && mCapacity == rhs.mCapacity)
+		if (mData.vo == rhs.mData.vo && mType == rhs.mType && mValueType == rhs.mValueType) { return true; } //early exit
+		if (mType == rhs.mType && mValueType == rhs.mValueType && mSize == rhs.mSize && mCapacity == rhs.mCapacity)
 		{
-			//if string, have to compare each type
-			if (mType == DatumType::String)
+			if (mType == DatumType::Custom)
 			{
-				for (size_t i = 0; i < mSize; i++)
-				{
-					if (mData.s[i] != rhs.mData.s[i]) { return false; }
-				}
-				return true; //if didn't early exit, then everything matched.
+				return (mSize == 0 || mValueType->Equal(mData.vo, rhs.mData.vo, mSize));
 			}
-			else if (mType == DatumType::Pointer || mType == DatumType::Table)
+
+			const TypeOperations& operations = Operations();
+			if (operations.Equal != nullptr)
 			{
-				for (size_t i = 0; i < mSize; i++)
-				{
-					if (mData.p[i] != nullptr && !mData.p[i]->Equals(rhs.mData.p[i])) { return false; }
-				}
-				return true; //if didn't early exit, then everything matched.
+				return operations.Equal(mData.vo, rhs.mData.vo, mSize);
 			}
 
-			//if not string, can just mem compare
-			return !memcmp(mData.vo, rhs.mData.vo, mSize * DatumSizes[static_cast<int>(mType)]);	//memcmp returns 0 if same, non zero if not same
+			//if bytewise comparable, can just mem compare
+			return !memcmp(mData.vo, rhs.mData.vo, mSize * ElementSize());	//memcmp returns 0 if same, non zero if not same
 		}
 		return false;	//if here, type size or capacity didn't match
 	}
 
+	void Datum::InvalidateOwnerHash() noexcept
+	{
+		mOwner->InvalidateStructuralHash();
+	}
+
+	void Datum::NotifyOwner() noexcept
+	{
+		mOwner->InvalidateStructuralHash();
+		//once dirty, the owner and its ancestors already know until they collect the change
+		if (!mIsDirty)
+		{
+			mIsDirty = true;
+			mOwner->MarkChanged();
+		}
+	}
+
+	size_t Datum::Hash() const
+	{
+		size_t hash = HashCombine(static_cast<size_t>(mType), mSize);
+		if (mSize == 0) { return hash; }
+
+		if (mType == DatumType::Custom)
+		{
+			return HashCombine(hash, mValueType->Hash(mData.vo, mSize));
+		}
+
+		const TypeOperations& operations = Operations();
+		if (operations.Hash != nullptr)
+		{
+			return HashCombine(hash, operations.Hash(mData.vo, mSize));
+		}
+
+		//bytewise, the same way operator== compares these types
+		const std::string_view bytes(reinterpret_cast<const char*>(mData.vo), mSize * ElementSize());
+		return HashCombine(hash, std::hash<std::string_view>{}(bytes));
+	}
+
 	void Datum::Resize(size_t capacity, bool defaultConstruct)
 	{
 		CheckTypeHasBeenSet();
@@ -244,151 +743,300 @@ namespace Library
 			return;
 		}
 
-		//if shrinking and items are strings, destruct strings that won't fit anymore
-		if (capacity < mSize && mType == DatumType::String)
+		PrepareWrite();
+
+		//if shrinking, destruct items that won't fit anymore
+		if (capacity < mSize)
 		{
-			for (size_t i = mSize - 1; i >= capacity; i--)
-			{
-				mData.s[i].~basic_string();
-			}
+			DestructElements(capacity, mSize);
 		}
 
 
-		void* newData = realloc(mData.vo, capacity * DatumSizes[static_cast<int>(mType)]);
+		void* newData = realloc(mData.vo, capacity * ElementSize());
 		assert(newData != nullptr);
 		mData.vo = newData;
 
-		if (defaultConstruct)
+		if (defaultConstruct && mSize < capacity)
 		{
-			//todo: change this so that it isn't checking type each loop.
-			for (size_t i = mSize; i < capacity; i++)
+			auto construct = Operations().DefaultConstruct;
+			if (construct != nullptr)
 			{
-				switch (mType)
-				{
-				case DatumType::Integer:
-					new(mData.i + i)int();
-					break;
-				case DatumType::Float:
-					new(mData.f + i)float();
-					break;
-				case DatumType::Vector:
-					new(mData.v + i)glm::vec4();
-					break;
-				case DatumType::Matrix:
-					new(mData.m + i)glm::mat4();
-					break;
-				case DatumType::Table:
-					throw std::runtime_error("cannot default construct Scope* objects");
-					break;
-				case DatumType::String:
-					new(mData.s + i)std::string();
-					break;
-				case DatumType::Pointer:
-					new(mData.p + i)RTTI*(nullptr);
-					break;
-				default:
-					assert(false);
-				}
+				construct(mData.byte + (mSize * ElementSize()), capacity - mSize);
+			}
+			else
+			{
+				memset(mData.byte + (mSize * ElementSize()), 0, (capacity - mSize) * ElementSize());
 			}
 			mSize = capacity;
 		}
 
-		mSize = std::min(mSize, capacity);
-		mCapacity = capacity;
+		mSize = std::min(mSize, capacity);
+		mCapacity = capacity;
+	}
+
+	void Datum::SetType(const ValueType& valueType)
+	{
+		TypeCheckOrUnknown(DatumType::Custom);	//throw exception if mType != Custom or unknown
+		if (mValueType != nullptr && mValueType != &valueType)
+		{
+			throw std::runtime_error("Datum type cannot change after it is set");
+		}
+		mType = DatumType::Custom;
+		mValueType = &valueType;
+	}
+
+	void Datum::Reserve(size_t capacity)
+	{
+		CheckTypeHasBeenSet();	
+		ExternalException();
+		if (mCapacity >= capacity) { return; } //can't shrink array
+		ReallocData(capacity);
+	}
+	
+	void Datum::Clear()
+	{
+		ExternalException();
+		MarkDirty();
+		if (IsStorageShared())
+		{
+			//the elements belong to the other Datums, just take an empty array of our own
+			DetachStorage(mCapacity, 0);
+			return;
+		}
+		DestructElements(0, mSize);
+		mSize = 0;
+	}
+
+	void Datum::EnableSharedStorage()
+	{
+		ExternalException();
+		if (mType == DatumType::Table)
+		{
+			throw std::runtime_error("Table datums cannot share storage, each Scope has one parent");
+		}
+		if (mShareCount == nullptr)
+		{
+			mShareCount = new std::atomic<size_t>(1);
+		}
+	}
+
+	void Datum::Set(int value, size_t index)
+	{
+		TypeCheck(DatumType::Integer);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		mData.i[index] = value;
+	}
+
+	void Datum::Set(float value, size_t index)
+	{
+		TypeCheck(DatumType::Float);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		mData.f[index] = value;
+	}
+
+	void Datum::Set(const glm::vec4& value, size_t index)
+	{
+		TypeCheck(DatumType::Vector);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		mData.v[index] = value;
+	}
+
+	void Datum::Set(const glm::mat4& value, size_t index)
+	{
+		TypeCheck(DatumType::Matrix);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		mData.m[index] = value;
+	}
+
+	void Datum::Set(Scope& value, size_t index)
+	{
+		TypeCheck(DatumType::Table);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		UnlinkScopes(index, index + 1);
+		mData.t[index] = &value;
+	}
+
+	void Datum::Set(const std::string& value, size_t index)
+	{
+		TypeCheck(DatumType::String);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		mData.s[index] = value;
+	}
+
+	void Datum::Set(RTTI* value, size_t index)
+	{
+		TypeCheck(DatumType::Pointer);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		mData.p[index] = value;
+	}
+
+	void Datum::Set(bool value, size_t index)
+	{
+		TypeCheck(DatumType::Boolean);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		mData.b[index] = value;
+	}
+
+	void Datum::Set(std::int64_t value, size_t index)
+	{
+		TypeCheck(DatumType::Integer64);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		mData.l[index] = value;
+	}
+
+	void Datum::Set(double value, size_t index)
+	{
+		TypeCheck(DatumType::Double);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		mData.d[index] = value;
+	}
+
+	void Datum::Set(const glm::vec2& value, size_t index)
+	{
+		TypeCheck(DatumType::Vector2);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		mData.v2[index] = value;
+	}
+
+	void Datum::Set(const glm::vec3& value, size_t index)
+	{
+		TypeCheck(DatumType::Vector3);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		mData.v3[index] = value;
+	}
+
+	void Datum::Set(const glm::quat& value, size_t index)
+	{
+		TypeCheck(DatumType::Quaternion);
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		mData.q[index] = value;
+	}
+
+	void Datum::SetFromStringDanger(const std::string& str, size_t index)
+	{
+		CheckTypeHasBeenSet();
+		auto setFromString = Operations().SetFromString;
+		if (setFromString != nullptr)
+		{
+			(this->*setFromString)(str, index);
+		}
+	}
+
+	template<>
+	void Datum::SetFromString<int>(const std::string& str, size_t index)
+	{
+		int value;
+		ThrowIfParseFailed(ParseNumber(str.data(), str.data() + str.size(), value).ec);
+		Set(value, index);
 	}
 
-	void Datum::Reserve(size_t capacity)
+	template<>
+	void Datum::SetFromString<float>(const std::string& str, size_t index)
 	{
-		CheckTypeHasBeenSet();	
-		ExternalException();
-		if (mCapacity >= capacity) { return; } //can't shrink array
-		ReallocData(capacity);
+		float value;
+		ThrowIfParseFailed(ParseNumber(str.data(), str.data() + str.size(), value).ec);
+		Set(value, index);
 	}
-	
-	void Datum::Clear()
+
+	template<>
+	void Datum::SetFromString<glm::vec4>(const std::string& str, size_t index)
 	{
-		ExternalException();
-		if (mType == DatumType::String)
+		glm::vec4 values;
+		if (!ParsePattern(str.data(), str.data() + str.size(), VectorPattern, &values[0]))
 		{
-			for (size_t i = 0; i < mSize; i++)
-			{
-				mData.s[i].~basic_string();
-			}
+			throw std::runtime_error("invalid string input");
 		}
 
-		mSize = 0;
+		Set(values, index);
 	}
 
-	void Datum::Set(int value, size_t index)
+	template<>
+	void Datum::SetFromString<glm::mat4>(const std::string& str, size_t index)
 	{
-		TypeCheck(DatumType::Integer);
-		VerifyIndexInBounds(index);
-		mData.i[index] = value;
-	}
+		glm::mat4 val;
+		if (!ParsePattern(str.data(), str.data() + str.size(), MatrixPattern, &val[0][0]))
+		{
+			throw std::runtime_error("invalid string input");
+		}
 
-	void Datum::Set(float value, size_t index)
-	{
-		TypeCheck(DatumType::Float);
-		VerifyIndexInBounds(index);
-		mData.f[index] = value;
+		Set(val, index);
 	}
 
-	void Datum::Set(const glm::vec4& value, size_t index)
+	template<>
+	void Datum::SetFromString<bool>(const std::string& str, size_t index)
 	{
-		TypeCheck(DatumType::Vector);
-		VerifyIndexInBounds(index);
-		mData.v[index] = value;
+		bool value;
+		if (!ParseBool(str.data(), str.data() + str.size(), value))
+		{
+			throw std::invalid_argument("invalid string input");
+		}
+
+		Set(value, index);
 	}
 
-	void Datum::Set(const glm::mat4& value, size_t index)
+	template<>
+	void Datum::SetFromString<std::int64_t>(const std::string& str, size_t index)
 	{
-		TypeCheck(DatumType::Matrix);
-		VerifyIndexInBounds(index);
-		mData.m[index] = value;
+		std::int64_t value;
+		ThrowIfParseFailed(ParseNumber(str.data(), str.data() + str.size(), value).ec);
+		Set(value, index);
 	}
 
-	void Datum::Set(Scope& value, size_t index)
+	template<>
+	void Datum::SetFromString<double>(const std::string& str, size_t index)
 	{
-		TypeCheck(DatumType::Table);
-		VerifyIndexInBounds(index);
-		mData.t[index] = &value;
+		double value;
+		ThrowIfParseFailed(ParseNumber(str.data(), str.data() + str.size(), value).ec);
+		Set(value, index);
 	}
 
-	void Datum::Set(const std::string& value, size_t index)
+	template<>
+	void Datum::SetFromString<glm::vec2>(const std::string& str, size_t index)
 	{
-		TypeCheck(DatumType::String);
-		VerifyIndexInBounds(index);
-		mData.s[index] = value;
+		glm::vec2 values;
+		if (!ParsePattern(str.data(), str.data() + str.size(), Vector2Pattern, &values[0]))
+		{
+			throw std::runtime_error("invalid string input");
+		}
+
+		Set(values, index);
 	}
 
-	void Datum::Set(RTTI* value, size_t index)
+	template<>
+	void Datum::SetFromString<glm::vec3>(const std::string& str, size_t index)
 	{
-		TypeCheck(DatumType::Pointer);
-		VerifyIndexInBounds(index);
-		mData.p[index] = value;
+		glm::vec3 values;
+		if (!ParsePattern(str.data(), str.data() + str.size(), Vector3Pattern, &values[0]))
+		{
+			throw std::runtime_error("invalid string input");
+		}
+
+		Set(values, index);
 	}
 
-	void Datum::SetFromStringDanger(const std::string& str, size_t index)
+	template<>
+	void Datum::SetFromString<glm::quat>(const std::string& str, size_t index)
 	{
-		CheckTypeHasBeenSet();
-		switch (mType)
-		{
-		case DatumType::Integer:
-			SetFromString<int>(str, index);
-			break;
-		case DatumType::Float:
-			SetFromString<float>(str, index);
-			break;
-		case DatumType::Vector:
-			SetFromString<glm::vec4>(str, index);
-			break;
-		case DatumType::Matrix:
-			SetFromString<glm::mat4>(str, index);
-			break;
-		case DatumType::String:
-			SetFromString<std::string>(str, index);
-			break;
+		float values[4];
+		if (!ParsePattern(str.data(), str.data() + str.size(), QuaternionPattern, values))
+		{
+			throw std::runtime_error("invalid string input");
 		}
+
+		Set(glm::quat(values[0], values[1], values[2], values[3]), index);
 	}
 
 	void Datum::PushBack(int data)
@@ -455,78 +1103,93 @@ namespace Library
 		mSize++;
 	}
 
+	void Datum::PushBack(bool data)
+	{
+		SetType(DatumType::Boolean);	//will throw exception if datum has a type other than boolean or unknown
+		ExternalException();
+		IncrementCapacityIfFull();
+		mData.b[mSize] = data;
+		mSize++;
+	}
+
+	void Datum::PushBack(std::int64_t data)
+	{
+		SetType(DatumType::Integer64);	//will throw exception if datum has a type other than integer64 or unknown
+		ExternalException();
+		IncrementCapacityIfFull();
+		mData.l[mSize] = data;
+		mSize++;
+	}
+
+	void Datum::PushBack(double data)
+	{
+		SetType(DatumType::Double);	//will throw exception if datum has a type other than double or unknown
+		ExternalException();
+		IncrementCapacityIfFull();
+		mData.d[mSize] = data;
+		mSize++;
+	}
+
+	void Datum::PushBack(const glm::vec2& data)
+	{
+		SetType(DatumType::Vector2);	//will throw exception if datum has a type other than vector2 or unknown
+		ExternalException();
+		IncrementCapacityIfFull();
+		mData.v2[mSize] = data;
+		mSize++;
+	}
+
+	void Datum::PushBack(const glm::vec3& data)
+	{
+		SetType(DatumType::Vector3);	//will throw exception if datum has a type other than vector3 or unknown
+		ExternalException();
+		IncrementCapacityIfFull();
+		mData.v3[mSize] = data;
+		mSize++;
+	}
+
+	void Datum::PushBack(const glm::quat& data)
+	{
+		SetType(DatumType::Quaternion);	//will throw exception if datum has a type other than quaternion or unknown
+		ExternalException();
+		IncrementCapacityIfFull();
+		mData.q[mSize] = data;
+		mSize++;
+	}
+
 	void Datum::PopBack()
 	{
 		ExternalException();
 		if (mSize == 0) { return; } //if list is empty, just return
 
-		//have to destruct strings
-		if (mType == DatumType::String)
-		{
-			mData.s[mSize - 1].~basic_string();
-		}
-
+		PrepareWrite();
+		UnlinkScopes(mSize - 1, mSize);
+		DestructElements(mSize - 1, mSize);
 		mSize--;
 	}
 
 	size_t Datum::Find(int value) const
 	{
 		TypeCheck(DatumType::Integer);
-		for (size_t i = 0; i < mSize; i++)
-		{
-			if (mData.i[i] == value)
-			{
-				return i;
-			}
-		}
-
-		//if here, did not find it
-		return mSize;
+		return FindInRange(mData.i, mSize, value);
 	}
 
 	size_t Datum::Find(float value) const
 	{
 		TypeCheck(DatumType::Float);
-		for (size_t i = 0; i < mSize; i++)
-		{
-			if (mData.f[i] == value)
-			{
-				return i;
-			}
-		}
-
-		//if here, did not find it
-		return mSize;
+		return FindInRange(mData.f, mSize, value);
 	}
 
 	size_t Datum::Find(const glm::vec4& value) const
 	{
 		TypeCheck(DatumType::Vector);
-		for (size_t i = 0; i < mSize; i++)
-		{
-			if (mData.v[i] == value)
-			{
-				return i;
-			}
-		}
-
-		//if here, did not find it
-		return mSize;
+		return FindInRange(mData.v, mSize, value);
 	}
 
 	size_t Datum::Find(const glm::mat4& value) const
 	{
 		TypeCheck(DatumType::Matrix);
-		for (size_t i = 0; i < mSize; i++)
-		{
-			if (mData.m[i] == value)
-			{
-				return i;
-			}
-		}
-
-		//if here, did not find it
-		return mSize;
+		return FindInRange(mData.m, mSize, value);
 	}
 
 	size_t Datum::Find(const Scope& value) const
@@ -547,16 +1210,7 @@ namespace Library
 	size_t Datum::Find(const std::string& value) const
 	{
 		TypeCheck(DatumType::String);
-		for (size_t i = 0; i < mSize; i++)
-		{
-			if (mData.s[i] == value)
-			{
-				return i;
-			}
-		}
-
-		//if here, did not find it
-		return mSize;
+		return FindInRange(mData.s, mSize, value);
 	}
 
 	size_t Datum::Find(RTTI* value) const
@@ -574,39 +1228,126 @@ namespace Library
 		return mSize;
 	}
 
+	size_t Datum::Find(bool value) const
+	{
+		TypeCheck(DatumType::Boolean);
+		return FindInRange(mData.b, mSize, value);
+	}
+
+	size_t Datum::Find(std::int64_t value) const
+	{
+		TypeCheck(DatumType::Integer64);
+		return FindInRange(mData.l, mSize, value);
+	}
+
+	size_t Datum::Find(double value) const
+	{
+		TypeCheck(DatumType::Double);
+		return FindInRange(mData.d, mSize, value);
+	}
+
+	size_t Datum::Find(const glm::vec2& value) const
+	{
+		TypeCheck(DatumType::Vector2);
+		return FindInRange(mData.v2, mSize, value);
+	}
+
+	size_t Datum::Find(const glm::vec3& value) const
+	{
+		TypeCheck(DatumType::Vector3);
+		return FindInRange(mData.v3, mSize, value);
+	}
+
+	size_t Datum::Find(const glm::quat& value) const
+	{
+		TypeCheck(DatumType::Quaternion);
+		return FindInRange(mData.q, mSize, value);
+	}
+
 	bool Datum::RemoveAt(size_t index)
 	{
 		ExternalException();
 		if (index >= mSize) { return false; }
+		PrepareWrite();
 		size_t dataToShift = mSize - index - 1;
-		if (mType == DatumType::String) { mData.s[index].~basic_string(); }
-		memmove(mData.byte + (index * DatumSizes[static_cast<int>(mType)]), mData.byte + ((index + 1) * DatumSizes[static_cast<int>(mType)]), dataToShift* DatumSizes[static_cast<int>(mType)]);
+		UnlinkScopes(index, index + 1);
+		DestructElements(index, index + 1);
+		memmove(mData.byte + (index * ElementSize()), mData.byte + ((index + 1) * ElementSize()), dataToShift* ElementSize());
+		mSize--;
+		RelinkScopes(this, index, mSize);	//every later child shifted down a slot
+		return true;
+	}
+
+	bool Datum::RemoveAtUnordered(size_t index)
+	{
+		ExternalException();
+		if (index >= mSize) { return false; }
+		PrepareWrite();
+		UnlinkScopes(index, index + 1);
+		DestructElements(index, index + 1);
+		size_t last = mSize - 1;
+		if (index != last)
+		{
+			//relocate the last element into the hole bytewise, the same way RemoveAt shifts
+			memcpy(mData.byte + (index * ElementSize()), mData.byte + (last * ElementSize()), ElementSize());
+		}
 		mSize--;
+		RelinkScopes(this, index, std::min(index + 1, mSize));	//only the last child moved
 		return true;
 	}
 
+	void Datum::RelinkScopes(const Datum* previous, size_t begin, size_t end) noexcept
+	{
+		if (mType != DatumType::Table) { return; }
+		for (size_t i = begin; i < end; ++i)
+		{
+			Scope* scope = mData.t[i];
+			if (scope != nullptr && scope->mParentDatum == previous)
+			{
+				scope->mParentDatum = this;
+				scope->mParentIndex = i;
+			}
+		}
+	}
+
+	void Datum::UnlinkScopes(size_t begin, size_t end) noexcept
+	{
+		if (mType != DatumType::Table) { return; }
+		for (size_t i = begin; i < end; ++i)
+		{
+			Scope* scope = mData.t[i];
+			if (scope != nullptr && scope->mParentDatum == this)
+			{
+				scope->mParentDatum = nullptr;
+			}
+		}
+	}
+
 	std::string Datum::ToString(size_t index) const
+	{
+		char buffer[256];
+		size_t length = ToString(buffer, sizeof(buffer), index);
+		if (length <= sizeof(buffer))
+		{
+			return std::string(buffer, length);
+		}
+
+		//didn't fit, now that the length is known format straight into the string
+		std::string str(length, '\0');
+		ToString(&str[0], length, index);
+		return str;
+	}
+
+	size_t Datum::ToString(char* buffer, size_t bufferSize, size_t index) const
 	{
 		CheckTypeHasBeenSet();
 		VerifyIndexInBounds(index);
-		switch (mType)
-		{
-		case DatumType::Integer:
-			return std::to_string(mData.i[index]);
-		case DatumType::Float:
-			return std::to_string(mData.f[index]);
-		case DatumType::Vector:
-			return glm::to_string(mData.v[index]);
-		case DatumType::Matrix:
-			return glm::to_string(mData.m[index]);
-		case DatumType::String:
-			return mData.s[index];
-		case DatumType::Pointer:
-			return mData.p[index]->ToString();
-		default:
-			assert(false);
-		}
-		return ""; //won't do this, used to suppress warning
+		auto toString = Operations().ToString;
+		if (toString == nullptr)
+		{
+			throw std::runtime_error("Datum type cannot be converted to a string");
+		}
+		return toString(mData.byte + (index * ElementSize()), buffer, bufferSize);
 	}
 
 	
@@ -625,9 +1366,131 @@ namespace Library
 			throw std::runtime_error("Cannot make a datum external after it has already been allocated memory");
 		}
 		SetType(type); //will also throw exception if type is already set to something other than type
+		if (!mIsExternal)
+		{
+			ReleaseStorage();	//nothing allocated, but may still hold a share count
+		}
 		mIsExternal = true;
 		mSize = size;
 		mCapacity = size;
 		mData.vo = array;
 	}
+
+	void Datum::CopyElements(const void* source, size_t count)
+	{
+		auto copyConstruct = Operations().CopyConstruct;
+		if (copyConstruct != nullptr)
+		{
+			copyConstruct(mData.vo, source, count);
+		}
+		else if (count > 0)
+		{
+			memcpy(mData.vo, source, count * ElementSize());
+		}
+	}
+
+	void Datum::DetachStorage(size_t capacity, size_t count)
+	{
+		assert(mShareCount != nullptr && count <= std::min(mSize, capacity));
+		void* shared = mData.vo;
+		const size_t sharedSize = mSize;
+		std::atomic<size_t>* sharedCount = mShareCount;
+
+		mShareCount = nullptr;
+		mData.vo = nullptr;
+		mSize = 0;
+		ReallocData(capacity);
+		CopyElements(shared, count);
+		mSize = count;
+		mShareCount = new std::atomic<size_t>(1);	//still copy on write, but the new array is ours alone
+
+		//the other Datums may have let go of the array while this one copied it, whoever lets go last frees it
+		if (--(*sharedCount) == 0)
+		{
+			delete sharedCount;
+			auto destruct = Operations().Destruct;
+			if (destruct != nullptr) { destruct(shared, sharedSize); }
+			free(shared);
+		}
+	}
+
+	void Datum::ReleaseStorage()
+	{
+		if (mShareCount != nullptr)
+		{
+			if (--(*mShareCount) > 0)
+			{
+				//someone else still uses the array, don't destruct it
+				mShareCount = nullptr;
+				mData.vo = nullptr;
+				mSize = 0;
+				mCapacity = 0;
+				return;
+			}
+			delete mShareCount;
+			mShareCount = nullptr;
+		}
+
+		DestructElements(0, mSize);
+		free(mData.vo);
+		mData.vo = nullptr;
+		mSize = 0;
+		mCapacity = 0;
+	}
+
+	size_t Datum::TypeSize(DatumType type)
+	{
+		if (type < DatumType::Begin || type >= DatumType::End || type == DatumType::Table)
+		{
+			throw std::runtime_error("Type has no fixed element size");
+		}
+		return DatumSizes[static_cast<int>(type)];
+	}
+
+	void Datum::ConstructStorage(DatumType type, void* storage, size_t count)
+	{
+		const size_t size = TypeSize(type);
+		auto defaultConstruct = DatumOperations[static_cast<int>(type)].DefaultConstruct;
+		if (defaultConstruct != nullptr)
+		{
+			defaultConstruct(storage, count);
+		}
+		else
+		{
+			memset(storage, 0, count * size);
+		}
+	}
+
+	void Datum::CopyStorage(DatumType type, void* destination, const void* source, size_t count)
+	{
+		const size_t size = TypeSize(type);
+		auto copyConstruct = DatumOperations[static_cast<int>(type)].CopyConstruct;
+		if (copyConstruct != nullptr)
+		{
+			copyConstruct(destination, source, count);
+		}
+		else if (count > 0)
+		{
+			memcpy(destination, source, count * size);
+		}
+	}
+
+	void Datum::DestructStorage(DatumType type, void* storage, size_t count) noexcept
+	{
+		assert(type >= DatumType::Begin && type < DatumType::End);
+		auto destruct = DatumOperations[static_cast<int>(type)].Destruct;
+		if (destruct != nullptr && count > 0)
+		{
+			destruct(storage, count);
+		}
+	}
+
+	void Datum::DestructElements(size_t first, size_t last)
+	{
+		auto destruct = Operations().Destruct;
+		if (destruct != nullptr && first < last)
+		{
+			destruct(mData.byte + (first * ElementSize()), last - first);
+		}
+	}
 }
\ No newline at end of file
@@ -1,7 +1,16 @@
 #pragma once
+#include <cstdint>
+#include <atomic>
 #include <glm/glm.hpp>
+#pragma warning(push)
+#pragma warning(disable:4201)
+#include <glm/gtc/quaternion.hpp>
+#pragma warning(pop)
 #include <string>
+#include <type_traits>
+#include <gsl/gsl>
 #include "RTTI.h"
+#include "ValueType.h"
 
 namespace Library
 {
@@ -15,11 +24,35 @@ namespace Library
 		Table, 
 		String,
 		Pointer,
+		Boolean,
+		Integer64,
+		Double,
+		Vector2,
+		Vector3,
+		Quaternion,
+		Custom,
 
 		Begin = Integer,
-		End = Pointer
+		End = Custom
 	};
 
+	/// <summary>
+	/// Maps a C++ type to the DatumType that stores it. Types without a built in DatumType are Custom value types (see ValueType).
+	/// </summary>
+	template<typename T> struct DatumTypeOf : std::integral_constant<DatumType, DatumType::Custom> {};
+	template<> struct DatumTypeOf<int> : std::integral_constant<DatumType, DatumType::Integer> {};
+	template<> struct DatumTypeOf<float> : std::integral_constant<DatumType, DatumType::Float> {};
+	template<> struct DatumTypeOf<glm::vec4> : std::integral_constant<DatumType, DatumType::Vector> {};
+	template<> struct DatumTypeOf<glm::mat4> : std::integral_constant<DatumType, DatumType::Matrix> {};
+	template<> struct DatumTypeOf<std::string> : std::integral_constant<DatumType, DatumType::String> {};
+	template<> struct DatumTypeOf<RTTI*> : std::integral_constant<DatumType, DatumType::Pointer> {};
+	template<> struct DatumTypeOf<bool> : std::integral_constant<DatumType, DatumType::Boolean> {};
+	template<> struct DatumTypeOf<std::int64_t> : std::integral_constant<DatumType, DatumType::Integer64> {};
+	template<> struct DatumTypeOf<double> : std::integral_constant<DatumType, DatumType::Double> {};
+	template<> struct DatumTypeOf<glm::vec2> : std::integral_constant<DatumType, DatumType::Vector2> {};
+	template<> struct DatumTypeOf<glm::vec3> : std::integral_constant<DatumType, DatumType::Vector3> {};
+	template<> struct DatumTypeOf<glm::quat> : std::integral_constant<DatumType, DatumType::Quaternion> {};
+
 	class Scope; //forward declaration
 	class Attributed; //forward declaration
 
@@ -129,6 +162,69 @@ namespace Library
 		/// <exception cref="std::runtime_error">Throws exception is type is not Unknown or Pointer</exception>
 		Datum& operator=(RTTI* value);
 
+		/// <summary>
+		/// Scalar Assignment Operator:
+		/// Sets the type to Boolean, capacity and size to 1, allocates memory, and sets the first element equal to value
+		/// </summary>
+		/// <param name="value">the value to store in this datum</param>
+		/// <returns>A datum with type Boolean, capacity and size of 1, and contains value</returns>
+		/// <exception cref="std::runtime_error">Throws exception is type is not Unknown or Boolean</exception>
+		Datum& operator=(bool value);
+
+		/// <summary>
+		/// Scalar Assignment Operator:
+		/// Sets the type to Integer64, capacity and size to 1, allocates memory, and sets the first element equal to value
+		/// </summary>
+		/// <param name="value">the value to store in this datum</param>
+		/// <returns>A datum with type Integer64, capacity and size of 1, and contains value</returns>
+		/// <exception cref="std::runtime_error">Throws exception is type is not Unknown or Integer64</exception>
+		Datum& operator=(std::int64_t value);
+
+		/// <summary>
+		/// Scalar Assignment Operator:
+		/// Sets the type to Double, capacity and size to 1, allocates memory, and sets the first element equal to value
+		/// </summary>
+		/// <param name="value">the value to store in this datum</param>
+		/// <returns>A datum with type Double, capacity and size of 1, and contains value</returns>
+		/// <exception cref="std::runtime_error">Throws exception is type is not Unknown or Double</exception>
+		Datum& operator=(double value);
+
+		/// <summary>
+		/// Scalar Assignment Operator:
+		/// Sets the type to Vector2, capacity and size to 1, allocates memory, and sets the first element equal to value
+		/// </summary>
+		/// <param name="value">the value to store in this datum</param>
+		/// <returns>A datum with type Vector2, capacity and size of 1, and contains value</returns>
+		/// <exception cref="std::runtime_error">Throws exception is type is not Unknown or Vector2</exception>
+		Datum& operator=(const glm::vec2& value);
+
+		/// <summary>
+		/// Scalar Assignment Operator:
+		/// Sets the type to Vector3, capacity and size to 1, allocates memory, and sets the first element equal to value
+		/// </summary>
+		/// <param name="value">the value to store in this datum</param>
+		/// <returns>A datum with type Vector3, capacity and size of 1, and contains value</returns>
+		/// <exception cref="std::runtime_error">Throws exception is type is not Unknown or Vector3</exception>
+		Datum& operator=(const glm::vec3& value);
+
+		/// <summary>
+		/// Scalar Assignment Operator:
+		/// Sets the type to Quaternion, capacity and size to 1, allocates memory, and sets the first element equal to value
+		/// </summary>
+		/// <param name="value">the value to store in this datum</param>
+		/// <returns>A datum with type Quaternion, capacity and size of 1, and contains value</returns>
+		/// <exception cref="std::runtime_error">Throws exception is type is not Unknown or Quaternion</exception>
+		Datum& operator=(const glm::quat& value);
+
+		/// <summary>
+		/// Scalar Assignment Operator: same as the std::string overload.
+		/// Without it string literals would convert to bool instead of std::string.
+		/// </summary>
+		/// <param name="value">the value to store in this datum</param>
+		/// <returns>A datum with type String, capacity and size of 1, and contains value</returns>
+		/// <exception cref="std::runtime_error">Throws exception is type is not Unknown or String</exception>
+		Datum& operator=(const char* value);
+
 		/// <summary>
 		/// Comparison, returns true if the type, capacity, size, and contents are equal, false otherwise
 		/// </summary>
@@ -196,6 +292,76 @@ namespace Library
 		/// </returns>
 		bool operator==(RTTI* value) const noexcept;
 
+		/// <summary>
+		/// Treats the datum as a scalar bool and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// True if Datum is scalar and equals value.
+		/// False if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator==(bool value) const noexcept;
+
+		/// <summary>
+		/// Treats the datum as a scalar 64 bit integer and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// True if Datum is scalar and equals value.
+		/// False if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator==(std::int64_t value) const noexcept;
+
+		/// <summary>
+		/// Treats the datum as a scalar double and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// True if Datum is scalar and equals value.
+		/// False if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator==(double value) const noexcept;
+
+		/// <summary>
+		/// Treats the datum as a scalar vec2 and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// True if Datum is scalar and equals value.
+		/// False if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator==(const glm::vec2& value) const noexcept;
+
+		/// <summary>
+		/// Treats the datum as a scalar vec3 and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// True if Datum is scalar and equals value.
+		/// False if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator==(const glm::vec3& value) const noexcept;
+
+		/// <summary>
+		/// Treats the datum as a scalar quaternion and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// True if Datum is scalar and equals value.
+		/// False if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator==(const glm::quat& value) const noexcept;
+
+		/// <summary>
+		/// Treats the datum as a scalar string and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// True if Datum is scalar and equals value.
+		/// False if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator==(const char* value) const noexcept;
+
 		/// <summary>
 		/// Comparison, returns false if the type, capacity, size, and contents are equal, true otherwise
 		/// </summary>
@@ -263,6 +429,97 @@ namespace Library
 		/// </returns>
 		bool operator!=(RTTI* value) const noexcept;
 
+		/// <summary>
+		/// Treats the datum as a scalar bool and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// False if Datum is scalar and equals value.
+		/// True if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator!=(bool value) const noexcept;
+
+		/// <summary>
+		/// Treats the datum as a scalar 64 bit integer and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// False if Datum is scalar and equals value.
+		/// True if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator!=(std::int64_t value) const noexcept;
+
+		/// <summary>
+		/// Treats the datum as a scalar double and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// False if Datum is scalar and equals value.
+		/// True if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator!=(double value) const noexcept;
+
+		/// <summary>
+		/// Treats the datum as a scalar vec2 and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// False if Datum is scalar and equals value.
+		/// True if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator!=(const glm::vec2& value) const noexcept;
+
+		/// <summary>
+		/// Treats the datum as a scalar vec3 and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// False if Datum is scalar and equals value.
+		/// True if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator!=(const glm::vec3& value) const noexcept;
+
+		/// <summary>
+		/// Treats the datum as a scalar quaternion and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// False if Datum is scalar and equals value.
+		/// True if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator!=(const glm::quat& value) const noexcept;
+
+		/// <summary>
+		/// Treats the datum as a scalar string and compares it to the given value
+		/// </summary>
+		/// <param name="value">the value to compare to</param>
+		/// <returns>
+		/// False if Datum is scalar and equals value.
+		/// True if Datum is not scalar (has more than one element), if Datum is wrong type, or if it does not equal value.
+		/// </returns>
+		bool operator!=(const char* value) const noexcept;
+
+		/// <summary>
+		/// Hashes the type, size and contents of this datum. Datums that are equal have the same hash.
+		/// Tables hash the structure of their child scopes (see Scope::StructuralHash), pointers only contribute their count.
+		/// </summary>
+		/// <returns>A hash of this datum</returns>
+		size_t Hash() const;
+
+		/// <summary>
+		/// Whether this datum has been written since its scope last collected changes. Always false unless change tracking is enabled (see Scope::EnableChangeTracking).
+		/// The mutators (Set, PushBack, RemoveAt, assignment and so on) count. Non-const Get and Span do not, since most callers only read through them:
+		/// writes through the references they return, and writes to external storage that bypass the datum (e.g. an Attributed member), are recorded with MarkDirty.
+		/// </summary>
+		/// <returns>True if this datum has changed since its changes were last collected</returns>
+		bool IsDirty() const noexcept;
+
+		/// <summary>
+		/// Records a change the datum cannot see, such as a write through a reference from a non-const Get: marks this datum dirty and tells the scope tracking it.
+		/// Does nothing unless change tracking is enabled.
+		/// </summary>
+		void MarkDirty() noexcept;
+
 		/// <summary>
 		/// Get the type associated with this Datum
 		/// </summary>
@@ -290,6 +547,19 @@ namespace Library
 		/// <exception cref="std::runtime_error">Throws exception if type is already set or if type is invalid</exception>
 		void SetType(const DatumType type);
 
+		/// <summary>
+		/// Set the type of this Datum to Custom, holding elements of the given value type inline
+		/// </summary>
+		/// <param name="valueType">The value type this Datum will hold, see ValueType::Of</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is already set to something else</exception>
+		void SetType(const ValueType& valueType);
+
+		/// <summary>
+		/// Get the value type of a Custom Datum
+		/// </summary>
+		/// <returns>The value type, or nullptr if the Datum is not Custom or its value type has not been set</returns>
+		const ValueType* CustomType() const noexcept;
+
 		/// <summary>
 		/// Allocates memory for capacity elements
 		/// Will not shrink the array. If called with a lower capacity, nothing happens.
@@ -312,6 +582,20 @@ namespace Library
 		/// </summary>
 		void Clear();
 
+		/// <summary>
+		/// Opts this Datum into copy on write storage. Copies of it share its array instead of copying the elements,
+		/// and the first of them to be modified (including through a non const Get or Span) copies the array for itself.
+		/// Meant for large arrays that are copied often but rarely written, e.g. in prototypes and snapshots.
+		/// </summary>
+		/// <exception cref="std::runtime_error">Throws exception if storage is external or type is Table</exception>
+		void EnableSharedStorage();
+
+		/// <summary>
+		/// Whether this Datum's array is currently shared with another Datum
+		/// </summary>
+		/// <returns>True if the array will be copied before the next modification</returns>
+		bool IsStorageShared() const noexcept;
+
 		/// <summary>
 		/// Sets the internal values array to the given array, and the size and capacity to the given number of elements.
 		/// Marks the storage as external
@@ -373,17 +657,132 @@ namespace Library
 		void SetStorage(RTTI** array, size_t size);
 
 		/// <summary>
-		/// Template for Get
+		/// Sets the internal values array to the given array, and the size and capacity to the given number of elements.
+		/// Marks the storage as external
+		/// </summary>
+		/// <param name="array">the external storage array</param>
+		/// <param name="size">the number of elements in the array</param>
+		/// <remarks>Once storage is marked as external, any functions that change size or capacity cannot be called.</remarks>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match, if storage is external, or if memory is already allocated</exception>
+		void SetStorage(bool* array, size_t size);
+
+		/// <summary>
+		/// Sets the internal values array to the given array, and the size and capacity to the given number of elements.
+		/// Marks the storage as external
+		/// </summary>
+		/// <param name="array">the external storage array</param>
+		/// <param name="size">the number of elements in the array</param>
+		/// <remarks>Once storage is marked as external, any functions that change size or capacity cannot be called.</remarks>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match, if storage is external, or if memory is already allocated</exception>
+		void SetStorage(std::int64_t* array, size_t size);
+
+		/// <summary>
+		/// Sets the internal values array to the given array, and the size and capacity to the given number of elements.
+		/// Marks the storage as external
+		/// </summary>
+		/// <param name="array">the external storage array</param>
+		/// <param name="size">the number of elements in the array</param>
+		/// <remarks>Once storage is marked as external, any functions that change size or capacity cannot be called.</remarks>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match, if storage is external, or if memory is already allocated</exception>
+		void SetStorage(double* array, size_t size);
+
+		/// <summary>
+		/// Sets the internal values array to the given array, and the size and capacity to the given number of elements.
+		/// Marks the storage as external
+		/// </summary>
+		/// <param name="array">the external storage array</param>
+		/// <param name="size">the number of elements in the array</param>
+		/// <remarks>Once storage is marked as external, any functions that change size or capacity cannot be called.</remarks>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match, if storage is external, or if memory is already allocated</exception>
+		void SetStorage(glm::vec2* array, size_t size);
+
+		/// <summary>
+		/// Sets the internal values array to the given array, and the size and capacity to the given number of elements.
+		/// Marks the storage as external
+		/// </summary>
+		/// <param name="array">the external storage array</param>
+		/// <param name="size">the number of elements in the array</param>
+		/// <remarks>Once storage is marked as external, any functions that change size or capacity cannot be called.</remarks>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match, if storage is external, or if memory is already allocated</exception>
+		void SetStorage(glm::vec3* array, size_t size);
+
+		/// <summary>
+		/// Sets the internal values array to the given array, and the size and capacity to the given number of elements.
+		/// Marks the storage as external
+		/// </summary>
+		/// <param name="array">the external storage array</param>
+		/// <param name="size">the number of elements in the array</param>
+		/// <remarks>Once storage is marked as external, any functions that change size or capacity cannot be called.</remarks>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match, if storage is external, or if memory is already allocated</exception>
+		void SetStorage(glm::quat* array, size_t size);
+
+		/// <summary>
+		/// Gets the size of one element of a built in type, e.g. to lay out external storage for it
+		/// </summary>
+		/// <param name="type">a built in type other than Table</param>
+		/// <returns>The size of one element in bytes</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is Unknown, Table or Custom</exception>
+		static size_t TypeSize(DatumType type);
+
+		/// <summary>
+		/// Default constructs elements of a built in type in raw memory, so it can be handed to SetStorage
+		/// </summary>
+		/// <param name="type">a built in type other than Table</param>
+		/// <param name="storage">memory for count elements, suitably aligned</param>
+		/// <param name="count">the number of elements to construct</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is Unknown, Table or Custom</exception>
+		static void ConstructStorage(DatumType type, void* storage, size_t count);
+
+		/// <summary>
+		/// Copy constructs elements of a built in type in raw memory from another array of them
 		/// </summary>
+		/// <param name="type">a built in type other than Table</param>
+		/// <param name="destination">memory for count elements, suitably aligned</param>
+		/// <param name="source">the elements to copy</param>
+		/// <param name="count">the number of elements to copy</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is Unknown, Table or Custom</exception>
+		static void CopyStorage(DatumType type, void* destination, const void* source, size_t count);
+
+		/// <summary>
+		/// Destructs elements constructed by ConstructStorage or CopyStorage, without freeing their memory
+		/// </summary>
+		/// <param name="type">the type the elements were constructed as</param>
+		/// <param name="storage">the elements to destruct</param>
+		/// <param name="count">the number of elements to destruct</param>
+		static void DestructStorage(DatumType type, void* storage, size_t count) noexcept;
+
+		/// <summary>
+		/// Gets the value type element at index. Built in types use the specializations below.
+		/// </summary>
+		/// <returns>The element at the given index</returns>
+		/// <exception cref="std::runtime_error">Throws exception if the Datum does not hold T or if index is out of bounds</exception>
 		template<typename T>
 		T& Get(size_t index = 0);
 
 		/// <summary>
-		/// Template for get (const)
+		/// Gets the value type element at index (const). Built in types use the specializations below.
 		/// </summary>
+		/// <returns>The element at the given index</returns>
+		/// <exception cref="std::runtime_error">Throws exception if the Datum does not hold T or if index is out of bounds</exception>
 		template<typename T>
 		const T& Get(size_t index = 0) const;
 
+		/// <summary>
+		/// Gets all elements as a contiguous span. Works for built in types and value types.
+		/// </summary>
+		/// <returns>A span over the Size() elements of this Datum</returns>
+		/// <exception cref="std::runtime_error">Throws exception if the Datum does not hold T</exception>
+		template<typename T>
+		gsl::span<T> Span();
+
+		/// <summary>
+		/// Gets all elements as a contiguous span (const). Works for built in types and value types.
+		/// </summary>
+		/// <returns>A span over the Size() elements of this Datum</returns>
+		/// <exception cref="std::runtime_error">Throws exception if the Datum does not hold T</exception>
+		template<typename T>
+		gsl::span<const T> Span() const;
+
 		/// <summary>
 		/// Gets integer at index
 		/// </summary>
@@ -497,19 +896,115 @@ namespace Library
 		RTTI* const& Get<RTTI*>(size_t index) const;
 
 		/// <summary>
-		/// Sets the element at the given index to the given value
+		/// Gets bool at index
 		/// </summary>
-		/// <param name="value">the value to put in the datum</param>
-		/// <param name="index">the location to put the value</param>
-		/// <exception cref="std::runtime_error">Throws exception if type is not integer or if index is out of bounds</exception>
-		void Set(int value, size_t index = 0);
+		/// <returns>The bool at the given index</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not boolean or if index is out of bounds</exception>
+		template<>
+		bool& Get<bool>(size_t index);
 
 		/// <summary>
-		/// Sets the element at the given index to the given value
+		/// Gets bool at index (const)
 		/// </summary>
-		/// <param name="value">the value to put in the datum</param>
-		/// <param name="index">the location to put the value</param>
-		/// <exception cref="std::runtime_error">Throws exception if type is not float or if index is out of bounds</exception>
+		/// <returns>The bool at the given index (const)</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not boolean or if index is out of bounds</exception>
+		template<>
+		const bool& Get<bool>(size_t index) const;
+
+		/// <summary>
+		/// Gets 64 bit integer at index
+		/// </summary>
+		/// <returns>The 64 bit integer at the given index</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not integer64 or if index is out of bounds</exception>
+		template<>
+		std::int64_t& Get<std::int64_t>(size_t index);
+
+		/// <summary>
+		/// Gets 64 bit integer at index (const)
+		/// </summary>
+		/// <returns>The 64 bit integer at the given index (const)</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not integer64 or if index is out of bounds</exception>
+		template<>
+		const std::int64_t& Get<std::int64_t>(size_t index) const;
+
+		/// <summary>
+		/// Gets double at index
+		/// </summary>
+		/// <returns>The double at the given index</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not double or if index is out of bounds</exception>
+		template<>
+		double& Get<double>(size_t index);
+
+		/// <summary>
+		/// Gets double at index (const)
+		/// </summary>
+		/// <returns>The double at the given index (const)</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not double or if index is out of bounds</exception>
+		template<>
+		const double& Get<double>(size_t index) const;
+
+		/// <summary>
+		/// Gets vec2 at index
+		/// </summary>
+		/// <returns>The vec2 at the given index</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not vector2 or if index is out of bounds</exception>
+		template<>
+		glm::vec2& Get<glm::vec2>(size_t index);
+
+		/// <summary>
+		/// Gets vec2 at index (const)
+		/// </summary>
+		/// <returns>The vec2 at the given index (const)</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not vector2 or if index is out of bounds</exception>
+		template<>
+		const glm::vec2& Get<glm::vec2>(size_t index) const;
+
+		/// <summary>
+		/// Gets vec3 at index
+		/// </summary>
+		/// <returns>The vec3 at the given index</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not vector3 or if index is out of bounds</exception>
+		template<>
+		glm::vec3& Get<glm::vec3>(size_t index);
+
+		/// <summary>
+		/// Gets vec3 at index (const)
+		/// </summary>
+		/// <returns>The vec3 at the given index (const)</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not vector3 or if index is out of bounds</exception>
+		template<>
+		const glm::vec3& Get<glm::vec3>(size_t index) const;
+
+		/// <summary>
+		/// Gets quaternion at index
+		/// </summary>
+		/// <returns>The quaternion at the given index</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not quaternion or if index is out of bounds</exception>
+		template<>
+		glm::quat& Get<glm::quat>(size_t index);
+
+		/// <summary>
+		/// Gets quaternion at index (const)
+		/// </summary>
+		/// <returns>The quaternion at the given index (const)</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not quaternion or if index is out of bounds</exception>
+		template<>
+		const glm::quat& Get<glm::quat>(size_t index) const;
+
+		/// <summary>
+		/// Sets the element at the given index to the given value
+		/// </summary>
+		/// <param name="value">the value to put in the datum</param>
+		/// <param name="index">the location to put the value</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not integer or if index is out of bounds</exception>
+		void Set(int value, size_t index = 0);
+
+		/// <summary>
+		/// Sets the element at the given index to the given value
+		/// </summary>
+		/// <param name="value">the value to put in the datum</param>
+		/// <param name="index">the location to put the value</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not float or if index is out of bounds</exception>
 		void Set(float value, size_t index = 0);
 
 		/// <summary>
@@ -544,6 +1039,71 @@ namespace Library
 		/// <exception cref="std::runtime_error">Throws exception if type is not pointer or if index is out of bounds</exception>
 		void Set(RTTI* value, size_t index = 0);
 
+		/// <summary>
+		/// Sets the element at the given index to the given value type value
+		/// </summary>
+		/// <param name="value">the value to put in the datum</param>
+		/// <param name="index">the location to put the value</param>
+		/// <exception cref="std::runtime_error">Throws exception if the Datum does not hold T or if index is out of bounds</exception>
+		template<typename T, std::enable_if_t<std::is_class<T>::value && std::is_trivially_copyable<T>::value, int> = 0>
+		void Set(const T& value, size_t index = 0);
+
+		/// <summary>
+		/// Sets the element at the given index to the given value
+		/// </summary>
+		/// <param name="value">the value to put in the datum</param>
+		/// <param name="index">the location to put the value</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not boolean or if index is out of bounds</exception>
+		void Set(bool value, size_t index = 0);
+
+		/// <summary>
+		/// Sets the element at the given index to the given value
+		/// </summary>
+		/// <param name="value">the value to put in the datum</param>
+		/// <param name="index">the location to put the value</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not integer64 or if index is out of bounds</exception>
+		void Set(std::int64_t value, size_t index = 0);
+
+		/// <summary>
+		/// Sets the element at the given index to the given value
+		/// </summary>
+		/// <param name="value">the value to put in the datum</param>
+		/// <param name="index">the location to put the value</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not double or if index is out of bounds</exception>
+		void Set(double value, size_t index = 0);
+
+		/// <summary>
+		/// Sets the element at the given index to the given value
+		/// </summary>
+		/// <param name="value">the value to put in the datum</param>
+		/// <param name="index">the location to put the value</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not vector2 or if index is out of bounds</exception>
+		void Set(const glm::vec2& value, size_t index = 0);
+
+		/// <summary>
+		/// Sets the element at the given index to the given value
+		/// </summary>
+		/// <param name="value">the value to put in the datum</param>
+		/// <param name="index">the location to put the value</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not vector3 or if index is out of bounds</exception>
+		void Set(const glm::vec3& value, size_t index = 0);
+
+		/// <summary>
+		/// Sets the element at the given index to the given value
+		/// </summary>
+		/// <param name="value">the value to put in the datum</param>
+		/// <param name="index">the location to put the value</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not quaternion or if index is out of bounds</exception>
+		void Set(const glm::quat& value, size_t index = 0);
+
+		/// <summary>
+		/// Sets the element at the given index to the given value
+		/// </summary>
+		/// <param name="value">the value to put in the datum</param>
+		/// <param name="index">the location to put the value</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not string or if index is out of bounds</exception>
+		void Set(const char* value, size_t index = 0);
+
 		/// <summary>
 		/// Push the given data into the array.
 		/// If datum is full, increases the capacity
@@ -604,6 +1164,87 @@ namespace Library
 		/// <remarks>If datum's type is not set, it will set the datums type to pointer</remarks>
 		void PushBack(RTTI* data);
 
+		/// <summary>
+		/// Push the given data into the array.
+		/// If datum is full, increases the capacity
+		/// Increment function: Add half the current capacity + 1 each capacity increment
+		/// </summary>
+		/// <param name="data">the data to push into the datum</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not boolean or unknown</exception>
+		/// <remarks>If datum's type is not set, it will set the datums type to boolean</remarks>
+		void PushBack(bool data);
+
+		/// <summary>
+		/// Push the given data into the array.
+		/// If datum is full, increases the capacity
+		/// Increment function: Add half the current capacity + 1 each capacity increment
+		/// </summary>
+		/// <param name="data">the data to push into the datum</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not integer64 or unknown</exception>
+		/// <remarks>If datum's type is not set, it will set the datums type to integer64</remarks>
+		void PushBack(std::int64_t data);
+
+		/// <summary>
+		/// Push the given data into the array.
+		/// If datum is full, increases the capacity
+		/// Increment function: Add half the current capacity + 1 each capacity increment
+		/// </summary>
+		/// <param name="data">the data to push into the datum</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not double or unknown</exception>
+		/// <remarks>If datum's type is not set, it will set the datums type to double</remarks>
+		void PushBack(double data);
+
+		/// <summary>
+		/// Push the given data into the array.
+		/// If datum is full, increases the capacity
+		/// Increment function: Add half the current capacity + 1 each capacity increment
+		/// </summary>
+		/// <param name="data">the data to push into the datum</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not vector2 or unknown</exception>
+		/// <remarks>If datum's type is not set, it will set the datums type to vector2</remarks>
+		void PushBack(const glm::vec2& data);
+
+		/// <summary>
+		/// Push the given data into the array.
+		/// If datum is full, increases the capacity
+		/// Increment function: Add half the current capacity + 1 each capacity increment
+		/// </summary>
+		/// <param name="data">the data to push into the datum</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not vector3 or unknown</exception>
+		/// <remarks>If datum's type is not set, it will set the datums type to vector3</remarks>
+		void PushBack(const glm::vec3& data);
+
+		/// <summary>
+		/// Push the given data into the array.
+		/// If datum is full, increases the capacity
+		/// Increment function: Add half the current capacity + 1 each capacity increment
+		/// </summary>
+		/// <param name="data">the data to push into the datum</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not quaternion or unknown</exception>
+		/// <remarks>If datum's type is not set, it will set the datums type to quaternion</remarks>
+		void PushBack(const glm::quat& data);
+
+		/// <summary>
+		/// Push the given data into the array.
+		/// If datum is full, increases the capacity
+		/// Increment function: Add half the current capacity + 1 each capacity increment
+		/// </summary>
+		/// <param name="data">the data to push into the datum</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not string or unknown</exception>
+		/// <remarks>If datum's type is not set, it will set the datums type to string</remarks>
+		void PushBack(const char* data);
+
+		/// <summary>
+		/// Push the given value type data into the array.
+		/// If datum is full, increases the capacity
+		/// Increment function: Add half the current capacity + 1 each capacity increment
+		/// </summary>
+		/// <param name="data">the data to push into the datum</param>
+		/// <exception cref="std::runtime_error">Throws exception if the Datum holds something other than T or is unknown</exception>
+		/// <remarks>If datum's type is not set, it will set the datums type to Custom holding T</remarks>
+		template<typename T, std::enable_if_t<std::is_class<T>::value && std::is_trivially_copyable<T>::value, int> = 0>
+		void PushBack(const T& data);
+
 		/// <summary>
 		/// Removes the last element in the datum without shrinking capacity
 		/// If datum is empty, does nothing
@@ -677,6 +1318,69 @@ namespace Library
 		///  <exception cref="std::runtime_error">Throws exception if type does not match</exception>
 		size_t Find(RTTI* value) const;
 
+		/// <summary>
+		/// Searches for the given value. If found, returns the index. 
+		/// If not found, returns size (an out of bounds index)
+		/// </summary>
+		/// <param name="value">the value to search for</param>
+		/// <returns>The index pointing to value, or Size if value not found</returns>
+		///  <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		size_t Find(bool value) const;
+
+		/// <summary>
+		/// Searches for the given value. If found, returns the index. 
+		/// If not found, returns size (an out of bounds index)
+		/// </summary>
+		/// <param name="value">the value to search for</param>
+		/// <returns>The index pointing to value, or Size if value not found</returns>
+		///  <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		size_t Find(std::int64_t value) const;
+
+		/// <summary>
+		/// Searches for the given value. If found, returns the index. 
+		/// If not found, returns size (an out of bounds index)
+		/// </summary>
+		/// <param name="value">the value to search for</param>
+		/// <returns>The index pointing to value, or Size if value not found</returns>
+		///  <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		size_t Find(double value) const;
+
+		/// <summary>
+		/// Searches for the given value. If found, returns the index. 
+		/// If not found, returns size (an out of bounds index)
+		/// </summary>
+		/// <param name="value">the value to search for</param>
+		/// <returns>The index pointing to value, or Size if value not found</returns>
+		///  <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		size_t Find(const glm::vec2& value) const;
+
+		/// <summary>
+		/// Searches for the given value. If found, returns the index. 
+		/// If not found, returns size (an out of bounds index)
+		/// </summary>
+		/// <param name="value">the value to search for</param>
+		/// <returns>The index pointing to value, or Size if value not found</returns>
+		///  <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		size_t Find(const glm::vec3& value) const;
+
+		/// <summary>
+		/// Searches for the given value. If found, returns the index. 
+		/// If not found, returns size (an out of bounds index)
+		/// </summary>
+		/// <param name="value">the value to search for</param>
+		/// <returns>The index pointing to value, or Size if value not found</returns>
+		///  <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		size_t Find(const glm::quat& value) const;
+
+		/// <summary>
+		/// Searches for the given value. If found, returns the index. 
+		/// If not found, returns size (an out of bounds index)
+		/// </summary>
+		/// <param name="value">the value to search for</param>
+		/// <returns>The index pointing to value, or Size if value not found</returns>
+		///  <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		size_t Find(const char* value) const;
+
 		/// <summary>
 		/// Removes the element at the given index
 		/// </summary>
@@ -693,6 +1397,16 @@ namespace Library
 		/// </remarks>
 		bool RemoveAt(size_t index);
 
+		/// <summary>
+		/// Removes the element at the given index by moving the last element into its place.
+		/// Constant time, but does not preserve the order of the remaining elements.
+		/// </summary>
+		/// <param name="index">the index of the element to remove</param>
+		/// <returns>True if element at index was removed, false if index is out of bounds</returns>
+		/// <exception cref="std::runtime_error">Throws exception if storage is external</exception>
+		/// <remarks>Like RemoveAt, does not orphan a removed child scope. A child scope moved into the hole keeps its back reference to its parent accurate.</remarks>
+		bool RemoveAtUnordered(size_t index);
+
 		/// <summary>
 		/// Searches for and removes given value and returns a bool indicating whether the value was removed.
 		/// </summary>
@@ -741,14 +1455,82 @@ namespace Library
 		/// <exception cref="std::runtime_error">Throws exception if type does not match</exception>
 		bool Remove(RTTI* value);
 
+		/// <summary>
+		/// Searches for and removes given value and returns a bool indicating whether the value was removed.
+		/// </summary>
+		/// <param name="value">the value to remove from datum</param>
+		/// <returns> True if the element at index was removed, False if item does not exist </returns>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		bool Remove(bool value);
+
+		/// <summary>
+		/// Searches for and removes given value and returns a bool indicating whether the value was removed.
+		/// </summary>
+		/// <param name="value">the value to remove from datum</param>
+		/// <returns> True if the element at index was removed, False if item does not exist </returns>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		bool Remove(std::int64_t value);
+
+		/// <summary>
+		/// Searches for and removes given value and returns a bool indicating whether the value was removed.
+		/// </summary>
+		/// <param name="value">the value to remove from datum</param>
+		/// <returns> True if the element at index was removed, False if item does not exist </returns>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		bool Remove(double value);
+
+		/// <summary>
+		/// Searches for and removes given value and returns a bool indicating whether the value was removed.
+		/// </summary>
+		/// <param name="value">the value to remove from datum</param>
+		/// <returns> True if the element at index was removed, False if item does not exist </returns>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		bool Remove(const glm::vec2& value);
+
+		/// <summary>
+		/// Searches for and removes given value and returns a bool indicating whether the value was removed.
+		/// </summary>
+		/// <param name="value">the value to remove from datum</param>
+		/// <returns> True if the element at index was removed, False if item does not exist </returns>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		bool Remove(const glm::vec3& value);
+
+		/// <summary>
+		/// Searches for and removes given value and returns a bool indicating whether the value was removed.
+		/// </summary>
+		/// <param name="value">the value to remove from datum</param>
+		/// <returns> True if the element at index was removed, False if item does not exist </returns>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		bool Remove(const glm::quat& value);
+
+		/// <summary>
+		/// Searches for and removes given value and returns a bool indicating whether the value was removed.
+		/// </summary>
+		/// <param name="value">the value to remove from datum</param>
+		/// <returns> True if the element at index was removed, False if item does not exist </returns>
+		/// <exception cref="std::runtime_error">Throws exception if type does not match</exception>
+		bool Remove(const char* value);
+
 		/// <summary>
 		/// Returns a string representing the data at the given index (default index = 0)
 		/// </summary>
 		/// <param name="index">the index to get the value from</param>
 		/// <returns>A string representing the data at the given index</returns>
-		/// <exception cref="std::runtime_error">Throws exception if type is not set or index is out of bounds</exception>
+		/// <exception cref="std::runtime_error">Throws exception if type is not set, index is out of bounds, or the type has no string form (Table, Custom)</exception>
 		std::string ToString(size_t index = 0) const;
 
+		/// <summary>
+		/// Writes a string representing the data at the given index into a caller supplied buffer, without allocating.
+		/// Numbers are formatted the same way as ToString(index), independent of the current locale.
+		/// The output is not null terminated. If the buffer is too small, only the first bufferSize characters are written.
+		/// </summary>
+		/// <param name="buffer">the buffer to write into</param>
+		/// <param name="bufferSize">the number of characters buffer can hold</param>
+		/// <param name="index">the index to get the value from</param>
+		/// <returns>The length of the full representation, which may be larger than bufferSize</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not set, index is out of bounds, or the type has no string form (Table, Custom)</exception>
+		size_t ToString(char* buffer, size_t bufferSize, size_t index = 0) const;
+
 		void SetFromStringDanger(const std::string& str, size_t index = 0);
 
 		/// <summary>
@@ -802,6 +1584,60 @@ namespace Library
 		template<>
 		void SetFromString<std::string>(const std::string& str, size_t index);
 
+		/// <summary>
+		/// Sets the value at the given index to the value parsed from str 
+		/// </summary>
+		/// <param name="str">the string representing the value to add</param>
+		/// <param name="index">the index to get the value from</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not set or index is out of bounds, string can't be parsed, or type is wrong</exception>
+		template<>
+		void SetFromString<bool>(const std::string& str, size_t index);
+
+		/// <summary>
+		/// Sets the value at the given index to the value parsed from str 
+		/// </summary>
+		/// <param name="str">the string representing the value to add</param>
+		/// <param name="index">the index to get the value from</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not set or index is out of bounds, string can't be parsed, or type is wrong</exception>
+		template<>
+		void SetFromString<std::int64_t>(const std::string& str, size_t index);
+
+		/// <summary>
+		/// Sets the value at the given index to the value parsed from str 
+		/// </summary>
+		/// <param name="str">the string representing the value to add</param>
+		/// <param name="index">the index to get the value from</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not set or index is out of bounds, string can't be parsed, or type is wrong</exception>
+		template<>
+		void SetFromString<double>(const std::string& str, size_t index);
+
+		/// <summary>
+		/// Sets the value at the given index to the value parsed from str 
+		/// </summary>
+		/// <param name="str">the string representing the value to add</param>
+		/// <param name="index">the index to get the value from</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not set or index is out of bounds, string can't be parsed, or type is wrong</exception>
+		template<>
+		void SetFromString<glm::vec2>(const std::string& str, size_t index);
+
+		/// <summary>
+		/// Sets the value at the given index to the value parsed from str 
+		/// </summary>
+		/// <param name="str">the string representing the value to add</param>
+		/// <param name="index">the index to get the value from</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not set or index is out of bounds, string can't be parsed, or type is wrong</exception>
+		template<>
+		void SetFromString<glm::vec3>(const std::string& str, size_t index);
+
+		/// <summary>
+		/// Sets the value at the given index to the value parsed from str 
+		/// </summary>
+		/// <param name="str">the string representing the value to add</param>
+		/// <param name="index">the index to get the value from</param>
+		/// <exception cref="std::runtime_error">Throws exception if type is not set or index is out of bounds, string can't be parsed, or type is wrong</exception>
+		template<>
+		void SetFromString<glm::quat>(const std::string& str, size_t index);
+
 		/// <summary>
 		/// Gets a reference to the scope at the given index
 		/// </summary>
@@ -821,6 +1657,12 @@ namespace Library
 			Scope** t; 
 			std::string* s;
 			RTTI** p;
+			bool* b;
+			std::int64_t* l;
+			double* d;
+			glm::vec2* v2;
+			glm::vec3* v3;
+			glm::quat* q;
 			void* vo;
 			uint8_t* byte;
 		};
@@ -835,14 +1677,44 @@ namespace Library
 			sizeof(glm::mat4),
 			sizeof(Scope*),
 			sizeof(std::string),
-			sizeof(RTTI*)
+			sizeof(RTTI*),
+			sizeof(bool),
+			sizeof(std::int64_t),
+			sizeof(double),
+			sizeof(glm::vec2),
+			sizeof(glm::vec3),
+			sizeof(glm::quat),
+			0 //Custom, see ElementSize
+		};
+
+		/// <summary>
+		/// Per type operations used wherever Datum would otherwise switch on its type.
+		/// A nullptr DefaultConstruct, CopyConstruct, Destruct or Equal means the type is zero initialized, trivially copyable, needs no destruction,
+		/// or can be compared bytewise, and the caller falls back to memset/memcpy/memcmp over the whole array.
+		/// </summary>
+		struct TypeOperations
+		{
+			void (*DefaultConstruct)(void* data, size_t count);
+			void (*CopyConstruct)(void* destination, const void* source, size_t count);
+			void (*Destruct)(void* data, size_t count);
+			bool (*Equal)(const void* lhs, const void* rhs, size_t count);
+			size_t (*ToString)(const void* data, char* buffer, size_t bufferSize);
+			void (Datum::*SetFromString)(const std::string& str, size_t index);
+			size_t (*Hash)(const void* data, size_t count);	//nullptr if the elements can be hashed bytewise
 		};
 
+		//The operations of each kind of data, indexed the same as DatumSizes
+		static const TypeOperations DatumOperations[];
+
 		DatumValues mData;
 		size_t mSize = 0;
 		size_t mCapacity = 0;
 		bool mIsExternal = false;
 		DatumType mType = DatumType::Unknown;
+		const ValueType* mValueType = nullptr;
+		std::atomic<size_t>* mShareCount = nullptr;	//number of Datums sharing mData, nullptr unless EnableSharedStorage has been called. Atomic so copies on different threads can share an array.
+		Scope* mOwner = nullptr;	//the scope tracking changes to this datum, nullptr unless change tracking is enabled. Not copied.
+		std::atomic<bool> mIsDirty{ false };	//changed since the owner last collected changes. Atomic like Scope::mHasChanges, visitors of a parallel traversal may all mark a datum they share.
 
 		/// <summary>
 		/// Helper for AttributedScope. Type must be set before calling this. 
@@ -884,10 +1756,63 @@ namespace Library
 		/************************************************************************/
 		/// <summary>
 		/// Reallocs data (uses mType to decide size of elements) and sets Capacity
+		/// If the array is shared, copies the elements that fit into a new array instead
 		/// </summary>
 		/// <param name="capacity">The capacity to realloc data for</param>
 		void ReallocData(size_t capacity);
 
+		/// <summary>
+		/// Called before anything that can change the elements:
+		/// copies the array if it is shared with another Datum, so it can be modified, and records the change if changes are tracked
+		/// </summary>
+		void PrepareWrite();
+
+		/// <summary>
+		/// Called before handing out a reference the elements can be written through: copies the array if it is shared with another Datum,
+		/// so a write through the reference does not change the other sharers. Does not record a change (see MarkDirty), but drops the owner's cached
+		/// structural hash, which a write through the reference could make stale.
+		/// </summary>
+		void PrepareReference();
+
+		/// <summary>
+		/// Drops the cached structural hash of mOwner and its ancestors
+		/// </summary>
+		void InvalidateOwnerHash() noexcept;
+
+		/// <summary>
+		/// Propagates a change to mOwner and its ancestors: drops their cached structural hashes on every write, and flags them as having changes on the first
+		/// </summary>
+		void NotifyOwner() noexcept;
+
+		/// <summary>
+		/// Stops sharing the array: copies the first count elements into a new array with the given capacity
+		/// </summary>
+		/// <param name="capacity">The capacity of the new array</param>
+		/// <param name="count">The number of elements to copy, at most the size and the capacity</param>
+		void DetachStorage(size_t capacity, size_t count);
+
+		/// <summary>
+		/// Destructs and frees the internal array, or just drops this Datum's reference to it if it is shared
+		/// </summary>
+		void ReleaseStorage();
+
+		/// <summary>
+		/// Points the back reference (see Scope::Orphan) of each child scope in [begin, end) at its new place, after it moved here from previous or to another index here.
+		/// Only children whose back reference names previous are updated: a scope placed in a datum by anything but its parent keeps the one its parent gave it.
+		/// Clearing or destroying a datum leaves back references alone, a parent detaches its children first and a foreign datum's pointers may already dangle.
+		/// </summary>
+		/// <param name="previous">the datum the children were in, this datum if they only changed index</param>
+		/// <param name="begin">the index of the first moved child</param>
+		/// <param name="end">one past the index of the last moved child</param>
+		void RelinkScopes(const Datum* previous, size_t begin, size_t end) noexcept;
+
+		/// <summary>
+		/// Clears the back reference of each child scope in [begin, end) that names this datum, before they are removed from it
+		/// </summary>
+		/// <param name="begin">the index of the first removed child</param>
+		/// <param name="end">one past the index of the last removed child</param>
+		void UnlinkScopes(size_t begin, size_t end) noexcept;
+
 		/// <summary>
 		/// Throws exception if datum is not type specified
 		/// </summary>
@@ -931,6 +1856,17 @@ namespace Library
 		void SetStorageHelper(void* array, DatumType type, size_t size);
 
 		void ExternalException();
+
+		const TypeOperations& Operations() const;
+
+		size_t ElementSize() const;
+
+		template<typename T>
+		void TypeCheck() const;
+
+		void CopyElements(const void* source, size_t count);
+
+		void DestructElements(size_t first, size_t last);
 	};
 }
 
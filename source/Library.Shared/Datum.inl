@@ -41,6 +41,41 @@ namespace Library
 		return (mType == DatumType::Pointer && mSize == 1 && mData.p != nullptr && mData.p[0]->Equals(value));
 	}
 
+	inline bool Datum::operator==(bool value) const noexcept
+	{
+		return (mType == DatumType::Boolean && mSize == 1 && mData.b[0] == value);
+	}
+
+	inline bool Datum::operator==(std::int64_t value) const noexcept
+	{
+		return (mType == DatumType::Integer64 && mSize == 1 && mData.l[0] == value);
+	}
+
+	inline bool Datum::operator==(double value) const noexcept
+	{
+		return (mType == DatumType::Double && mSize == 1 && mData.d[0] == value);
+	}
+
+	inline bool Datum::operator==(const glm::vec2& value) const noexcept
+	{
+		return (mType == DatumType::Vector2 && mSize == 1 && mData.v2[0] == value);
+	}
+
+	inline bool Datum::operator==(const glm::vec3& value) const noexcept
+	{
+		return (mType == DatumType::Vector3 && mSize == 1 && mData.v3[0] == value);
+	}
+
+	inline bool Datum::operator==(const glm::quat& value) const noexcept
+	{
+		return (mType == DatumType::Quaternion && mSize == 1 && mData.q[0] == value);
+	}
+
+	inline bool Datum::operator==(const char* value) const noexcept
+	{
+		return (mType == DatumType::String && mSize == 1 && mData.s[0] == value);
+	}
+
 	inline bool Datum::operator!=(const Datum& rhs) const noexcept
 	{
 		return !operator==(rhs);
@@ -76,6 +111,41 @@ namespace Library
 		return !operator==(value);
 	}
 
+	inline bool Datum::operator!=(bool value) const noexcept
+	{
+		return !operator==(value);
+	}
+
+	inline bool Datum::operator!=(std::int64_t value) const noexcept
+	{
+		return !operator==(value);
+	}
+
+	inline bool Datum::operator!=(double value) const noexcept
+	{
+		return !operator==(value);
+	}
+
+	inline bool Datum::operator!=(const glm::vec2& value) const noexcept
+	{
+		return !operator==(value);
+	}
+
+	inline bool Datum::operator!=(const glm::vec3& value) const noexcept
+	{
+		return !operator==(value);
+	}
+
+	inline bool Datum::operator!=(const glm::quat& value) const noexcept
+	{
+		return !operator==(value);
+	}
+
+	inline bool Datum::operator!=(const char* value) const noexcept
+	{
+		return !operator==(value);
+	}
+
 	inline DatumType Datum::Type() const noexcept
 	{
 		return mType;
@@ -102,6 +172,16 @@ namespace Library
 		mType = type;
 	}
 
+	inline const ValueType* Datum::CustomType() const noexcept
+	{
+		return mValueType;
+	}
+
+	inline bool Datum::IsStorageShared() const noexcept
+	{
+		return (mShareCount != nullptr && *mShareCount > 1);
+	}
+
 	inline void Datum::SetStorage(int* array, size_t size)
 	{
 		SetStorageHelper(reinterpret_cast<void*>(array), DatumType::Integer, size);
@@ -132,24 +212,108 @@ namespace Library
 		SetStorageHelper(reinterpret_cast<void*>(array), DatumType::Pointer, size);
 	}
 
+	inline void Datum::SetStorage(bool* array, size_t size)
+	{
+		SetStorageHelper(reinterpret_cast<void*>(array), DatumType::Boolean, size);
+	}
+
+	inline void Datum::SetStorage(std::int64_t* array, size_t size)
+	{
+		SetStorageHelper(reinterpret_cast<void*>(array), DatumType::Integer64, size);
+	}
+
+	inline void Datum::SetStorage(double* array, size_t size)
+	{
+		SetStorageHelper(reinterpret_cast<void*>(array), DatumType::Double, size);
+	}
+
+	inline void Datum::SetStorage(glm::vec2* array, size_t size)
+	{
+		SetStorageHelper(reinterpret_cast<void*>(array), DatumType::Vector2, size);
+	}
+
+	inline void Datum::SetStorage(glm::vec3* array, size_t size)
+	{
+		SetStorageHelper(reinterpret_cast<void*>(array), DatumType::Vector3, size);
+	}
+
+	inline void Datum::SetStorage(glm::quat* array, size_t size)
+	{
+		SetStorageHelper(reinterpret_cast<void*>(array), DatumType::Quaternion, size);
+	}
+
 	inline void Datum::SetStorage(void* array, size_t size)
 	{
 		CheckTypeHasBeenSet();
 		SetStorageHelper(array, mType, size);
 	}
 
+	template<typename T>
+	inline T& Datum::Get(size_t index)
+	{
+		TypeCheck<T>();
+		VerifyIndexInBounds(index);
+		PrepareReference();
+		return reinterpret_cast<T*>(mData.vo)[index];
+	}
+
+	template<typename T>
+	inline const T& Datum::Get(size_t index) const
+	{
+		TypeCheck<T>();
+		VerifyIndexInBounds(index);
+		return reinterpret_cast<const T*>(mData.vo)[index];
+	}
+
+	template<typename T>
+	inline gsl::span<T> Datum::Span()
+	{
+		TypeCheck<T>();
+		PrepareReference();
+		return gsl::span<T>(reinterpret_cast<T*>(mData.vo), mSize);
+	}
+
+	template<typename T>
+	inline gsl::span<const T> Datum::Span() const
+	{
+		TypeCheck<T>();
+		return gsl::span<const T>(reinterpret_cast<const T*>(mData.vo), mSize);
+	}
+
+	template<typename T, std::enable_if_t<std::is_class<T>::value && std::is_trivially_copyable<T>::value, int>>
+	inline void Datum::Set(const T& value, size_t index)
+	{
+		TypeCheck<T>();
+		VerifyIndexInBounds(index);
+		PrepareWrite();
+		reinterpret_cast<T*>(mData.vo)[index] = value;
+	}
+
+	template<typename T, std::enable_if_t<std::is_class<T>::value && std::is_trivially_copyable<T>::value, int>>
+	inline void Datum::PushBack(const T& data)
+	{
+		SetType(ValueType::Of<T>());	//will throw exception if datum has a type other than T or unknown
+		ExternalException();
+		IncrementCapacityIfFull();
+		reinterpret_cast<T*>(mData.vo)[mSize] = data;
+		mSize++;
+	}
+
 	template<>
 	inline int& Datum::Get<int>(size_t index)
 	{
 		TypeCheck(DatumType::Integer);
 		VerifyIndexInBounds(index);
+		PrepareReference();
 		return mData.i[index];
 	}
 
 	template<>
 	inline const int& Datum::Get<int>(size_t index) const
 	{
-		return (const_cast<Datum*>(this))->Get<int>(index);
+		TypeCheck(DatumType::Integer);
+		VerifyIndexInBounds(index);
+		return mData.i[index];
 	}
 
 	template<>
@@ -157,13 +321,16 @@ namespace Library
 	{
 		TypeCheck(DatumType::Float);
 		VerifyIndexInBounds(index);
+		PrepareReference();
 		return mData.f[index];
 	}
 
 	template<>
 	inline const float& Datum::Get<float>(size_t index) const
 	{
-		return (const_cast<Datum*>(this))->Get<float>(index);
+		TypeCheck(DatumType::Float);
+		VerifyIndexInBounds(index);
+		return mData.f[index];
 	}
 
 	template<>
@@ -171,13 +338,16 @@ namespace Library
 	{
 		TypeCheck(DatumType::Vector);
 		VerifyIndexInBounds(index);
+		PrepareReference();
 		return mData.v[index];
 	}
 
 	template<>
 	inline const glm::vec4& Datum::Get<glm::vec4>(size_t index) const
 	{
-		return (const_cast<Datum*>(this))->Get<glm::vec4>(index);
+		TypeCheck(DatumType::Vector);
+		VerifyIndexInBounds(index);
+		return mData.v[index];
 	}
 
 	template<>
@@ -185,18 +355,22 @@ namespace Library
 	{
 		TypeCheck(DatumType::Matrix);
 		VerifyIndexInBounds(index);
+		PrepareReference();
 		return mData.m[index];
 	}
 
 	template<>
 	inline const glm::mat4& Datum::Get<glm::mat4>(size_t index) const
 	{
-		return (const_cast<Datum*>(this))->Get<glm::mat4>(index);
+		TypeCheck(DatumType::Matrix);
+		VerifyIndexInBounds(index);
+		return mData.m[index];
 	}
 
 	template<>
 	inline Scope& Datum::Get<Scope>(size_t index)
 	{
+		//no PrepareWrite: the reference lets the scope change but not which scope is stored, and tables are never shared
 		TypeCheck(DatumType::Table);
 		VerifyIndexInBounds(index);
 		return *(mData.t[index]);
@@ -205,7 +379,9 @@ namespace Library
 	template<>
 	const Scope& Datum::Get<Scope>(size_t index) const
 	{
-		return (const_cast<Datum*>(this))->Get<Scope&>(index);
+		TypeCheck(DatumType::Table);
+		VerifyIndexInBounds(index);
+		return *(mData.t[index]);
 	}
 
 	template<>
@@ -213,13 +389,16 @@ namespace Library
 	{
 		TypeCheck(DatumType::String);
 		VerifyIndexInBounds(index);
+		PrepareReference();
 		return mData.s[index];
 	}
 
 	template<>
 	inline const std::string& Datum::Get<std::string>(size_t index) const
 	{
-		return (const_cast<Datum*>(this))->Get<std::string>(index);
+		TypeCheck(DatumType::String);
+		VerifyIndexInBounds(index);
+		return mData.s[index];
 	}
 
 	template<>
@@ -227,13 +406,118 @@ namespace Library
 	{
 		TypeCheck(DatumType::Pointer);
 		VerifyIndexInBounds(index);
+		PrepareReference();
 		return mData.p[index];
 	}
 
 	template<>
 	RTTI* const& Datum::Get<RTTI*>(size_t index) const
 	{
-		return (const_cast<Datum*>(this))->Get<RTTI*>(index);
+		TypeCheck(DatumType::Pointer);
+		VerifyIndexInBounds(index);
+		return mData.p[index];
+	}
+
+	template<>
+	inline bool& Datum::Get<bool>(size_t index)
+	{
+		TypeCheck(DatumType::Boolean);
+		VerifyIndexInBounds(index);
+		PrepareReference();
+		return mData.b[index];
+	}
+
+	template<>
+	inline const bool& Datum::Get<bool>(size_t index) const
+	{
+		TypeCheck(DatumType::Boolean);
+		VerifyIndexInBounds(index);
+		return mData.b[index];
+	}
+
+	template<>
+	inline std::int64_t& Datum::Get<std::int64_t>(size_t index)
+	{
+		TypeCheck(DatumType::Integer64);
+		VerifyIndexInBounds(index);
+		PrepareReference();
+		return mData.l[index];
+	}
+
+	template<>
+	inline const std::int64_t& Datum::Get<std::int64_t>(size_t index) const
+	{
+		TypeCheck(DatumType::Integer64);
+		VerifyIndexInBounds(index);
+		return mData.l[index];
+	}
+
+	template<>
+	inline double& Datum::Get<double>(size_t index)
+	{
+		TypeCheck(DatumType::Double);
+		VerifyIndexInBounds(index);
+		PrepareReference();
+		return mData.d[index];
+	}
+
+	template<>
+	inline const double& Datum::Get<double>(size_t index) const
+	{
+		TypeCheck(DatumType::Double);
+		VerifyIndexInBounds(index);
+		return mData.d[index];
+	}
+
+	template<>
+	inline glm::vec2& Datum::Get<glm::vec2>(size_t index)
+	{
+		TypeCheck(DatumType::Vector2);
+		VerifyIndexInBounds(index);
+		PrepareReference();
+		return mData.v2[index];
+	}
+
+	template<>
+	inline const glm::vec2& Datum::Get<glm::vec2>(size_t index) const
+	{
+		TypeCheck(DatumType::Vector2);
+		VerifyIndexInBounds(index);
+		return mData.v2[index];
+	}
+
+	template<>
+	inline glm::vec3& Datum::Get<glm::vec3>(size_t index)
+	{
+		TypeCheck(DatumType::Vector3);
+		VerifyIndexInBounds(index);
+		PrepareReference();
+		return mData.v3[index];
+	}
+
+	template<>
+	inline const glm::vec3& Datum::Get<glm::vec3>(size_t index) const
+	{
+		TypeCheck(DatumType::Vector3);
+		VerifyIndexInBounds(index);
+		return mData.v3[index];
+	}
+
+	template<>
+	inline glm::quat& Datum::Get<glm::quat>(size_t index)
+	{
+		TypeCheck(DatumType::Quaternion);
+		VerifyIndexInBounds(index);
+		PrepareReference();
+		return mData.q[index];
+	}
+
+	template<>
+	inline const glm::quat& Datum::Get<glm::quat>(size_t index) const
+	{
+		TypeCheck(DatumType::Quaternion);
+		VerifyIndexInBounds(index);
+		return mData.q[index];
 	}
 
 	inline bool Datum::Remove(int value)
@@ -272,53 +556,76 @@ namespace Library
 		return RemoveAt(Find(value));
 	}
 
-	
+	inline bool Datum::Remove(bool value)
+	{
+		//will return false if value doesn't exist, will throw exception if type doesn't match
+		return RemoveAt(Find(value));
+	}
 
-	template<>
-	inline void Datum::SetFromString<int>(const std::string& str, size_t index)
+	inline bool Datum::Remove(std::int64_t value)
 	{
-		Set(std::stoi(str, nullptr), index);
+		//will return false if value doesn't exist, will throw exception if type doesn't match
+		return RemoveAt(Find(value));
 	}
 
-	template<>
-	inline void Datum::SetFromString<float>(const std::string& str, size_t index)
+	inline bool Datum::Remove(double value)
 	{
-		Set(std::stof(str, nullptr), index);
+		//will return false if value doesn't exist, will throw exception if type doesn't match
+		return RemoveAt(Find(value));
 	}
 
-	template<>
-	void Datum::SetFromString<glm::vec4>(const std::string& str, size_t index)
+	inline bool Datum::Remove(const glm::vec2& value)
 	{
-		glm::vec4 values;
-		int count = sscanf_s(str.c_str(), "vec4(%f, %f, %f, %f)", &values[0], &values[1], &values[2], &values[3]);
-		if (count != 4)
-		{
-			throw std::runtime_error("invalid string input");
-		}
+		//will return false if value doesn't exist, will throw exception if type doesn't match
+		return RemoveAt(Find(value));
+	}
 
-		Set(values, index);
+	inline bool Datum::Remove(const glm::vec3& value)
+	{
+		//will return false if value doesn't exist, will throw exception if type doesn't match
+		return RemoveAt(Find(value));
 	}
 
-	template<>
-	void Datum::SetFromString<glm::mat4>(const std::string& str, size_t index)
+	inline bool Datum::Remove(const glm::quat& value)
 	{
-		glm::mat4 val;
-		const char* matrixTemplate = "mat4x4((%f, %f, %f, %f), (%f, %f, %f, %f), (%f, %f, %f, %f), (%f, %f, %f, %f))";
-		int count = sscanf_s(str.c_str(), matrixTemplate, &val[0][0], &val[0][1], &val[0][2], &val[0][3], &val[1][0], &val[1][1], &val[1][2], &val[1][3], &val[2][0], &val[2][1], &val[2][2], &val[2][3], &val[3][0], &val[3][1], &val[3][2], &val[3][3]);
-		if (count != 16)
-		{
-			throw std::runtime_error("invalid string input");
-		}
+		//will return false if value doesn't exist, will throw exception if type doesn't match
+		return RemoveAt(Find(value));
+	}
 
-		Set(val, index);
+	inline bool Datum::Remove(const char* value)
+	{
+		//will return false if value doesn't exist, will throw exception if type doesn't match
+		return RemoveAt(Find(value));
 	}
 
+	
+
 	template<>
 	inline void Datum::SetFromString<std::string>(const std::string& str, size_t index)
 	{
 		Set(str,index);
 	}
 
+	inline Datum& Datum::operator=(const char* value)
+	{
+		return operator=(std::string(value));
+	}
+
+	inline void Datum::Set(const char* value, size_t index)
+	{
+		Set(std::string(value), index);
+	}
+
+	inline void Datum::PushBack(const char* data)
+	{
+		PushBack(std::string(data));
+	}
+
+	inline size_t Datum::Find(const char* value) const
+	{
+		return Find(std::string(value));
+	}
+
 	inline Scope& Datum::operator[](size_t index)
 	{
 		return Get<Scope>(index);
@@ -328,6 +635,12 @@ namespace Library
 	/************************************************************************/
 	inline void Datum::ReallocData(size_t capacity)
 	{
+		if (IsStorageShared())
+		{
+			DetachStorage(capacity, std::min(mSize, capacity));
+			return;
+		}
+
 		if (capacity == 0) 
 		{
 			free(mData.vo);
@@ -335,7 +648,7 @@ namespace Library
 		}
 		else
 		{
-			void* newData = realloc(mData.vo, capacity * DatumSizes[static_cast<int>(mType)]);
+			void* newData = realloc(mData.vo, capacity * ElementSize());
 			assert(newData != nullptr);
 			mData.vo = newData;
 		}
@@ -360,7 +673,7 @@ namespace Library
 
 	inline void Datum::CheckTypeHasBeenSet() const
 	{
-		if (mType == DatumType::Unknown)
+		if (mType == DatumType::Unknown || (mType == DatumType::Custom && mValueType == nullptr))
 		{
 			throw std::runtime_error("Datum must have type to complete this operation");
 		}
@@ -382,6 +695,38 @@ namespace Library
 			newCapacity = mCapacity + (mCapacity / 2) + 1; //Add half the current capacity + 1 each capacity increment
 		}
 		Reserve(newCapacity);
+		PrepareWrite();	//only marks the change if Reserve already had to copy a shared array
+	}
+
+	inline void Datum::PrepareWrite()
+	{
+		MarkDirty();
+		PrepareReference();
+	}
+
+	inline void Datum::PrepareReference()
+	{
+		if (mOwner != nullptr)
+		{
+			InvalidateOwnerHash();
+		}
+		if (IsStorageShared())
+		{
+			DetachStorage(mCapacity, mSize);
+		}
+	}
+
+	inline void Datum::MarkDirty() noexcept
+	{
+		if (mOwner != nullptr)
+		{
+			NotifyOwner();
+		}
+	}
+
+	inline bool Datum::IsDirty() const noexcept
+	{
+		return mIsDirty;
 	}
 
 	inline void Datum::ExternalException()
@@ -391,4 +736,34 @@ namespace Library
 			throw std::runtime_error("Cannot add/remove elements or otherwise change the size/capacity of a datum with external memory.");
 		}
 	}
+
+	inline const Datum::TypeOperations& Datum::Operations() const
+	{
+		return DatumOperations[static_cast<int>(mType)];
+	}
+
+	inline size_t Datum::ElementSize() const
+	{
+		if (mType == DatumType::Custom)
+		{
+			return (mValueType != nullptr ? mValueType->Size() : 0);
+		}
+		return DatumSizes[static_cast<int>(mType)];
+	}
+
+	template<typename T>
+	inline void Datum::TypeCheck() const
+	{
+		if constexpr (DatumTypeOf<T>::value == DatumType::Custom)
+		{
+			if (mType != DatumType::Custom || mValueType != &ValueType::Of<T>())
+			{
+				throw std::runtime_error("Datum type does not match operation type");
+			}
+		}
+		else
+		{
+			TypeCheck(DatumTypeOf<T>::value);
+		}
+	}
 }
\ No newline at end of file
@@ -4,6 +4,14 @@ namespace Library
 {
 	std::size_t AdditiveHash(const uint8_t* data, std::size_t size);
 
+	/// <summary>
+	/// Mixes value into seed. Unlike adding hashes together, the result depends on the order values are combined in.
+	/// </summary>
+	/// <param name="seed">the hash so far</param>
+	/// <param name="value">the hash to mix in</param>
+	/// <returns>The combined hash</returns>
+	std::size_t HashCombine(std::size_t seed, std::size_t value) noexcept;
+
 	template <typename T>
 	struct DefaultHash final
 	{
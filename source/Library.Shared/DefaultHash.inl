@@ -2,6 +2,11 @@
 
 namespace Library
 {
+	inline std::size_t HashCombine(std::size_t seed, std::size_t value) noexcept
+	{
+		return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+	}
+
 	template <typename T>
 	inline size_t DefaultHash<T>::operator()(const T& key) const
 	{
@@ -10,32 +10,28 @@ namespace Library
 
 	Entity::Entity() : Attributed(Entity::TypeIdClass()) 
 	{
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
 	}
 	
 	Entity::Entity(const std::string& name, Sector* sector) :
 		Attributed(Entity::TypeIdClass()), mName(name) 
 	{
 		if (sector != nullptr) { SetSector(*sector); }
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
 	}
 
 	Entity::Entity(std::string&& name, Sector* sector) :
 		Attributed(Entity::TypeIdClass()), mName(name) 
 	{
 		if (sector != nullptr) { SetSector(*sector); }
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
 	}
 
 	void Entity::Update(WorldState& state)
 	{
-		for (size_t i = 0; i < mActionsDatum->Size(); i++)
+		if (!IsMaterialized()) { return; }	//nothing was added to a deferred Actions table, resolving it would only materialize the layout
+		Datum& actions = Actions();
+		for (size_t i = 0; i < actions.Size(); i++)
 		{
-			Scope& action = mActionsDatum->Get<Scope>(i);
-			assert(action.Is(Action::TypeIdClass()));
+			Scope& action = actions.Get<Scope>(i);
+			assert(action.Is<Action>());
 			state.mAction = &static_cast<Action&>(action);
 			static_cast<Action&>(action).Update(state);
 		}
@@ -63,7 +59,7 @@ namespace Library
 	{
 		Scope* parent = GetParent();
 		//sanity check: if parent isn't nullptr, make sure it is a sector
-		assert(parent != nullptr ? parent->Is(Sector::TypeIdClass()) : true);
+		assert(parent != nullptr ? parent->Is<Sector>() : true);
 		return static_cast<Sector*>(parent);
 	}
 
@@ -74,14 +70,12 @@ namespace Library
 
 	Datum& Entity::Actions()
 	{
-		assert(mActionsDatum != nullptr); //sanity check
-		return *mActionsDatum;
+		return PrescribedAttribute(ACTIONS_INDEX);
 	}
 
 	const Datum& Entity::Actions() const
 	{
-		assert(mActionsDatum != nullptr); //sanity check
-		return *mActionsDatum;
+		return PrescribedAttribute(ACTIONS_INDEX);
 	}
 
 	Action* Entity::CreateAction(const std::string& className, const std::string& instanceName)
@@ -103,35 +97,30 @@ namespace Library
 		return new Entity(*this);
 	}
 
+	gsl::owner<Scope*> Entity::Relocate()
+	{
+		return RelocateAs(*this);
+	}
+
 	Vector<Signature> Entity::Signatures()
 	{
-		return Vector<Signature>
-		{
-			Signature("Name", DatumType::String, 1, offsetof(Entity, mName)),
-			Signature(ACTIONS_STRING, DatumType::Table, START_ACTIONS_CAPACITY, 0)
-		};
+		return ToSignatures(StaticSignatures());
 	}
 
 	Entity::Entity(RTTI::IdType typeID) :
 		Attributed(typeID)
 	{
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
 	}
 
 	Entity::Entity(RTTI::IdType typeID, const std::string& name, Sector* sector) :
 		Attributed(typeID), mName(name)
 	{
 		if (sector != nullptr) { SetSector(*sector); }
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
 	}
 
 	Entity::Entity(RTTI::IdType typeID, std::string&& name, Sector* sector) :
 		Attributed(typeID), mName(name)
 	{
 		if (sector != nullptr) { SetSector(*sector); }
-		mActionsDatum = Find(ACTIONS_STRING);
-		assert(mActionsDatum != nullptr);
 	}
 }
\ No newline at end of file
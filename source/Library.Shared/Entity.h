@@ -37,7 +37,7 @@ namespace Library
 		explicit Entity(std::string&& name, Sector* sector = nullptr);
 
 		/// <summary>
-		/// Copy constructor: Default scope copy constructor
+		/// Copy constructor: default scope copy constructor
 		/// </summary>
 		/// <param name="rhs">the entity to copy</param>
 		Entity(const Entity& rhs) = default;
@@ -57,7 +57,7 @@ namespace Library
 		/// Copy assignment: default scope copy assignment
 		/// </summary>
 		/// <param name="rhs">the entity to copy</param>
-		/// <returns>A copy of the entity</returns>
+		/// <returns>A reference to this entity</returns>
 		Entity& operator=(const Entity& rhs) = default;
 
 		/// <summary>
@@ -136,13 +136,26 @@ namespace Library
 		/// <returns>a pointer to a new entity</returns>
 		virtual gsl::owner<Entity*> Clone() const override;
 
+		/// <summary>
+		/// Moves this into a new heap allocated Entity, see Scope::Relocate
+		/// </summary>
+		/// <returns>the relocated scope</returns>
+		virtual gsl::owner<Scope*> Relocate() override;
+
 		/// <summary>
 		/// Gets the prescribed attributes for an entity
 		/// </summary>
 		/// <returns>The prescribed attributes for an entity</returns>
 		static Vector<Signature> Signatures();
 
+		/// <summary>
+		/// The prescribed attributes as a constexpr table, see Signatures()
+		/// </summary>
+		/// <returns>A StaticSignature for each prescribed attribute</returns>
+		static constexpr std::array<StaticSignature, 2> StaticSignatures();
+
 		static const inline std::string ACTIONS_STRING = "Actions";
+		static const size_t ACTIONS_INDEX;	//index of ACTIONS_STRING in Signatures(), looked up in StaticSignatures() below. See PrescribedAttribute
 	protected:
 		/// <summary>
 		/// Default constructor for Derived classes. Populates prescribed attributes using Signatures()
@@ -168,10 +181,20 @@ namespace Library
 		Entity(RTTI::IdType typeID, std::string&& name, Sector* sector = nullptr);
 
 		std::string mName;
-		Datum* mActionsDatum = nullptr;
 		static const size_t START_ACTIONS_CAPACITY = 23;
 	};
 
+	constexpr std::array<StaticSignature, 2> Entity::StaticSignatures()
+	{
+		return
+		{
+			SIGNATURE(Entity, "Name", DatumType::String, 1, mName),
+			TABLE_SIGNATURE("Actions", START_ACTIONS_CAPACITY)
+		};
+	}
+
+	inline constexpr size_t Entity::ACTIONS_INDEX = SignatureIndex(Entity::StaticSignatures(), "Actions");
+
 	ConcreteFactory(Entity, Scope) //Creates a factory for Entity classes
 }
 
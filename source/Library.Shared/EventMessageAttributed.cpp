@@ -43,11 +43,13 @@ namespace Library
 		return new EventMessageAttributed(*this);
 	}
 
+	gsl::owner<Scope*> EventMessageAttributed::Relocate()
+	{
+		return RelocateAs(*this);
+	}
+
 	Vector<Signature> EventMessageAttributed::Signatures()
 	{
-		return Vector<Signature>
-		{
-			Signature("Subtype", DatumType::String, 1, offsetof(EventMessageAttributed, mSubtype))
-		};
+		return ToSignatures(StaticSignatures());
 	}
 }
\ No newline at end of file
@@ -66,15 +66,35 @@ namespace Library
 		/// <returns>A heap allocated copy of this</returns>
 		virtual gsl::owner<EventMessageAttributed*> Clone() const override;
 
+		/// <summary>
+		/// Moves this into a new heap allocated EventMessageAttributed, see Scope::Relocate
+		/// </summary>
+		/// <returns>the relocated scope</returns>
+		virtual gsl::owner<Scope*> Relocate() override;
+
 		/// <summary>
 		/// Get the signatures for this class (used to populate attributes)
 		/// </summary>
 		/// <returns>The signatures for prescribed attributes for this class</returns>
 		static Vector<Signature> Signatures();
 
+		/// <summary>
+		/// The prescribed attributes as a constexpr table, see Signatures()
+		/// </summary>
+		/// <returns>A StaticSignature for each prescribed attribute</returns>
+		static constexpr std::array<StaticSignature, 1> StaticSignatures();
+
 	private:
 		World* mWorldPtr = nullptr;
 		std::string mSubtype; //prescribed attribute
 	};
+
+	constexpr std::array<StaticSignature, 1> EventMessageAttributed::StaticSignatures()
+	{
+		return
+		{
+			SIGNATURE(EventMessageAttributed, "Subtype", DatumType::String, 1, mSubtype)
+		};
+	}
 };
 
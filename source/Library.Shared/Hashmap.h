@@ -97,6 +97,12 @@ namespace Library
 		/// <returns>The size (how many entries are in the hashmap)</returns>
 		size_t Size() const noexcept;
 
+		/// <summary>
+		/// Walks every bucket to find the longest chain, e.g. to judge whether a map given this many buckets hashes well
+		/// </summary>
+		/// <returns>The number of entries in the fullest bucket</returns>
+		size_t LongestChain() const;
+
 		/// <summary>
 		/// Returns the average number of elements per bucket
 		/// Size() divided by Capacity()
@@ -119,6 +125,22 @@ namespace Library
 		/// <returns>An iterator pointing to the entry with given key in the hashmap and a bool indicating whether an entry was created.</returns>
 		std::pair<Iterator, bool> Insert(const PairType& entry, EqualityFunctor equalFunc = DefaultEquality<TKey>{});
 
+		/// <summary>
+		/// Inserts an entry whose key is known not to be in the hashmap yet, without searching the bucket for it.
+		/// Used when rebuilding a hashmap from one whose keys are already unique, e.g. when deep copying a Scope.
+		/// </summary>
+		/// <param name="entry">The key,data pair to insert into the hashmap. Its key must not already be present.</param>
+		/// <returns>An iterator pointing to the new entry</returns>
+		Iterator InsertUnique(const PairType& entry);
+
+		/// <summary>
+		/// Inserts an entry whose key is known not to be in the map, with its hash already computed, e.g. kept from an earlier insert
+		/// </summary>
+		/// <param name="entry">the entry to insert</param>
+		/// <param name="hash">the hash function's result for entry.first</param>
+		/// <returns>An iterator to the inserted entry</returns>
+		Iterator InsertUnique(const PairType& entry, size_t hash);
+
 		/// <summary>
 		/// Searches for a given key in the hashmap
 		/// </summary>
@@ -201,6 +223,16 @@ namespace Library
 		ConstIterator cend() const;
 
 	private:
+		/// <summary>
+		/// Finds the entry with the given key in one bucket. Compares keys only, so no placeholder entry is built.
+		/// </summary>
+		/// <param name="hashIndex">the bucket to search</param>
+		/// <param name="key">the key to look for</param>
+		/// <param name="equalFunc">the key comparison</param>
+		/// <returns>The entry's position in the bucket, or the bucket's end</returns>
+		typename ChainType::Iterator FindInChain(size_t hashIndex, const TKey& key, const EqualityFunctor& equalFunc);
+		typename ChainType::ConstIterator FindInChain(size_t hashIndex, const TKey& key, const EqualityFunctor& equalFunc) const;
+
 		HashFunctor mHashFunc = DefaultHash<TKey>{};
 		size_t mCapacity = 0;	//how many buckets we have
 		size_t mSize = 0;		//how many buckets have items
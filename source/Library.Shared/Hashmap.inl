@@ -68,6 +68,17 @@ namespace Library
 		return mBuckets.Capacity();
 	}
 	
+	template<typename TKey, typename TData>
+	inline size_t Hashmap<TKey, TData>::LongestChain() const
+	{
+		size_t longest = 0;
+		for (const ChainType& chain : mBuckets)
+		{
+			longest = std::max(longest, chain.Size());
+		}
+		return longest;
+	}
+
 	template<typename TKey, typename TData>
 	inline size_t Hashmap<TKey, TData>::Size() const noexcept
 	{
@@ -96,7 +107,7 @@ namespace Library
 
 		size_t hashIndex = (mHashFunc(entry.first)) % Capacity();
 
-		auto chainIt = mBuckets[hashIndex].Find(entry, [&equalFunc](PairType left, PairType right) {return equalFunc(left.first, right.first); });
+		auto chainIt = mBuckets[hashIndex].Find(entry, [&equalFunc](const PairType& left, const PairType& right) {return equalFunc(left.first, right.first); });
 
 		//not found, push new entry
 		if (chainIt == mBuckets[hashIndex].end()) 
@@ -109,15 +120,32 @@ namespace Library
 		return std::make_pair(Iterator(*this, hashIndex, chainIt), bEntryMade);
 	}
 
+	template<typename TKey, typename TData>
+	typename Hashmap<TKey, TData>::Iterator Hashmap<TKey, TData>::InsertUnique(const PairType& entry)
+	{
+		return InsertUnique(entry, mHashFunc(entry.first));
+	}
+
+	template<typename TKey, typename TData>
+	typename Hashmap<TKey, TData>::Iterator Hashmap<TKey, TData>::InsertUnique(const PairType& entry, size_t hash)
+	{
+		assert(Capacity() > 0);
+		assert(hash == mHashFunc(entry.first));
+		assert(Find(entry.first) == end());
+
+		size_t hashIndex = hash % Capacity();
+		auto chainIt = mBuckets[hashIndex].PushBack(entry);
+		mSize++;
+		return Iterator(*this, hashIndex, chainIt);
+	}
+
 	template<typename TKey, typename TData>
 	typename Hashmap<TKey, TData>::Iterator Hashmap<TKey, TData>::Find(const TKey& key, EqualityFunctor equalFunc)
 	{
 		if (Capacity() == 0 || mSize == 0) { return end(); }
 
 		size_t hashIndex = (mHashFunc(key)) % Capacity();
-
-		std::pair<TKey, TData> placeHolder(key, TData());
-		auto chainIt = mBuckets[hashIndex].Find(placeHolder, [&equalFunc](PairType left, PairType right) {return equalFunc(left.first, right.first); });
+		auto chainIt = FindInChain(hashIndex, key, equalFunc);
 		
 		//not found, return end()
 		if (chainIt == mBuckets[hashIndex].end()) { return end(); }
@@ -131,9 +159,7 @@ namespace Library
 		if (Capacity() == 0) { return end(); }
 		 
 		size_t hashIndex = (mHashFunc(key)) % Capacity();
-
-		std::pair<TKey, TData> placeHolder(key, TData());
-		auto chainIt = mBuckets[hashIndex].Find(placeHolder, [&equalFunc](PairType left, PairType right) {return equalFunc(left.first, right.first); });
+		auto chainIt = FindInChain(hashIndex, key, equalFunc);
 
 		//not found, return end()
 		if (chainIt == mBuckets[hashIndex].end()) { return end(); }
@@ -189,8 +215,7 @@ namespace Library
 		if (mBuckets[hashIndex].IsEmpty()) { return; }
 
 		//find entry
-		std::pair<TKey, TData> placeHolder(key, TData());
-		auto chainIt = mBuckets[hashIndex].Find(placeHolder, [&equalFunc](PairType left, PairType right) {return equalFunc(left.first,right.first); });
+		auto chainIt = FindInChain(hashIndex, key, equalFunc);
 
 		if (chainIt == mBuckets[hashIndex].end()) { return; }
 
@@ -198,6 +223,30 @@ namespace Library
 		mSize--;
 	}
 
+	template<typename TKey, typename TData>
+	typename Hashmap<TKey, TData>::ChainType::Iterator Hashmap<TKey, TData>::FindInChain(size_t hashIndex, const TKey& key, const EqualityFunctor& equalFunc)
+	{
+		ChainType& chain = mBuckets[hashIndex];
+		auto chainIt = chain.begin();
+		for (; chainIt != chain.end(); ++chainIt)
+		{
+			if (equalFunc((*chainIt).first, key)) { break; }
+		}
+		return chainIt;
+	}
+
+	template<typename TKey, typename TData>
+	typename Hashmap<TKey, TData>::ChainType::ConstIterator Hashmap<TKey, TData>::FindInChain(size_t hashIndex, const TKey& key, const EqualityFunctor& equalFunc) const
+	{
+		const ChainType& chain = mBuckets[hashIndex];
+		auto chainIt = chain.begin();
+		for (; chainIt != chain.end(); ++chainIt)
+		{
+			if (equalFunc((*chainIt).first, key)) { break; }
+		}
+		return chainIt;
+	}
+
 	template<typename TKey, typename TData>
 	typename Hashmap<TKey,TData>::Iterator Hashmap<TKey, TData>::begin()
 	{
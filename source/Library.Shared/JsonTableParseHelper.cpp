@@ -64,6 +64,12 @@ namespace Library
 		{"matrix", DatumType::Matrix},
 		{"string", DatumType::String},
 		{"table", DatumType::Table},
+		{"bool", DatumType::Boolean},
+		{"int64", DatumType::Integer64},
+		{"double", DatumType::Double},
+		{"vec2", DatumType::Vector2},
+		{"vec3", DatumType::Vector3},
+		{"quat", DatumType::Quaternion},
 	};
 
 	void JsonTableParseHelper::Initialize()
@@ -80,11 +86,10 @@ namespace Library
 
 		if (key == "type" && value.isString())
 		{
-			auto str = value.asString();
-			auto it = mTypes.Find(str);
-			if (it != mTypes.end())
+			DatumType type = FindType(value.asString());
+			if (type != DatumType::Unknown)
 			{
-				mContextStack.Top().dat->SetType(it->second);
+				mContextStack.Top().dat->SetType(type);
 				parsed = true;
 			}
 			//if type was not valid (not found in hashmap) will return false
@@ -157,7 +162,7 @@ namespace Library
 
 	bool JsonTableParseHelper::EndHandler(JsonParseMaster::SharedData& sharedData, const std::string& key)
 	{
-		if (!sharedData.Is(TableSharedData::TypeIdClass())) { return false; }
+		if (!sharedData.Is<TableSharedData>()) { return false; }
 		auto& frameKey = mContextStack.Top().key;
 		if (&frameKey == &key)
 		{
@@ -171,4 +176,10 @@ namespace Library
 		return new JsonTableParseHelper();
 	}
 
+	DatumType JsonTableParseHelper::FindType(const std::string& name)
+	{
+		auto it = mTypes.Find(name);
+		return (it != mTypes.end() ? it->second : DatumType::Unknown);
+	}
+
 }
\ No newline at end of file
@@ -53,6 +53,13 @@ namespace Library
 		bool EndHandler(JsonParseMaster::SharedData & sharedData, const std::string & key) override;
 		JsonTableParseHelper* Create();
 
+		/// <summary>
+		/// Looks up the datum type a type name in json stands for, e.g. "integer"
+		/// </summary>
+		/// <param name="name">the type name</param>
+		/// <returns>The datum type, or DatumType::Unknown if name is not a type name</returns>
+		static DatumType FindType(const std::string& name);
+
 	private:
 		struct StackFrame
 		{
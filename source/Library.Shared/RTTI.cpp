@@ -0,0 +1,75 @@
+#include "pch.h"
+#include "RTTI.h"
+#include "Hashmap.h"
+#include "vector.h"
+
+namespace Library
+{
+	namespace
+	{
+		struct TypeNameEntry
+		{
+			RTTI::IdType mId;
+			std::size_t mDepth;
+		};
+
+		//a name can belong to several types, e.g. every Event<T> is called "Event"
+		using TypeNameMapType = Hashmap<std::string, Vector<TypeNameEntry>>;
+
+		//constructed on first use, so registering from another translation unit's static initialization is safe
+		TypeNameMapType& TypeNames()
+		{
+			static TypeNameMapType sTypeNames(61);
+			return sTypeNames;
+		}
+
+		struct TypeIdEntry
+		{
+			std::string mName;
+			std::span<const RTTI::IdType> mAncestry;
+		};
+
+		Hashmap<RTTI::IdType, TypeIdEntry>& TypeIds()
+		{
+			static Hashmap<RTTI::IdType, TypeIdEntry> sTypeIds(61);
+			return sTypeIds;
+		}
+	}
+
+	bool RTTI::Is(const std::string& name) const
+	{
+		const TypeNameMapType& typeNames = TypeNames();
+		auto it = typeNames.Find(name);
+		if (it == typeNames.end()) { return false; }
+
+		const std::span<const IdType> ancestry = AncestryInstance();
+		for (const TypeNameEntry& entry : it->second)
+		{
+			if (ancestry.size() >= entry.mDepth && ancestry[entry.mDepth - 1] == entry.mId) { return true; }
+		}
+		return false;
+	}
+
+	RTTI::IdType RTTI::RegisterTypeName(const std::string& name, std::span<const IdType> ancestry)
+	{
+		assert(!ancestry.empty());
+		const IdType id = ancestry.back();
+		TypeNames()[name].PushBack(TypeNameEntry{ id, ancestry.size() });
+		TypeIds().Insert(std::make_pair(id, TypeIdEntry{ name, ancestry }));
+		return id;
+	}
+
+	const std::string* RTTI::FindTypeName(IdType id)
+	{
+		const Hashmap<IdType, TypeIdEntry>& typeIds = TypeIds();
+		auto it = typeIds.Find(id);
+		return (it != typeIds.end() ? &it->second.mName : nullptr);
+	}
+
+	std::span<const RTTI::IdType> RTTI::FindAncestry(IdType id)
+	{
+		const Hashmap<IdType, TypeIdEntry>& typeIds = TypeIds();
+		auto it = typeIds.Find(id);
+		return (it != typeIds.end() ? it->second.mAncestry : std::span<const IdType>());
+	}
+}
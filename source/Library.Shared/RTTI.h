@@ -2,6 +2,9 @@
 
 #include <string>
 #include <cstddef>
+#include <array>
+#include <span>
+#include <algorithm>
 
 namespace Library
 {
@@ -11,30 +14,64 @@ namespace Library
 		using IdType = std::size_t;
 		static IdType TypeIdClass() { return 0; }
 
+		/// <summary>
+		/// The number of RTTI types between RTTI and a type, counting the type itself
+		/// </summary>
+		/// <returns>0 for RTTI, its parent's depth + 1 for any other type</returns>
+		static constexpr std::size_t TypeDepth() { return 0; }
+
 		virtual ~RTTI() = default;
 
 		virtual Library::RTTI::IdType TypeIdInstance() const = 0;
 
-		virtual bool Is(IdType) const
+		/// <summary>
+		/// The ids of the dynamic type's ancestors, from the child of RTTI down to the type itself.
+		/// A type T is an ancestor exactly when the entry at T::TypeDepth() - 1 is T's id.
+		/// </summary>
+		/// <returns>TypeDepth() ids, the last one being TypeIdInstance()</returns>
+		virtual std::span<const IdType> AncestryInstance() const = 0;
+
+		/// <summary>
+		/// Checks whether this is an instance of the type with the given id, or of a type derived from it
+		/// </summary>
+		/// <param name="id">the type id to check for</param>
+		/// <returns>True if id is the id of this object's type or of one of its ancestors</returns>
+		bool Is(IdType id) const
 		{
-			return false;
+			//at most a handful of contiguous ids, no virtual call per level
+			const std::span<const IdType> ancestry = AncestryInstance();
+			return std::find(ancestry.begin(), ancestry.end(), id) != ancestry.end();
 		}
 
-		virtual bool Is(const std::string&) const
+		/// <summary>
+		/// Checks whether this is an instance of the type with the given name, or of a type derived from it
+		/// </summary>
+		/// <param name="name">the type name to check for, see TypeName</param>
+		/// <returns>True if name is the name of this object's type or of one of its ancestors</returns>
+		bool Is(const std::string& name) const;
+
+		/// <summary>
+		/// Checks whether this is an instance of T, or of a type derived from T, in constant time
+		/// </summary>
+		/// <returns>True if T is this object's type or one of its ancestors</returns>
+		template <typename T>
+		bool Is() const
 		{
-			return false;
+			static_assert(T::TypeDepth() > 0, "T must declare its RTTI");
+			const std::span<const IdType> ancestry = AncestryInstance();
+			return (ancestry.size() >= T::TypeDepth() && ancestry[T::TypeDepth() - 1] == T::TypeIdClass());
 		}
 
 		template <typename T>
 		const T* As() const
 		{
-			return (Is(T::TypeIdClass()) ? reinterpret_cast<const T*>(this) : nullptr);
+			return (Is<T>() ? reinterpret_cast<const T*>(this) : nullptr);
 		}
 
 		template <typename T>
 		T* As()
 		{
-			return (Is(T::TypeIdClass()) ? reinterpret_cast<T*>(const_cast<RTTI*>(this)) : nullptr);
+			return (Is<T>() ? reinterpret_cast<T*>(const_cast<RTTI*>(this)) : nullptr);
 		}
 
 		virtual std::string ToString() const
@@ -46,23 +83,65 @@ namespace Library
 		{
 			return this == rhs;
 		}
+
+		/// <summary>
+		/// Records a type's name for Is(const std::string&), and its ancestry for FindAncestry. Called by RTTI_DEFINITIONS during static initialization.
+		/// </summary>
+		/// <param name="name">the type's name</param>
+		/// <param name="ancestry">the type's AncestryClass, which outlives the program's use of it</param>
+		/// <returns>the type's id, the last entry of ancestry</returns>
+		static IdType RegisterTypeName(const std::string& name, std::span<const IdType> ancestry);
+
+		/// <summary>
+		/// Looks up the name a type was registered with, e.g. to save something about a type under a name that is the same in the next run
+		/// </summary>
+		/// <param name="id">the type's id</param>
+		/// <returns>The type's name, or nullptr if id is not the id of an RTTI type</returns>
+		static const std::string* FindTypeName(IdType id);
+
+		/// <summary>
+		/// Looks up the ancestry of a type by id, e.g. to check how types registered elsewhere by id relate
+		/// </summary>
+		/// <param name="id">the type's id</param>
+		/// <returns>The type's AncestryClass, or an empty span if id is not the id of an RTTI type</returns>
+		static std::span<const IdType> FindAncestry(IdType id);
+
+	protected:
+		/// <summary>
+		/// Builds a type's ancestry from its parent's
+		/// </summary>
+		/// <param name="parentAncestry">the parent type's ancestry</param>
+		/// <param name="id">the type's id</param>
+		/// <returns>parentAncestry followed by id</returns>
+		template <std::size_t Depth>
+		static std::array<IdType, Depth> MakeAncestry(std::span<const IdType> parentAncestry, IdType id)
+		{
+			std::array<IdType, Depth> ancestry{};
+			std::copy(parentAncestry.begin(), parentAncestry.end(), ancestry.begin());
+			ancestry[Depth - 1] = id;
+			return ancestry;
+		}
+
+		static std::span<const IdType> AncestryClass() { return {}; }
 	};
 
 #define RTTI_DECLARATIONS(Type, ParentType)																						\
 		public:																													\
 			static std::string TypeName() { return std::string(#Type); }														\
-			static Library::RTTI::IdType TypeIdClass() { return sRunTimeTypeId; }																\
+			static Library::RTTI::IdType TypeIdClass() { return reinterpret_cast<Library::RTTI::IdType>(&sRunTimeTypeId); }						\
+			static constexpr std::size_t TypeDepth() { return ParentType::TypeDepth() + 1; }								\
 			Library::RTTI::IdType TypeIdInstance() const override { return TypeIdClass(); }											\
-			bool Is(Library::RTTI::IdType id) const override																			\
-			{																													\
-				return (id == sRunTimeTypeId ? true : ParentType::Is(id));														\
-			}																													\
-			bool Is(const std::string& name) const override																\
+			std::span<const Library::RTTI::IdType> AncestryInstance() const override { return AncestryClass(); }			\
+			static std::span<const Library::RTTI::IdType> AncestryClass()															\
 			{																													\
-				return (name == TypeName() ? true : ParentType::Is(name));														\
+				/*TypeIdClass is an address, so this is usable before static initialization reaches sRunTimeTypeId*/			\
+				static const std::array<Library::RTTI::IdType, TypeDepth()> sAncestry =										\
+					Library::RTTI::MakeAncestry<TypeDepth()>(ParentType::AncestryClass(), TypeIdClass());					\
+				return sAncestry;																								\
 			}																													\
 			private:																											\
+				/*its address is the type's id, its value is only initialized to register the type's name*/						\
 				static const Library::RTTI::IdType sRunTimeTypeId;
 
-#define RTTI_DEFINITIONS(Type) const Library::RTTI::IdType Type::sRunTimeTypeId = reinterpret_cast<Library::RTTI::IdType>(&Type::sRunTimeTypeId);
-}
\ No newline at end of file
+#define RTTI_DEFINITIONS(Type) const Library::RTTI::IdType Type::sRunTimeTypeId = Library::RTTI::RegisterTypeName(Type::TypeName(), Type::AncestryClass());
+}
@@ -44,10 +44,15 @@ namespace Library
 		Event<EventMessageAttributed>::Unsubscribe(*this);
 	}
 
+	void ReactionAttributed::Quiesce()
+	{
+		Event<EventMessageAttributed>::Unsubscribe(*this);
+	}
+
 	void ReactionAttributed::Notify(const EventPublisher& event)
 	{
 		//accept only eventmessageattributed events
-		assert(event.Is(Event<EventMessageAttributed>::TypeIdClass())); //only subscribing to <EventMessageAttributed>
+		assert(event.Is<Event<EventMessageAttributed>>()); //only subscribing to <EventMessageAttributed>
 		auto& eventEMA = static_cast<const Event<EventMessageAttributed>&>(event);
 		auto& eventMsgAttr = eventEMA.GetMessage();
 		
@@ -82,14 +87,14 @@ namespace Library
 		return new ReactionAttributed(*this);
 	}
 
+	gsl::owner<Scope*> ReactionAttributed::Relocate()
+	{
+		return RelocateAs(*this);
+	}
+
 	Vector<Signature> ReactionAttributed::Signatures()
 	{
-		return Vector<Signature>
-		{
-			Signature("Name", DatumType::String, 1, offsetof(ReactionAttributed, mName)),
-			Signature(ACTIONS_STRING, DatumType::Table, START_ACTIONS_CAPACITY, 0),
-			Signature("Subtype", DatumType::String, 1, offsetof(ReactionAttributed, mSubtype))
-		};
+		return ToSignatures(StaticSignatures());
 	}
 
 }
\ No newline at end of file
@@ -74,15 +74,42 @@ namespace Library
 		/// <returns>a pointer to a heap allocated copy of this</returns>
 		virtual gsl::owner<ReactionAttributed*> Clone() const override;
 
+		/// <summary>
+		/// Moves this into a new heap allocated ReactionAttributed, see Scope::Relocate
+		/// </summary>
+		/// <returns>the relocated scope</returns>
+		virtual gsl::owner<Scope*> Relocate() override;
+
 		/// <summary>
 		/// Gets the prescribed attributes for a reactionAttributed
 		/// </summary>
 		/// <returns>The prescribed attributes for a ReactionAttributed</returns>
 		static Vector<Signature> Signatures();
 
+		/// <summary>
+		/// The prescribed attributes as a constexpr table, see Signatures(). Only those added to ActionList's: register with ActionList as the parent type.
+		/// </summary>
+		/// <returns>A StaticSignature for each prescribed attribute not inherited</returns>
+		static constexpr std::array<StaticSignature, 1> StaticSignatures();
+
+	protected:
+		/// <summary>
+		/// Unsubscribes from attributed events, so a reaction waiting to be reclaimed is not notified
+		/// </summary>
+		void Quiesce() override;
+
 	private:
 		std::string mSubtype;
 	};
+
+	constexpr std::array<StaticSignature, 1> ReactionAttributed::StaticSignatures()
+	{
+		return
+		{
+			SIGNATURE(ReactionAttributed, "Subtype", DatumType::String, 1, mSubtype)
+		};
+	}
+
 	ConcreteFactory(ReactionAttributed, Scope)
 }
 
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <gsl/gsl>
+#include "RTTI.h"
+#include "Scope.h"
+#include "AttributedSchema.h"
+
+namespace Library
+{
+	/// <summary>
+	/// An instance of a class defined by an AttributedSchema, deriving from the schema's native parent (Attributed or Entity).
+	/// The schema's attributes live in one block allocated at the end of the object, so they are prescribed attributes like the native parent's members.
+	/// Only created through AttributedSchema::Create (or the class's factory) and Clone, which allocate the block.
+	/// </summary>
+	template <typename TBase>
+	class SchemaInstance final : public TBase
+	{
+		RTTI_DECLARATIONS(SchemaInstance, TBase)
+
+	public:
+		/// <summary>
+		/// Creates an instance of the class schema defines
+		/// </summary>
+		/// <param name="schema">the class to instantiate, whose native parent is TBase</param>
+		/// <returns>A heap allocated instance</returns>
+		static gsl::owner<SchemaInstance*> Create(const AttributedSchema& schema);
+
+		/// <summary>
+		/// Where the attribute storage starts, relative to the object
+		/// </summary>
+		/// <returns>The offset of the attribute storage in bytes</returns>
+		static size_t StorageOffset() noexcept;
+
+		SchemaInstance(SchemaInstance&& rhs) noexcept = delete;
+		SchemaInstance& operator=(const SchemaInstance& rhs) = delete;
+		SchemaInstance& operator=(SchemaInstance&& rhs) noexcept = delete;
+
+		/// <summary>
+		/// Destructor: destructs the attribute storage, and uncounts the instance from its schema
+		/// </summary>
+		~SchemaInstance();
+
+		/// <summary>
+		/// The class this is an instance of
+		/// </summary>
+		/// <returns>The schema of this instance's class</returns>
+		const AttributedSchema& Schema() const noexcept;
+
+		/// <summary>
+		/// Creates a new copy of this, with its own attribute storage
+		/// </summary>
+		/// <returns>A heap allocated copy of this</returns>
+		gsl::owner<SchemaInstance*> Clone() const override;
+
+	private:
+		explicit SchemaInstance(const AttributedSchema& schema);
+		SchemaInstance(const SchemaInstance& rhs);
+
+		/// <summary>
+		/// Allocates an instance with room for schema's attribute storage, then constructs it from source
+		/// </summary>
+		template <typename TSource>
+		static gsl::owner<SchemaInstance*> Allocate(const AttributedSchema& schema, const TSource& source);
+
+		/// <summary>
+		/// Constructs the attribute storage, copying it from source if there is one
+		/// </summary>
+		/// <param name="source">the instance to copy the attributes of, or nullptr to default construct them</param>
+		void ConstructStorage(const SchemaInstance* source);
+
+		/// <summary>
+		/// Destructs the first count stored attributes
+		/// </summary>
+		/// <param name="count">the number of attributes to destruct</param>
+		void DestructStorage(size_t count) noexcept;
+
+		std::byte* Storage() noexcept;
+		const std::byte* Storage() const noexcept;
+
+		const AttributedSchema* mSchema;
+	};
+}
+
+#include "SchemaInstance.inl"
@@ -0,0 +1,128 @@
+#include "SchemaInstance.h"
+#include <new>
+
+namespace Library
+{
+	template <typename TBase>
+	RTTI_DEFINITIONS(SchemaInstance<TBase>)
+
+	template <typename TBase>
+	inline gsl::owner<SchemaInstance<TBase>*> SchemaInstance<TBase>::Create(const AttributedSchema& schema)
+	{
+		return Allocate(schema, schema);
+	}
+
+	template <typename TBase>
+	inline size_t SchemaInstance<TBase>::StorageOffset() noexcept
+	{
+		const size_t alignment = alignof(std::max_align_t);
+		return (sizeof(SchemaInstance) + alignment - 1) & ~(alignment - 1);
+	}
+
+	template <typename TBase>
+	template <typename TSource>
+	inline gsl::owner<SchemaInstance<TBase>*> SchemaInstance<TBase>::Allocate(const AttributedSchema& schema, const TSource& source)
+	{
+		//Scope::operator new only knows the size of the class, so the storage is asked for here and the object is constructed in place
+		void* memory = Scope::operator new(StorageOffset() + schema.StorageSize());
+		try
+		{
+			return ::new(memory) SchemaInstance(source);
+		}
+		catch (...)
+		{
+			Scope::operator delete(memory);
+			throw;
+		}
+	}
+
+	template <typename TBase>
+	inline SchemaInstance<TBase>::SchemaInstance(const AttributedSchema& schema) :
+		TBase(schema.TypeId()), mSchema(&schema)
+	{
+		ConstructStorage(nullptr);
+		++mSchema->mInstanceCount;
+	}
+
+	template <typename TBase>
+	inline SchemaInstance<TBase>::SchemaInstance(const SchemaInstance& rhs) :
+		TBase(rhs), mSchema(rhs.mSchema)
+	{
+		ConstructStorage(&rhs);
+		++mSchema->mInstanceCount;
+	}
+
+	template <typename TBase>
+	inline SchemaInstance<TBase>::~SchemaInstance()
+	{
+		DestructStorage(mSchema->Attributes().Size());
+		--mSchema->mInstanceCount;
+	}
+
+	template <typename TBase>
+	inline const AttributedSchema& SchemaInstance<TBase>::Schema() const noexcept
+	{
+		return *mSchema;
+	}
+
+	template <typename TBase>
+	inline gsl::owner<SchemaInstance<TBase>*> SchemaInstance<TBase>::Clone() const
+	{
+		return Allocate(*mSchema, *this);
+	}
+
+	template <typename TBase>
+	inline void SchemaInstance<TBase>::ConstructStorage(const SchemaInstance* source)
+	{
+		//the datums already point into the storage, see Attributed::UpdateExternalStorage
+		const Vector<AttributedSchema::Attribute>& attributes = mSchema->Attributes();
+		size_t constructed = 0;
+		try
+		{
+			for (; constructed < attributes.Size(); ++constructed)
+			{
+				const AttributedSchema::Attribute& attribute = attributes[constructed];
+				if (attribute.mType == DatumType::Table) { continue; }
+				if (source != nullptr)
+				{
+					Datum::CopyStorage(attribute.mType, Storage() + attribute.mOffset, source->Storage() + attribute.mOffset, attribute.mSize);
+				}
+				else
+				{
+					Datum::ConstructStorage(attribute.mType, Storage() + attribute.mOffset, attribute.mSize);
+				}
+			}
+		}
+		catch (...)
+		{
+			DestructStorage(constructed);
+			throw;
+		}
+	}
+
+	template <typename TBase>
+	inline void SchemaInstance<TBase>::DestructStorage(size_t count) noexcept
+	{
+		const Vector<AttributedSchema::Attribute>& attributes = mSchema->Attributes();
+		for (size_t i = 0; i < count; ++i)
+		{
+			const AttributedSchema::Attribute& attribute = attributes[i];
+			if (attribute.mType != DatumType::Table)
+			{
+				Datum::DestructStorage(attribute.mType, Storage() + attribute.mOffset, attribute.mSize);
+			}
+		}
+	}
+
+	template <typename TBase>
+	inline std::byte* SchemaInstance<TBase>::Storage() noexcept
+	{
+		return reinterpret_cast<std::byte*>(this) + StorageOffset();
+	}
+
+	template <typename TBase>
+	inline const std::byte* SchemaInstance<TBase>::Storage() const noexcept
+	{
+		return reinterpret_cast<const std::byte*>(this) + StorageOffset();
+	}
+}
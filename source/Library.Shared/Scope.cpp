@@ -1,5 +1,8 @@
 #include "pch.h"
 #include "Scope.h"
+#include "ScopeArena.h"
+#include "CapacityProfile.h"
+#include <thread>
 
 namespace Library
 {
@@ -14,49 +17,76 @@ namespace Library
 		}
 	}
 
-	Scope::Scope(const Scope& rhs) :
-		mTable(rhs.mTable), mParent(nullptr)
+	Scope::Layout::Layout(Vector<std::pair<std::string, Datum>>&& entries, size_t capacity) :
+		mEntries(entries.Size()), mHashes(entries.Size()), mCapacity(std::max(capacity, entries.Size()))
 	{
-		//populate order vector
-		mOrderVector.Resize(rhs.Size());
-		for (size_t i = 0; i < rhs.mOrderVector.Size(); ++i)
+		const DefaultHash<const std::string> hash;	//what MapType hashes with by default
+		for (auto& entry : entries)
 		{
-			auto result = mTable.Find(rhs.mOrderVector[i]->first);
-			assert(result != mTable.end());
-			mOrderVector[i] = &(*result);
-
-			Datum& dat = result->second;
-
-			//deep copy any children scope
-			if (dat.Type() == DatumType::Table)
+			if (entry.first.empty()) { throw std::runtime_error("Name cannot be empty"); }
+			if (entry.second.Type() == DatumType::Table && entry.second.Size() > 0) { throw std::runtime_error("Cannot lay out a datum holding scopes"); }
+			for (const auto& existing : mEntries)
 			{
-				for (size_t j = 0; j < dat.Size(); ++j)
-				{
-					//Scope* scope = new Scope(dat[j]);
-					Scope* scope = dat[j].Clone();
-					dat.Set(*scope, j);
-					scope->mParent = this;
-				}
+				if (existing.first == entry.first) { throw std::runtime_error("Duplicate key: " + entry.first); }
 			}
+
+			mHashes.PushBack(hash(entry.first));
+			mKeyFilter |= KeyFilterBits(entry.first);
+			mEntries.PushBack(std::pair<const std::string, Datum>(std::move(entry.first), std::move(entry.second)));
 		}
 	}
 
+	size_t Scope::Layout::Size() const noexcept
+	{
+		return mEntries.Size();
+	}
+
+	size_t Scope::Layout::Capacity() const noexcept
+	{
+		return mCapacity;
+	}
+
+	Scope::Scope(const Layout& layout, bool deferred) :
+		mTable(deferred ? 1 : std::max<size_t>(layout.Capacity(), 1)), mOrderVector(deferred ? 0 : layout.Capacity())
+	{
+		//a new scope has no parent, so its entries cannot hide anything and there are no searches to invalidate
+		if (deferred)
+		{
+			mDeferredLayout = &layout;
+		}
+		else
+		{
+			InsertLayout(layout);
+		}
+	}
+
+	Scope::Scope(const Scope& rhs) :
+		mTable(rhs.mTable.Capacity()), mOrderVector(rhs.mOrderVector.Size()), mParent(nullptr), mKeyFilter(rhs.mKeyFilter)
+	{
+		DeepCopy(rhs);
+	}
+
 	Scope::Scope(Scope&& rhs) noexcept :
-		mTable(std::move(rhs.mTable))
+		mTable(std::move(rhs.mTable)), mKeyFilter(rhs.mKeyFilter), mDeferredLayout(rhs.mDeferredLayout), mTracksChanges(rhs.mTracksChanges), mHasChanges(rhs.mHasChanges.load())
 	{
 		mOrderVector = std::move(rhs.mOrderVector);
-		mParent = rhs.mParent;
+		rhs.mDeferredLayout = nullptr;
 		//reparent
-		if (mParent != nullptr)
+		if (rhs.mParent != nullptr)
 		{
-			auto result = mParent->FindContainedScope(rhs);
+			auto result = rhs.FindInParent();
 			result.first->Set(*this, result.second);
+			SetParent(*rhs.mParent, *result.first, result.second);
 			rhs.mParent = nullptr;
+			rhs.mParentDatum = nullptr;
 		}
+		rhs.InvalidateSearches();	//rhs is empty and parentless now
+		rhs.MarkStructureChanged();
 
 		for (const auto& pair : mOrderVector)
 		{
 			Datum& dat = pair->second;
+			if (mTracksChanges) { dat.mOwner = this; }	//the datums moved with the table
 			if (dat.Type() == DatumType::Table)
 			{
 				for (size_t j = 0; j < dat.Size(); ++j)
@@ -67,14 +97,64 @@ namespace Library
 				}
 			}
 		}
+		InvalidateSearches();	//cached results in our new children point at rhs
+		MarkStructureChanged();
+		if (mParent != nullptr) { mParent->MarkStructureChanged(); }	//a different scope is in rhs's slot
 	}
 
 	Scope::~Scope()
 	{
-		Orphan();
+		RemoveFromParent();	//the children are deleted next, their searches do not need invalidating
 		Clear();
 	}
 	
+	namespace
+	{
+		//every scope allocation starts with the arena it came from (nullptr for the heap) and its size, padded to keep the scope aligned
+		struct AllocationHeader
+		{
+			ScopeArena* mArena;
+			size_t mSize;	//what the arena was asked for, a SchemaInstance is larger than its class
+		};
+		const size_t ALLOCATION_HEADER_SIZE = alignof(std::max_align_t);
+		static_assert(sizeof(AllocationHeader) <= ALLOCATION_HEADER_SIZE, "Allocation header is too small to hold an arena pointer and a size");
+	}
+
+	void* Scope::operator new(size_t size)
+	{
+		ScopeArena* arena = ScopeArena::Current();
+		std::byte* memory;
+		if (arena != nullptr)
+		{
+			memory = static_cast<std::byte*>(arena->Allocate(ALLOCATION_HEADER_SIZE + size));
+		}
+		else
+		{
+			memory = static_cast<std::byte*>(::operator new(ALLOCATION_HEADER_SIZE + size));
+		}
+		*reinterpret_cast<AllocationHeader*>(memory) = AllocationHeader{ arena, ALLOCATION_HEADER_SIZE + size };
+		return memory + ALLOCATION_HEADER_SIZE;
+	}
+
+	void Scope::operator delete(void* pointer) noexcept
+	{
+		if (pointer == nullptr)
+		{
+			return;
+		}
+
+		std::byte* memory = static_cast<std::byte*>(pointer) - ALLOCATION_HEADER_SIZE;
+		const AllocationHeader& header = *reinterpret_cast<AllocationHeader*>(memory);
+		if (header.mArena != nullptr)
+		{
+			header.mArena->Deallocate(memory, header.mSize);
+		}
+		else
+		{
+			::operator delete(memory);
+		}
+	}
+
 	Scope& Scope::operator=(const Scope& rhs)
 	{
 		if (this != &rhs)
@@ -85,30 +165,14 @@ namespace Library
 			}
 
 			Clear();
-			mTable = rhs.mTable;
-
-			//populate order vector
-			mOrderVector.Resize(rhs.Size());
-			for (size_t i = 0; i < rhs.mOrderVector.Size(); ++i)
-			{
-				auto result = mTable.Find(rhs.mOrderVector[i]->first);
-				assert(result != mTable.end());
-				mOrderVector[i] = &(*result);
-
-				Datum& dat = result->second;
-
-				//deep copy any children scope
-				if (dat.Type() == DatumType::Table)
-				{
-					for (size_t j = 0; j < dat.Size(); ++j)
-					{
-						//Scope* scope = new Scope(dat[j]);
-						Scope* scope = dat[j].Clone();
-						dat.Set(*scope, j);
-						scope->mParent = this;
-					}
-				}
-			}
+			mTable = MapType(rhs.mTable.Capacity());
+			mOrderVector.Clear();
+			mOrderVector.Reserve(rhs.Size());
+			mKeyFilter = rhs.mKeyFilter;
+			DeepCopy(rhs);
+			InvalidateSearches();	//the entries cached results pointed at are gone
+			MarkStructureChanged();
+			if (mTracksChanges) { TrackDatums(true); }	//tracking stays with this scope, and everything in it changed
 		}
 		return *this;
 	}
@@ -119,14 +183,22 @@ namespace Library
 		{
 			Clear();
 			mTable = std::move(rhs.mTable);
+			mKeyFilter = rhs.mKeyFilter;
 			mOrderVector = std::move(rhs.mOrderVector);
+			mDeferredLayout = rhs.mDeferredLayout;
+			rhs.mDeferredLayout = nullptr;
+			//tracking is never silently dropped: the datums moved with the table, and all of them changed
+			mTracksChanges = mTracksChanges || rhs.mTracksChanges;
+			if (mTracksChanges) { TrackDatums(true); }
 			mParent = rhs.mParent;
 			//reparent
 			if (mParent != nullptr)
 			{
-				auto result = mParent->FindContainedScope(rhs);
+				auto result = rhs.FindInParent();
 				result.first->Set(*this, result.second);
+				SetParent(*mParent, *result.first, result.second);
 				rhs.mParent = nullptr;
+				rhs.mParentDatum = nullptr;
 			}
 
 			for (const auto& pair : mOrderVector)
@@ -142,6 +214,11 @@ namespace Library
 					}
 				}
 			}
+			InvalidateSearches();
+			MarkStructureChanged();
+			if (mParent != nullptr) { mParent->MarkStructureChanged(); }
+			rhs.InvalidateSearches();
+			rhs.MarkStructureChanged();
 		}
 		return *this;
 	}
@@ -151,15 +228,22 @@ namespace Library
 		//early exits
 		if (this == &rhs) { return true; }
 		if (Size() != rhs.Size()) { return false; }
+		if (mHasStructuralHash && rhs.mHasStructuralHash && mStructuralHash != rhs.mStructuralHash) { return false; }
+		EnsureMaterialized();
+		rhs.EnsureMaterialized();
 
 		//otherwise search for each and compare datums (order does not matter)
-		for (auto it = mOrderVector.begin(); it != mOrderVector.end(); ++it)
+		for (size_t i = 0; i < mOrderVector.Size(); ++i)
 		{
-			if ((*it)->first == "this") { continue; }
-			auto datum = rhs.Find((*it)->first);
+			const PairType& pair = *mOrderVector[i];
+			if (pair.first == "this") { continue; }
+
+			//copies and instances of the same type append in the same order, so try the same position before hashing the key
+			const PairType& rhsPair = *rhs.mOrderVector[i];
+			const Datum* datum = (rhsPair.first == pair.first ? &rhsPair.second : rhs.Find(pair.first));
 			if (datum == nullptr) { return false; } //early exit. If nullptr, datum not found
 
-			if ((*it)->second != *datum) { return false; } //early exit, if datums do not match, not equal
+			if (pair.second != *datum) { return false; } //early exit, if datums do not match, not equal
 		}
 
 		//if here, all datums match, are equal
@@ -171,6 +255,159 @@ namespace Library
 		return !operator==(rhs);
 	}
 
+	std::size_t Scope::StructuralHash() const
+	{
+		if (mHasStructuralHash) { return mStructuralHash; }
+
+		//entries are summed rather than combined in order, because operator== does not care about order either
+		EnsureMaterialized();
+		std::size_t entries = 0;
+		bool cacheable = mTracksChanges;
+		for (const PairType* pair : mOrderVector)
+		{
+			if (pair->first == "this") { continue; }
+			const Datum& datum = pair->second;
+			entries += HashCombine(std::hash<std::string>{}(pair->first), datum.Hash());	//hashes, and caches, the children first
+
+			//this hash stays valid only while every datum under it reports its writes
+			cacheable = cacheable && !datum.mIsExternal;
+			if (cacheable && datum.Type() == DatumType::Table)
+			{
+				for (size_t i = 0; i < datum.Size(); ++i)
+				{
+					cacheable = cacheable && datum.mData.t[i]->mHasStructuralHash;
+				}
+			}
+		}
+
+		const std::size_t hash = HashCombine(Size(), entries);
+		if (cacheable)
+		{
+			mStructuralHash = hash;
+			mHasStructuralHash = true;
+		}
+		return hash;
+	}
+
+	void Scope::EnableChangeTracking()
+	{
+		mTracksChanges = true;
+		TrackDatums(false);
+	}
+
+	bool Scope::IsChangeTrackingEnabled() const noexcept
+	{
+		return mTracksChanges;
+	}
+
+	bool Scope::HasChanges() const noexcept
+	{
+		return mHasChanges;
+	}
+
+	void Scope::CollectChanges(Vector<Change>& changes)
+	{
+		if (!mHasChanges) { return; }
+		mHasChanges = false;
+
+		for (PairType* pair : mOrderVector)
+		{
+			Datum& datum = pair->second;
+			if (datum.mIsDirty)
+			{
+				datum.mIsDirty = false;
+				changes.PushBack(Change{ this, &pair->first, &datum });
+			}
+			if (datum.Type() == DatumType::Table)
+			{
+				for (size_t i = 0; i < datum.Size(); ++i)
+				{
+					datum.Get<Scope>(i).CollectChanges(changes);
+				}
+			}
+		}
+	}
+
+	void Scope::MarkChanged() noexcept
+	{
+		//an ancestor that already has changes has all of its ancestors flagged too
+		for (Scope* scope = this; scope != nullptr && !scope->mHasChanges; scope = scope->mParent)
+		{
+			scope->mHasChanges = true;
+		}
+	}
+
+	void Scope::InvalidateStructuralHash() noexcept
+	{
+		//an ancestor of a scope without a cached hash has none either, so the walk stops at the first scope without one
+		for (Scope* scope = this; scope != nullptr && scope->mHasStructuralHash; scope = scope->mParent)
+		{
+			scope->mHasStructuralHash = false;
+		}
+	}
+
+	void Scope::TrackDatums(bool markDirty)
+	{
+		for (PairType* pair : mOrderVector)
+		{
+			Datum& datum = pair->second;
+			datum.mOwner = this;
+			if (markDirty) { datum.MarkDirty(); }
+			if (datum.Type() == DatumType::Table)
+			{
+				for (size_t i = 0; i < datum.Size(); ++i)
+				{
+					Scope& child = datum.Get<Scope>(i);
+					if (!child.mTracksChanges) { child.EnableChangeTracking(); }
+				}
+			}
+		}
+	}
+
+	Vector<std::string> Scope::Diff(const Scope& lhs, const Scope& rhs)
+	{
+		Vector<std::string> paths;
+		DiffInto(lhs, rhs, std::string(), paths);
+		return paths;
+	}
+
+	void Scope::DiffInto(const Scope& lhs, const Scope& rhs, const std::string& prefix, Vector<std::string>& paths)
+	{
+		lhs.EnsureMaterialized();
+		rhs.EnsureMaterialized();
+		for (const PairType* pair : lhs.mOrderVector)
+		{
+			if (pair->first == "this") { continue; }
+
+			const Datum& datum = pair->second;
+			const Datum* other = rhs.Find(pair->first);
+			if (other == nullptr)
+			{
+				paths.PushBack(prefix + pair->first);
+			}
+			else if (datum.Type() == DatumType::Table && other->Type() == DatumType::Table && datum.Size() == other->Size())
+			{
+				for (size_t i = 0; i < datum.Size(); ++i)
+				{
+					DiffInto(datum.Get<Scope>(i), other->Get<Scope>(i), prefix + pair->first + "[" + std::to_string(i) + "].", paths);
+				}
+			}
+			else if (datum != *other)
+			{
+				paths.PushBack(prefix + pair->first);
+			}
+		}
+
+		//entries only rhs has
+		for (const PairType* pair : rhs.mOrderVector)
+		{
+			if (pair->first != "this" && lhs.Find(pair->first) == nullptr)
+			{
+				paths.PushBack(prefix + pair->first);
+			}
+		}
+	}
+
 	size_t Scope::Capacity() const noexcept
 	{
 		return mTable.Capacity();
@@ -178,7 +415,7 @@ namespace Library
 
 	size_t Scope::Size() const noexcept
 	{
-		return mTable.Size();
+		return (mDeferredLayout != nullptr ? mDeferredLayout->Size() : mTable.Size());
 	}
 
 	bool Scope::IsEmpty() const noexcept
@@ -197,19 +434,38 @@ namespace Library
 		{
 			if (name.empty()) { throw std::runtime_error("Name cannot be empty"); }
 			Datum& dat = Append(name);
-			dat.PushBack(child); //will throw exception if datum is not type table or unknown
+			dat.TypeCheckOrUnknown(DatumType::Table); //throw before orphaning if datum is not type table or unknown
 			child.Orphan(); //always orphan to prevent memory leaks
-			child.mParent = this;
+			dat.PushBack(child);
+			child.SetParent(*this, dat, dat.Size() - 1);
+			if (mTracksChanges && !child.mTracksChanges) { child.EnableChangeTracking(); }
+			if (child.mHasChanges) { MarkChanged(); }
+			child.InvalidateSearches();
+			MarkStructureChanged();
 		}
 	}
 
 	void Scope::Orphan()
 	{
 		if (mParent == nullptr) { return; }
-		auto result = mParent->FindContainedScope(*this);
-		assert(result.first != nullptr);
-		result.first->RemoveAt(result.second);	//remove this scope from the datum
+		RemoveFromParent();
+		InvalidateSearches();
+	}
+
+	void Scope::RemoveFromParent()
+	{
+		if (mParent == nullptr) { return; }
+		auto result = FindInParent();
+		//later siblings shift down a slot to keep their order, and the datum updates their back references.
+		//Code outside Scope may already have removed this scope from the datum, then there is only the parent to forget.
+		if (result.first != nullptr)
+		{
+			result.first->RemoveAt(result.second);
+		}
+
+		mParent->MarkStructureChanged();
 		mParent = nullptr;
+		mParentDatum = nullptr;
 	}
 
 	Datum& Scope::Append(const std::string& name)
@@ -221,12 +477,21 @@ namespace Library
 	Datum& Scope::Append(const std::string& name, bool& EntryCreated)
 	{
 		if (name.empty()) { throw std::runtime_error("Name cannot be empty"); }
+		EnsureMaterialized();	//prescribed entries come before anything appended
 		auto result = mTable.Insert(std::make_pair(name, Datum())); //returns pair<It, bool>
 		auto& pair = *result.first;
 		EntryCreated = result.second;
 		if (EntryCreated)
 		{
 			mOrderVector.PushBack(&pair);
+			mKeyFilter |= KeyFilterBits(name);
+			InvalidateSearches();	//the new entry may hide one further up the hierarchy from searches here and below
+			MarkStructureChanged();
+			if (mTracksChanges)
+			{
+				pair.second.mOwner = this;
+				pair.second.MarkDirty();	//a new attribute is a change
+			}
 		}
 		return pair.second;
 	}
@@ -243,14 +508,97 @@ namespace Library
 		Scope* child;
 		Datum& dat = Append(name, EntryCreated);
 		dat.TypeCheckOrUnknown(DatumType::Table); //makes sure type is either unknown or scope
-		child = new Scope();
-		child->mParent = this;
+		child = new Scope(CapacityProfile::ScopeCapacity());
 		dat.PushBack(*child);	//will throw exception if datum is not type scope or unknown
+		child->SetParent(*this, dat, dat.Size() - 1);
+		MarkStructureChanged();
+		if (mTracksChanges) { child->EnableChangeTracking(); }
 		return *child;
 	}
 
+	Vector<Datum*> Scope::AppendEntries(const Vector<std::string>& names)
+	{
+		EnsureMaterialized();
+		ReserveEntries(names.Size());
+		Vector<Datum*> datums(names.Size());
+		for (const std::string& name : names)
+		{
+			datums.PushBack(&Append(name));
+		}
+		return datums;
+	}
+
+	void Scope::AppendEntries(Vector<std::pair<std::string, Datum>>&& entries)
+	{
+		for (const auto& entry : entries)
+		{
+			if (entry.first.empty()) { throw std::runtime_error("Name cannot be empty"); }
+			if (entry.second.Type() == DatumType::Table && entry.second.Size() > 0) { throw std::runtime_error("Cannot append a datum holding scopes"); }
+		}
+
+		EnsureMaterialized();
+		ReserveEntries(entries.Size());
+		const size_t firstNew = mOrderVector.Size();
+		for (auto& entry : entries)
+		{
+			auto result = mTable.Insert(std::make_pair(entry.first, Datum()));
+			if (!result.second)
+			{
+				//take back everything this call appended so the scope is left as it was
+				while (mOrderVector.Size() > firstNew)
+				{
+					mTable.Remove(mOrderVector[mOrderVector.Size() - 1]->first);
+					mOrderVector.PopBack();
+				}
+				throw std::runtime_error("Duplicate key: " + entry.first);
+			}
+			mOrderVector.PushBack(&(*result.first));
+		}
+
+		//every key is in, now move the datums over
+		for (size_t i = 0; i < entries.Size(); ++i)
+		{
+			PairType& pair = *mOrderVector[firstNew + i];
+			pair.second = std::move(entries[i].second);
+			mKeyFilter |= KeyFilterBits(pair.first);
+			if (mTracksChanges)
+			{
+				pair.second.mOwner = this;
+				pair.second.MarkDirty();	//a new attribute is a change
+			}
+		}
+		if (!entries.IsEmpty())
+		{
+			InvalidateSearches();
+			MarkStructureChanged();
+		}
+	}
+
+	Vector<Scope*> Scope::AppendScopes(const Vector<std::string>& names)
+	{
+		EnsureMaterialized();
+		ReserveEntries(names.Size());
+		Vector<Scope*> scopes(names.Size());
+		for (const std::string& name : names)
+		{
+			scopes.PushBack(&AppendScope(name));
+		}
+		return scopes;
+	}
+
+	void Scope::ReserveEntries(size_t count)
+	{
+		//the table never rehashes, so it can only be given more buckets while nothing points into it
+		if (mTable.Size() == 0 && count > mTable.Capacity())
+		{
+			mTable = MapType(count);
+		}
+		mOrderVector.Reserve(mOrderVector.Size() + count);
+	}
+
 	Datum* Scope::Find(const std::string& name)
 	{
+		EnsureMaterialized();
 		auto tableIt = mTable.Find(name);
 		if (tableIt == mTable.end()) { return nullptr; }
 		return &(*tableIt).second;
@@ -258,6 +606,7 @@ namespace Library
 
 	const Datum* Scope::Find(const std::string& name) const
 	{
+		EnsureMaterialized();
 		auto tableIt = mTable.Find(name);
 		if (tableIt == mTable.end()) { return nullptr; }
 		return &(*tableIt).second;
@@ -305,27 +654,61 @@ namespace Library
 
 	Datum& Scope::operator[](size_t index)
 	{
+		EnsureMaterialized();
 		return mOrderVector[index]->second;
 	}
 
 	const Datum& Scope::operator[](size_t index) const
 	{
+		EnsureMaterialized();
 		return mOrderVector[index]->second;
 	}
 
 	Datum* Scope::Search(const std::string& key, Scope** foundScope)
 	{
-		auto result = Find(key);
-		if (result != nullptr)
+		const std::uint64_t version = SearchVersion();
+		if (mSearchCache != nullptr)
 		{
-			if (foundScope != nullptr) { *foundScope = this; }
-			return result;
+			auto cached = mSearchCache->Find(key);
+			if (cached != mSearchCache->end() && cached->second.mVersion == version)
+			{
+				if (foundScope != nullptr) { *foundScope = cached->second.mScope; }
+				return cached->second.mDatum;
+			}
+		}
+
+		//walk up the hierarchy, only hashing into scopes whose filter says they might have the key
+		SearchCacheEntry entry;
+		entry.mVersion = version;
+		const std::uint64_t keyBits = KeyFilterBits(key);
+		for (Scope* scope = this; scope != nullptr && entry.mDatum == nullptr; scope = scope->mParent)
+		{
+			//a deferred scope's keys are all in its layout, so it only has to materialize if the key might be one of them
+			const std::uint64_t filter = scope->mKeyFilter | (scope->mDeferredLayout != nullptr ? scope->mDeferredLayout->mKeyFilter : 0);
+			if ((filter & keyBits) == keyBits)
+			{
+				scope->EnsureMaterialized();
+				entry.mDatum = scope->Find(key);
+				entry.mScope = (entry.mDatum != nullptr ? scope : nullptr);
+			}
+		}
+
+		//misses are not cached, so searching for many keys that do not exist cannot grow the cache
+		if (entry.mDatum != nullptr)
+		{
+			if (mSearchCache == nullptr)
+			{
+				mSearchCache = std::make_unique<SearchCacheType>();
+			}
+			else if (mSearchCache->Size() >= MAX_CACHED_SEARCHES && !mSearchCache->ContainsKey(key))
+			{
+				mSearchCache->Clear();
+			}
+			(*mSearchCache)[key] = entry;
 		}
-		
-		//if here not found in this scope, search parent
-		if (mParent != nullptr) { return mParent->Search(key, foundScope); }
-		if (foundScope != nullptr) { *foundScope = nullptr; }
-		return nullptr;
+
+		if (foundScope != nullptr) { *foundScope = entry.mScope; }
+		return entry.mDatum;
 	}
 
 	const Datum* Scope::Search(const std::string& key, Scope** foundScope) const
@@ -346,22 +729,340 @@ namespace Library
 		return new Scope(*this);
 	}
 
+	gsl::owner<Scope*> Scope::Relocate()
+	{
+		return RelocateAs(*this);
+	}
+
+	void Scope::ChildRelocated([[maybe_unused]] const Scope& old, [[maybe_unused]] Scope& relocated)
+	{
+	}
+
+	void Scope::Quiesce()
+	{
+	}
+
+	std::pair<Datum*, size_t> Scope::FindInParent() const
+	{
+		assert(mParent != nullptr);
+
+		//the back reference is only wrong if code outside Scope rearranged the parent's datum, so check it before trusting it
+		if (mParentDatum != nullptr && mParentIndex < mParentDatum->Size() && &mParentDatum->Get<Scope>(mParentIndex) == this)
+		{
+			return std::make_pair(mParentDatum, mParentIndex);
+		}
+		return mParent->FindContainedScope(*this);
+	}
+
+	void Scope::SetParent(Scope& parent, Datum& datum, size_t index) noexcept
+	{
+		mParent = &parent;
+		mParentDatum = &datum;
+		mParentIndex = index;
+	}
+
+	std::uint64_t Scope::SearchVersion() const noexcept
+	{
+		//stamps only grow, so the newest one on the way up changes whenever any scope on the way is stamped or the way itself changes
+		std::uint64_t version = 0;
+		for (const Scope* scope = this; scope != nullptr; scope = scope->mParent)
+		{
+			version = std::max(version, scope->mSearchVersion);
+		}
+		return version;
+	}
+
+	std::uint64_t Scope::StructureVersion() const noexcept
+	{
+		return mStructureVersion;
+	}
+
+	void Scope::InvalidateSearches() noexcept
+	{
+		//descendants check the stamp when they next search, see SearchVersion
+		mSearchVersion = NextVersion();
+	}
+
+	void Scope::MarkStructureChanged() noexcept
+	{
+		//only this scope: walking the ancestors would make every append to a deep tree cost its depth
+		mStructureVersion = NextVersion();
+	}
+
+	std::uint64_t Scope::NextVersion() noexcept
+	{
+		return sNextVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+
+	std::uint64_t Scope::KeyFilterBits(const std::string& key)
+	{
+		//two bits from one hash keeps false positives low for the handful of keys a scope usually has
+		const size_t hash = std::hash<std::string>{}(key);
+		return (std::uint64_t(1) << (hash & 63)) | (std::uint64_t(1) << ((hash >> 6) & 63));
+	}
+
+	void Scope::DeepCopy(const Scope& rhs)
+	{
+		assert(mTable.Size() == 0 && mOrderVector.IsEmpty());
+
+		//a deferred layout means rhs is still empty, the copy can stay deferred too
+		mDeferredLayout = rhs.mDeferredLayout;
+
+		//rebuild the table and order vector in one pass over rhs's order: keys are already unique, so each costs one hash and no search
+		for (PairType* pair : rhs.mOrderVector)
+		{
+			auto result = mTable.InsertUnique(*pair);
+			mOrderVector.PushBack(&(*result));
+
+			Datum& dat = result->second;
+
+			//deep copy any children scope
+			if (dat.Type() == DatumType::Table)
+			{
+				for (size_t j = 0; j < dat.Size(); ++j)
+				{
+					Scope* scope = dat[j].Clone();
+					dat.Set(*scope, j);
+					scope->SetParent(*this, dat, j);
+				}
+			}
+		}
+	}
+
+	void Scope::Materialize()
+	{
+		if (mDeferredLayout == nullptr) { return; }
+		const Layout& layout = *mDeferredLayout;
+		mDeferredLayout = nullptr;
+
+		//the entries existed as far as any search could tell (see Search), so nothing cached is invalidated by them appearing
+		ReserveEntries(layout.Capacity());
+		InsertLayout(layout);
+		if (mTracksChanges) { TrackDatums(false); }
+	}
+
+	void Scope::EnsureMaterialized() const
+	{
+		if (mDeferredLayout != nullptr)
+		{
+			const_cast<Scope*>(this)->Materialize();
+		}
+	}
+
+	bool Scope::IsMaterialized() const noexcept
+	{
+		return mDeferredLayout == nullptr;
+	}
+
+	void Scope::InsertLayout(const Layout& layout)
+	{
+		assert(mTable.Size() == 0);
+		for (size_t i = 0; i < layout.Size(); ++i)
+		{
+			auto it = mTable.InsertUnique(layout.mEntries[i], layout.mHashes[i]);
+			mOrderVector.PushBack(&(*it));
+		}
+		mKeyFilter |= layout.mKeyFilter;
+	}
+
 	void Scope::Clear()
 	{
-		for (auto it = mTable.begin(); it != mTable.end(); ++it)
+		//detach every descendant first, using the list as a queue, then delete them.
+		//Each destructor then finds no children, so deleting a deep tree does not recurse through every level.
+		Vector<Scope*> descendants;
+		DetachChildren(descendants);
+		for (size_t i = 0; i < descendants.Size(); ++i)
+		{
+			descendants[i]->DetachChildren(descendants);
+		}
+
+		for (Scope* scope : descendants)
 		{
-			Datum& datum = it->second;
-			//if datum is a table, iterate through and delete children
+			delete(scope);
+		}
+	}
+
+	void Scope::AppendChildren(Vector<Scope*>& children) const
+	{
+		for (const PairType* pair : mOrderVector)
+		{
+			const Datum& datum = pair->second;
 			if (datum.Type() == DatumType::Table)
 			{
 				for (size_t i = 0; i < datum.Size(); ++i)
 				{
-					Scope* scope = &datum.Get<Scope>(i);
+					children.PushBack(datum.mData.t[i]);
+				}
+			}
+		}
+	}
+
+	void Scope::DetachChildren(Vector<Scope*>& children)
+	{
+		for (PairType* pair : mOrderVector)
+		{
+			Datum& datum = pair->second;
+			if (datum.Type() == DatumType::Table)
+			{
+				for (size_t i = 0; i < datum.Size(); ++i)
+				{
+					Scope* scope = datum.mData.t[i];
 					assert(scope->mParent == this);
 					scope->mParent = nullptr;
-					delete(scope);
+					children.PushBack(scope);
+				}
+				datum.Clear();	//so a second Clear (e.g. a derived destructor then ~Scope) does not find the children again
+			}
+		}
+	}
+
+	void Scope::Traverse(const VisitorType& visitor, TraversalOrder order, const DescendPredicateType& shouldDescend)
+	{
+		if (order == TraversalOrder::BreadthFirst)
+		{
+			//the list is the queue: everything before next has been visited
+			Vector<Scope*> queue;
+			queue.PushBack(this);
+			for (size_t next = 0; next < queue.Size(); ++next)
+			{
+				Scope& scope = *queue[next];
+				visitor(scope);
+				if (!shouldDescend || shouldDescend(scope))
+				{
+					scope.AppendChildren(queue);
 				}
 			}
+			return;
+		}
+
+		//in post order a scope stays on the stack, marked expanded, underneath its children until they are done
+		Vector<std::pair<Scope*, bool>> stack;
+		Vector<Scope*> children;
+		stack.PushBack(std::make_pair(this, false));
+		while (!stack.IsEmpty())
+		{
+			auto [scope, expanded] = stack[stack.Size() - 1];
+			stack.PopBack();
+			if (expanded)
+			{
+				visitor(*scope);
+				continue;
+			}
+
+			if (order == TraversalOrder::PreOrder)
+			{
+				visitor(*scope);
+			}
+			else
+			{
+				stack.PushBack(std::make_pair(scope, true));
+			}
+
+			if (!shouldDescend || shouldDescend(*scope))
+			{
+				//pushed last child first, so the first child is visited first
+				children.Clear();
+				scope->AppendChildren(children);
+				for (size_t i = children.Size(); i > 0; --i)
+				{
+					stack.PushBack(std::make_pair(children[i - 1], false));
+				}
+			}
+		}
+	}
+
+	void Scope::Compact(ScopeArena& arena)
+	{
+		ScopeArena::Activation activation(arena);
+		//each popped scope is relocated before its children are pushed, and siblings are pushed in reverse, so allocation is in pre-order
+		Vector<Scope*> pending;
+		Vector<Scope*> children;
+		AppendChildren(children);
+		for (size_t i = children.Size(); i > 0; --i) { pending.PushBack(children[i - 1]); }
+		while (!pending.IsEmpty())
+		{
+			Scope* old = pending[pending.Size() - 1];
+			pending.PopBack();
+			Scope& parent = *old->mParent;
+			auto [datum, index] = old->FindInParent();
+			old->mParent = nullptr;	//relinked below without Set: the contents have not changed
+			old->mParentDatum = nullptr;
+			Scope* relocated = old->Relocate();	//the move constructors relink the children and external storage
+			datum->mData.t[index] = relocated;
+			relocated->SetParent(parent, *datum, index);
+			//a scope without a move constructor was cloned along with its subtree, which is then already in pre-order in the arena
+			const bool cloned = !old->mOrderVector.IsEmpty();
+			parent.ChildRelocated(*old, *relocated);
+			delete(old);
+			if (cloned)
+			{
+				if (parent.mTracksChanges) { relocated->EnableChangeTracking(); }
+				continue;
+			}
+
+			children.Clear();
+			relocated->AppendChildren(children);
+			for (size_t i = children.Size(); i > 0; --i) { pending.PushBack(children[i - 1]); }
+		}
+		//searches from here up are unaffected and the relocated scopes have no cached searches, but paths through this scope now lead elsewhere
+		MarkStructureChanged();
+		InvalidateStructuralHash();	//the hash is the same, but the relocated scopes have none cached, and no scope above one without may keep one
+	}
+
+	void Scope::TraverseParallel(const VisitorType& visitor, TraversalOrder order, const DescendPredicateType& shouldDescend)
+	{
+		if (order != TraversalOrder::PostOrder)
+		{
+			visitor(*this);
+		}
+
+		if (!shouldDescend || shouldDescend(*this))
+		{
+			//searches from the subtrees only read the scopes above them, provided none of those still has to materialize
+			for (const Scope* scope = this; scope != nullptr; scope = scope->mParent)
+			{
+				scope->EnsureMaterialized();
+			}
+
+			Vector<Scope*> children;
+			AppendChildren(children);
+
+			//one task per core at most, each taking every taskCount'th subtree
+			const size_t taskCount = std::min<size_t>(children.Size(), std::max(1u, std::thread::hardware_concurrency()));
+			Vector<std::future<void>> futures(taskCount);
+			for (size_t task = 0; task < taskCount; ++task)
+			{
+				futures.PushBack(std::async(std::launch::async, [&children, &visitor, &shouldDescend, order, task, taskCount]()
+				{
+					for (size_t i = task; i < children.Size(); i += taskCount)
+					{
+						children[i]->Traverse(visitor, order, shouldDescend);
+					}
+				}));
+			}
+
+			//every task has to finish before returning, they reference the visitor and the list of children
+			std::exception_ptr exception;
+			for (auto& future : futures)
+			{
+				try
+				{
+					future.get();
+				}
+				catch (...)
+				{
+					if (exception == nullptr) { exception = std::current_exception(); }
+				}
+			}
+			if (exception != nullptr)
+			{
+				std::rethrow_exception(exception);
+			}
+		}
+
+		if (order == TraversalOrder::PostOrder)
+		{
+			visitor(*this);
 		}
 	}
 }
\ No newline at end of file
@@ -4,18 +4,76 @@
 #include "Hashmap.h"
 #include "vector.h"
 #include <string>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <functional>
 #include <gsl/gsl>
 
 
 namespace Library
 {
+	class ScopeArena; //forward declaration
+	class ScopeReclaimer; //forward declaration
+	class CapacityProfile; //forward declaration
+
+	/// <summary>
+	/// The order Scope::Traverse visits a tree in
+	/// </summary>
+	enum class TraversalOrder
+	{
+		PreOrder,	//a scope, then each of its subtrees
+		PostOrder,	//each subtree, then the scope
+		BreadthFirst	//every scope at one depth before any deeper one
+	};
+
 	class Scope : public RTTI
 	{
 		RTTI_DECLARATIONS(Scope, RTTI)
+		friend Datum;
+		friend ScopeReclaimer;
+		friend CapacityProfile;
 
 		//using PairType = std::pair<const std::string, Datum>;
 	public:
 		static const size_t DEFAULT_CAPACITY = 5;	//default capacity
+		using VisitorType = std::function<void(Scope&)>;
+		using DescendPredicateType = std::function<bool(const Scope&)>;
+
+		/// <summary>
+		/// A prebuilt list of entries that scopes can start out with, e.g. the prescribed attributes of an Attributed type (see TypeRegistry).
+		/// Keys are checked and hashed once, when the layout is built, so a scope made from it only copies.
+		/// </summary>
+		class Layout final
+		{
+			friend Scope;
+		public:
+			/// <summary>
+			/// Constructor: builds a layout from entries, kept in order
+			/// </summary>
+			/// <param name="entries">the names and datums to start scopes with. The datums are moved from.</param>
+			/// <param name="capacity">the number of entries scopes made from the layout make room for, if more than entries holds (see CapacityProfile)</param>
+			/// <exception cref="std::runtime_error">Throws exception if a name is empty or repeated, or if a datum holds scopes</exception>
+			explicit Layout(Vector<std::pair<std::string, Datum>>&& entries, size_t capacity = 0);
+
+			/// <summary>
+			/// The number of entries in the layout
+			/// </summary>
+			/// <returns>The number of entries a scope made from this layout starts with</returns>
+			size_t Size() const noexcept;
+
+			/// <summary>
+			/// The number of entries a scope made from this layout has room for before its table fills up
+			/// </summary>
+			/// <returns>The capacity given at construction, or Size if that is larger</returns>
+			size_t Capacity() const noexcept;
+
+		private:
+			Vector<std::pair<const std::string, Datum>> mEntries;
+			Vector<size_t> mHashes;	//the table's hash of each key
+			std::uint64_t mKeyFilter = 0;	//the key filter bits of every key
+			size_t mCapacity;
+		};
 
 		/// <summary>
 		/// Constructor
@@ -43,6 +101,19 @@ namespace Library
 		/// </summary>
 		virtual ~Scope();
 
+		/// <summary>
+		/// Allocates a scope from the active ScopeArena, or from the heap if there is none
+		/// </summary>
+		/// <param name="size">the size of the scope being allocated</param>
+		/// <returns>Memory for the scope</returns>
+		static void* operator new(size_t size);
+
+		/// <summary>
+		/// Returns a scope's memory to the arena or heap it was allocated from
+		/// </summary>
+		/// <param name="pointer">memory returned by operator new</param>
+		static void operator delete(void* pointer) noexcept;
+
 		/// <summary>
 		/// Copy Assignment Operator: Deep copies rhs into this scope
 		/// </summary>
@@ -71,6 +142,97 @@ namespace Library
 		/// <returns>false if the contents of this scope = scope.rhs, true otherwise</returns>
 		bool operator!=(const Scope& rhs);
 
+		/// <summary>
+		/// Hashes the keys and datums of this scope and, through its tables, of every descendant (a Merkle style hash of the tree).
+		/// Scopes that are equal have the same hash, so hashes can be computed once and compared to rule out equality cheaply.
+		/// </summary>
+		/// <returns>A hash of the structure and contents of this tree</returns>
+		/// <remarks>
+		/// Cached in scopes that track changes (see EnableChangeTracking), where every write through a datum drops the cached hash of its scope and ancestors,
+		/// so recomputing after a change only rehashes the scopes on the path to it. Scopes holding external storage are hashed every time,
+		/// as their C++ members are written without going through a datum, and so are scopes that do not track changes.
+		/// </remarks>
+		std::size_t StructuralHash() const;
+
+		/// <summary>
+		/// Lists the paths, in ScopePath syntax (e.g. "Entities[1].Health"), of the attributes that differ between lhs and rhs.
+		/// Tables of the same size are compared child by child, anything else is reported as a whole.
+		/// </summary>
+		/// <param name="lhs">the first scope to compare</param>
+		/// <param name="rhs">the second scope to compare</param>
+		/// <returns>The paths of the attributes that differ, or are only in one of the scopes. Empty if lhs == rhs.</returns>
+		static Vector<std::string> Diff(const Scope& lhs, const Scope& rhs);
+
+		/// <summary>
+		/// A datum that changed since changes were last collected, and where it is
+		/// </summary>
+		struct Change
+		{
+			Scope* mScope;	//the scope holding the datum
+			const std::string* mName;	//the datum's key in mScope
+			Datum* mDatum;
+		};
+
+		/// <summary>
+		/// Starts tracking changes to the datums of this scope and its descendants, including scopes added to the tree later.
+		/// A change marks the datum dirty and flags its scope and every ancestor, so CollectChanges only visits the parts of the tree that changed.
+		/// </summary>
+		void EnableChangeTracking();
+
+		/// <summary>
+		/// Whether changes to this scope are tracked
+		/// </summary>
+		/// <returns>True if EnableChangeTracking was called on this scope or an ancestor it was in at the time, or it was added to such a tree</returns>
+		bool IsChangeTrackingEnabled() const noexcept;
+
+		/// <summary>
+		/// Whether a datum in this scope or a descendant has changed since changes were last collected
+		/// </summary>
+		/// <returns>True if there are changes to collect</returns>
+		bool HasChanges() const noexcept;
+
+		/// <summary>
+		/// Appends every dirty datum in this scope and its descendants to changes and marks them clean. Subtrees without changes are skipped.
+		/// </summary>
+		/// <param name="changes">the list to append the changes to</param>
+		/// <remarks>Changes point into the tree, they are valid until a scope is deleted or an entry moves</remarks>
+		void CollectChanges(Vector<Change>& changes);
+
+		/// <summary>
+		/// Calls visitor on this scope and every descendant, children in the order their entries were appended.
+		/// Uses an explicit stack or queue rather than recursion, so the depth of the tree does not matter.
+		/// </summary>
+		/// <param name="visitor">called once for each scope. Must not add, remove or move scopes in this tree.</param>
+		/// <param name="order">the order to visit scopes in</param>
+		/// <param name="shouldDescend">if given, the children of a scope it returns false for are skipped. Called after visiting the scope, except in post order.</param>
+		void Traverse(const VisitorType& visitor, TraversalOrder order = TraversalOrder::PreOrder, const DescendPredicateType& shouldDescend = DescendPredicateType());
+
+		/// <summary>
+		/// Like Traverse, but the subtrees of this scope's children are traversed on worker threads, split evenly between at most one task per core.
+		/// This scope is visited on the calling thread, first or (in post order) last. The order only applies within each subtree.
+		/// </summary>
+		/// <param name="visitor">called once for each scope. Called concurrently for scopes in different subtrees, so it must only touch the scope it is given and its own subtree.
+		/// It may write to datums, with or without change tracking, append to the scope and search from it: the flags those set on shared ancestors are atomic,
+		/// this scope and its ancestors are materialized before the tasks start, and datums sharing storage count their sharers atomically.
+		/// It must not delete scopes allocated from a ScopeArena, which is not thread safe.</param>
+		/// <param name="order">the order to visit scopes in within each subtree</param>
+		/// <param name="shouldDescend">if given, the children of a scope it returns false for are skipped. Called concurrently like visitor.</param>
+		/// <exception cref="std::exception">Rethrows the first exception thrown by a visitor, after every task has finished</exception>
+		void TraverseParallel(const VisitorType& visitor, TraversalOrder order = TraversalOrder::PreOrder, const DescendPredicateType& shouldDescend = DescendPredicateType());
+
+		/// <summary>
+		/// Relocates every descendant of this scope into arena, in pre-order, so a traversal walks forward through contiguous memory.
+		/// Each descendant is move constructed into the arena, see Relocate, and the emptied original is deleted, so parent pointers,
+		/// children and attributed external storage are relinked by the move constructors. This scope itself does not move.
+		/// </summary>
+		/// <param name="arena">the arena to allocate the relocated scopes from</param>
+		/// <remarks>
+		/// Descendants are new objects afterwards: pointers and references to them, to their datums, and ScopePaths through them are invalidated.
+		/// Collect changes first.
+		/// Only the scope objects are contiguous, their datum arrays and hashmap nodes are still separate heap allocations.
+		/// </remarks>
+		void Compact(ScopeArena& arena);
+
 		/// <summary>
 		/// Returns the capacity of the table
 		/// </summary>
@@ -89,6 +251,12 @@ namespace Library
 		/// <returns>Returns true if there are no elements in the scope, false otherwise</returns>
 		bool IsEmpty() const noexcept;
 
+		/// <summary>
+		/// Whether this scope's layout entries are in its table, see Materialize
+		/// </summary>
+		/// <returns>False if the entries are still deferred, true otherwise</returns>
+		bool IsMaterialized() const noexcept;
+
 		/// <summary>
 		/// Returns the address of the parent of this scope
 		/// </summary>
@@ -108,6 +276,7 @@ namespace Library
 		/// <summary>
 		/// Removes this scope from another scope.
 		/// Sets this scope's parent to nullptr and removes self from the parent entry.
+		/// Finds itself in the parent through a back reference rather than searching the parent's table. Later siblings in the same entry keep their order.
 		/// NOTE: Because children are heap allocated, this means this scope must now be adopted by another scope, or must later be deleted to prevent memory leaks
 		/// </summary>
 		void Orphan();
@@ -150,6 +319,33 @@ namespace Library
 		/// <remarks>This will always make a new scope (not return the existing) </remarks>
 		Scope& AppendScope(const std::string& name, bool& EntryCreated);
 
+		/// <summary>
+		/// Appends an entry for each name, like Append, reserving room for all of them first.
+		/// </summary>
+		/// <param name="names">the names of the entries to append</param>
+		/// <returns>The datum for each name, in the same order. Existing entries are returned as they are.</returns>
+		/// <exception cref="std::runtime_error">Throws exception if a name is empty. Entries before it have been appended.</exception>
+		Vector<Datum*> AppendEntries(const Vector<std::string>& names);
+
+		/// <summary>
+		/// Appends a new entry for each pair, moving its datum in, reserving room for all of them first.
+		/// Duplicates are found while inserting, so each key is hashed and searched for once.
+		/// </summary>
+		/// <param name="entries">the names and datums to append. The datums are moved from.</param>
+		/// <exception cref="std::runtime_error">
+		/// Throws exception if a name is empty, already in this scope or repeated, or if a datum holds scopes (use AppendScopes or Adopt).
+		/// Nothing is appended if it throws.
+		/// </exception>
+		void AppendEntries(Vector<std::pair<std::string, Datum>>&& entries);
+
+		/// <summary>
+		/// Appends a new scope under each name, like AppendScope, reserving room for all of them first.
+		/// </summary>
+		/// <param name="names">the names of the entries to append a scope to. A repeated name gets a scope for each time it appears.</param>
+		/// <returns>The new scopes, in the same order as names</returns>
+		/// <exception cref="std::runtime_error">Throws exception if a name is empty or its entry holds something other than scopes. Scopes before it have been appended.</exception>
+		Vector<Scope*> AppendScopes(const Vector<std::string>& names);
+
 		/// <summary>
 		/// Finds the address of the datum with the given name in this scope.
 		/// </summary>
@@ -212,6 +408,7 @@ namespace Library
 
 		/// <summary>
 		/// Searches for and returns the address of the most closely nested Datum associated with the given name in this scope or its ancestors.
+		/// Hits are cached per scope, and a cached hit is used while SearchVersion is unchanged. Misses are not cached.
 		/// </summary>
 		/// <param name="key">The name of the datum to search for</param>
 		/// <param name="foundScope">Out parameter for the scope the datum was found in</param>
@@ -226,6 +423,21 @@ namespace Library
 		/// <returns>The address of the most closely nested Datum associated with the given name, or nullptr if it does not exist</returns>
 		const Datum* Search(const std::string& key, Scope** foundScope = nullptr) const;
 
+		/// <summary>
+		/// A stamp that changes whenever a Search from this scope could find something else: an entry was added to this scope or an ancestor,
+		/// or this scope or an ancestor changed parent. Changes elsewhere in the hierarchy leave it alone.
+		/// Worked out from this scope and its ancestors when asked, so it costs the depth of the scope and changes leave the descendants untouched.
+		/// </summary>
+		/// <returns>The current search version of this scope</returns>
+		std::uint64_t SearchVersion() const noexcept;
+
+		/// <summary>
+		/// A stamp that changes whenever an entry is added to this scope, or a child scope joins, leaves or is relocated within one of its entries.
+		/// Changes further down leave it alone. Anything that caches a lookup through this scope (e.g. ScopePath) is still valid for this step while it has not changed.
+		/// </summary>
+		/// <returns>The current structure version of this scope</returns>
+		std::uint64_t StructureVersion() const noexcept;
+
 		/// <summary>
 		/// Overload of RTTI Equals. 
 		/// </summary>
@@ -239,7 +451,57 @@ namespace Library
 		/// <returns>a heap allocated copy of this</returns>
 		virtual gsl::owner<Scope*> Clone() const;
 
+		/// <summary>
+		/// Move constructs a new heap (or active arena) allocated scope of this one's type, leaving this one empty and parentless.
+		/// The new scope takes this one's slot in its parent and its children. Classes without a move constructor are cloned instead.
+		/// </summary>
+		/// <returns>the relocated scope, which owns this one's contents</returns>
+		virtual gsl::owner<Scope*> Relocate();
+
 	protected:
+		/// <summary>
+		/// Relocate for a class T: moves scope into a new T if it is exactly a T, else clones it, since moving a class derived from T as a T would slice it
+		/// </summary>
+		/// <param name="scope">the scope to relocate</param>
+		/// <returns>the relocated scope</returns>
+		template <typename T>
+		static gsl::owner<Scope*> RelocateAs(T& scope)
+		{
+			if (scope.TypeIdInstance() != T::TypeIdClass()) { return scope.Clone(); }
+			return new T(std::move(scope));
+		}
+
+		/// <summary>
+		/// Constructor: starts with a copy of each entry in layout, with a table sized for them
+		/// </summary>
+		/// <param name="layout">the entries to copy in</param>
+		/// <param name="deferred">whether to leave the table empty and copy the entries in on first access instead, see Materialize. layout must then outlive the scope.</param>
+		explicit Scope(const Layout& layout, bool deferred = false);
+
+		/// <summary>
+		/// Called by Compact after a child of this scope is relocated, before old is deleted. Override to repoint anything holding on to old.
+		/// </summary>
+		/// <param name="old">the child that was relocated, now empty and parentless</param>
+		/// <param name="relocated">the child that took its place</param>
+		virtual void ChildRelocated(const Scope& old, Scope& relocated);
+
+		/// <summary>
+		/// Called on every scope of a subtree handed to ScopeReclaimer::Defer, before it is detached, as the scopes may wait several updates to be deleted.
+		/// Override to let go of anything outside the tree that could still call into this scope, such as event subscriptions.
+		/// </summary>
+		virtual void Quiesce();
+
+		/// <summary>
+		/// Copies in the entries of the layout this scope was constructed with, if they were deferred.
+		/// Called on the first access that could see them: by name, by index, by iteration, comparison, or appending.
+		/// </summary>
+		virtual void Materialize();
+
+		/// <summary>
+		/// Materializes this scope if it has a deferred layout. Logically const: the entries already exist as far as callers can tell.
+		/// </summary>
+		void EnsureMaterialized() const;
+
 		using MapType = Hashmap<const std::string, Datum>;
 		using PairType = MapType::PairType;
 		MapType mTable;
@@ -248,6 +510,132 @@ namespace Library
 
 		//delete all memory allocated by this object
 		void Clear();
+
+	private:
+		/// <summary>
+		/// Fills this empty scope with a deep copy of rhs's entries, in rhs's order
+		/// </summary>
+		/// <param name="rhs">the scope to copy</param>
+		void DeepCopy(const Scope& rhs);
+
+		/// <summary>
+		/// Appends the paths that differ between lhs and rhs to paths, each starting with prefix
+		/// </summary>
+		/// <param name="lhs">the first scope to compare</param>
+		/// <param name="rhs">the second scope to compare</param>
+		/// <param name="prefix">the path from the roots to lhs and rhs</param>
+		/// <param name="paths">the list of paths to append to</param>
+		static void DiffInto(const Scope& lhs, const Scope& rhs, const std::string& prefix, Vector<std::string>& paths);
+
+		/// <summary>
+		/// Flags this scope and its ancestors as having changes. Called by a datum this scope tracks when it first becomes dirty.
+		/// </summary>
+		void MarkChanged() noexcept;
+
+		/// <summary>
+		/// Drops the cached structural hash of this scope and its ancestors. Called by a datum this scope tracks on every write, and whenever it hands out a writable reference.
+		/// </summary>
+		void InvalidateStructuralHash() noexcept;
+
+		/// <summary>
+		/// Inserts a copy of each of layout's entries, which must not already be in the table
+		/// </summary>
+		/// <param name="layout">the entries to copy in</param>
+		void InsertLayout(const Layout& layout);
+
+		/// <summary>
+		/// Makes room for count more entries. Buckets are only added while the table is empty, as it never rehashes.
+		/// </summary>
+		/// <param name="count">the number of entries about to be appended</param>
+		void ReserveEntries(size_t count);
+
+		/// <summary>
+		/// Makes this scope track every datum it holds, e.g. after its contents were replaced
+		/// </summary>
+		/// <param name="markDirty">whether to mark every datum as changed</param>
+		void TrackDatums(bool markDirty);
+
+		/// <summary>
+		/// Appends the children of this scope to children, in the order their entries were appended
+		/// </summary>
+		/// <param name="children">the list to append to</param>
+		void AppendChildren(Vector<Scope*>& children) const;
+
+		/// <summary>
+		/// Removes every child from this scope without deleting them and appends them to children
+		/// </summary>
+		/// <param name="children">the list to append to</param>
+		void DetachChildren(Vector<Scope*>& children);
+
+		/// <summary>
+		/// A memoized Search result, valid while mSearchVersion has not changed
+		/// </summary>
+		struct SearchCacheEntry
+		{
+			Datum* mDatum = nullptr;
+			Scope* mScope = nullptr;
+			std::uint64_t mVersion = 0;
+		};
+		using SearchCacheType = Hashmap<const std::string, SearchCacheEntry>;
+
+		/// <summary>
+		/// Gives this scope a new search stamp, which changes the SearchVersion of this scope and every descendant, the scopes whose searches walk through this one.
+		/// Called whenever an entry is created here or this scope changes parent, since either can change what those searches find.
+		/// </summary>
+		void InvalidateSearches() noexcept;
+
+		/// <summary>
+		/// Gives this scope a new structure version, see StructureVersion
+		/// </summary>
+		void MarkStructureChanged() noexcept;
+
+		/// <summary>
+		/// Removes this scope from its parent without invalidating any searches, for Orphan and the destructor
+		/// </summary>
+		void RemoveFromParent();
+
+		/// <summary>
+		/// A stamp no scope has had yet. Stamps are unique across scopes, so a cache cannot mistake a new scope at a reused address for the one it saw.
+		/// </summary>
+		/// <returns>A new version stamp</returns>
+		static std::uint64_t NextVersion() noexcept;
+
+		/// <summary>
+		/// Finds the datum and index this scope is stored at in its parent.
+		/// Uses the back reference if it is still accurate, otherwise falls back to FindContainedScope.
+		/// </summary>
+		/// <returns>The datum containing this scope and the index it is at</returns>
+		std::pair<Datum*, size_t> FindInParent() const;
+
+		/// <summary>
+		/// Records where this scope is stored in its parent
+		/// </summary>
+		/// <param name="parent">the new parent</param>
+		/// <param name="datum">the parent's datum containing this scope</param>
+		/// <param name="index">the index of this scope in datum</param>
+		void SetParent(Scope& parent, Datum& datum, size_t index) noexcept;
+
+		/// <summary>
+		/// The bits a key sets in a scope's key filter
+		/// </summary>
+		/// <param name="key">the key to hash</param>
+		/// <returns>A 64 bit mask with one or two bits set</returns>
+		static std::uint64_t KeyFilterBits(const std::string& key);
+
+		Datum* mParentDatum = nullptr;	//the datum in mParent holding this scope
+		size_t mParentIndex = 0;	//the index of this scope in mParentDatum
+
+		inline static std::atomic<std::uint64_t> sNextVersion{ 0 };
+		std::uint64_t mSearchVersion = NextVersion();	//this scope's own stamp, see InvalidateSearches and SearchVersion
+		std::uint64_t mStructureVersion = NextVersion();	//see StructureVersion
+		std::unique_ptr<SearchCacheType> mSearchCache;	//allocated on the first Search that hits
+		static const size_t MAX_CACHED_SEARCHES = 32;	//a scope searched for more keys than this starts its cache over
+		std::uint64_t mKeyFilter = 0;	//bloom filter of the keys in mTable, lets Search skip ancestors that cannot contain a key
+		const Layout* mDeferredLayout = nullptr;	//entries not yet copied into an otherwise empty table, see Materialize
+		mutable std::size_t mStructuralHash = 0;	//valid while mHasStructuralHash, see StructuralHash
+		mutable std::atomic<bool> mHasStructuralHash{ false };	//a scope without a cached hash has no ancestor with one either. Atomic like mHasChanges.
+		bool mTracksChanges = false;	//whether this scope's datums report changes to it
+		std::atomic<bool> mHasChanges{ false };	//a datum in this scope or a descendant is dirty. Atomic because writes in parallel traversals flag shared ancestors.
 	};
 }
 
@@ -0,0 +1,137 @@
+#include "pch.h"
+#include "ScopeArena.h"
+#include <exception>
+
+namespace Library
+{
+	thread_local ScopeArena* ScopeArena::sCurrent = nullptr;
+
+	namespace
+	{
+		inline size_t AlignUp(size_t size)
+		{
+			const size_t alignment = alignof(std::max_align_t);
+			return (size + alignment - 1) & ~(alignment - 1);
+		}
+	}
+
+	ScopeArena::Activation::Activation(ScopeArena& arena) noexcept :
+		mPrevious(sCurrent)
+	{
+		sCurrent = &arena;
+	}
+
+	ScopeArena::Activation::~Activation()
+	{
+		sCurrent = mPrevious;
+	}
+
+	ScopeArena::ScopeArena(size_t chunkSize) :
+		mChunkSize(chunkSize)
+	{
+		if (chunkSize == 0)
+		{
+			throw std::runtime_error("Chunk size cannot be 0");
+		}
+	}
+
+	ScopeArena::~ScopeArena()
+	{
+		if (mLiveAllocations > 0)
+		{
+			//a scope from this arena outlived it, and its delete would write into freed chunks and a destroyed free list
+			std::terminate();
+		}
+		ReleaseChunks();
+	}
+
+	void* ScopeArena::Allocate(size_t size)
+	{
+		size = AlignUp(size);
+		auto freeList = mFreeLists.Find(size);
+		if (freeList == mFreeLists.end())
+		{
+			freeList = mFreeLists.Insert(std::make_pair(size, nullptr)).first;
+		}
+		else if (freeList->second != nullptr)
+		{
+			FreeBlock* block = freeList->second;
+			freeList->second = block->mNext;
+			++mLiveAllocations;
+			return block;
+		}
+
+		if (static_cast<size_t>(mEnd - mNext) < size)
+		{
+			//start a new chunk, whatever is left in the current one is wasted
+			const size_t headerSize = AlignUp(sizeof(Chunk));
+			const size_t chunkSize = std::max(mChunkSize, size);
+			Chunk* chunk = reinterpret_cast<Chunk*>(malloc(headerSize + chunkSize));
+			if (chunk == nullptr)
+			{
+				throw std::bad_alloc();
+			}
+			chunk->mPrevious = mChunks;
+			chunk->mSize = headerSize + chunkSize;
+			mChunks = chunk;
+			mBytesReserved += chunk->mSize;
+
+			mNext = reinterpret_cast<std::byte*>(chunk) + headerSize;
+			mEnd = mNext + chunkSize;
+		}
+
+		void* memory = mNext;
+		mNext += size;
+		++mLiveAllocations;
+		return memory;
+	}
+
+	void ScopeArena::Deallocate(void* pointer, size_t size) noexcept
+	{
+		assert(pointer != nullptr && mLiveAllocations > 0);
+		auto freeList = mFreeLists.Find(AlignUp(size));
+		assert(freeList != mFreeLists.end());	//created when the block was allocated
+		FreeBlock* block = static_cast<FreeBlock*>(pointer);
+		block->mNext = freeList->second;
+		freeList->second = block;
+		--mLiveAllocations;
+	}
+
+	void ScopeArena::Release()
+	{
+		if (mLiveAllocations > 0)
+		{
+			throw std::runtime_error("Cannot release an arena while scopes allocated from it are alive");
+		}
+		ReleaseChunks();
+	}
+
+	size_t ScopeArena::LiveAllocations() const noexcept
+	{
+		return mLiveAllocations;
+	}
+
+	size_t ScopeArena::BytesReserved() const noexcept
+	{
+		return mBytesReserved;
+	}
+
+	ScopeArena* ScopeArena::Current() noexcept
+	{
+		return sCurrent;
+	}
+
+	void ScopeArena::ReleaseChunks() noexcept
+	{
+		while (mChunks != nullptr)
+		{
+			Chunk* previous = mChunks->mPrevious;
+			free(mChunks);
+			mChunks = previous;
+		}
+		mFreeLists.Clear();	//the free blocks were in the chunks
+		mNext = nullptr;
+		mEnd = nullptr;
+		mBytesReserved = 0;
+	}
+}
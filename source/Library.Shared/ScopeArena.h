@@ -0,0 +1,133 @@
+#pragma once
+#include <cstddef>
+#include "Hashmap.h"
+
+namespace Library
+{
+	/// <summary>
+	/// A region allocator for Scope trees.
+	/// Scopes created while an arena is active (see Activation) are carved out of large chunks instead of being individual heap allocations,
+	/// and every chunk is released at once when the arena is destroyed or Released.
+	/// Deleting a scope from an arena runs its destructor and puts its block on a free list for its size, which the next allocation of that size takes,
+	/// so a world that keeps spawning and destroying objects reuses the same memory instead of growing.
+	/// </summary>
+	/// <remarks>
+	/// Only the Scope objects themselves come from the arena. Their datum arrays, hashmap nodes and strings still use the heap.
+	/// Every scope allocated from an arena must be deleted before the arena is. An arena is used by one thread at a time.
+	/// </remarks>
+	class ScopeArena final
+	{
+	public:
+		static const size_t DEFAULT_CHUNK_SIZE = 64 * 1024;	//bytes per chunk, larger allocations get a chunk of their own
+
+		/// <summary>
+		/// Makes an arena the one new scopes are allocated from on this thread, for the lifetime of the Activation.
+		/// Activations nest: the previously active arena (or the heap) is restored on destruction.
+		/// </summary>
+		class Activation final
+		{
+		public:
+			/// <summary>
+			/// Constructor: activates arena on this thread
+			/// </summary>
+			/// <param name="arena">the arena to allocate new scopes from</param>
+			explicit Activation(ScopeArena& arena) noexcept;
+
+			/// <summary>
+			/// Destructor: restores the previously active arena
+			/// </summary>
+			~Activation();
+
+			Activation(const Activation& rhs) = delete;
+			Activation(Activation&& rhs) noexcept = delete;
+			Activation& operator=(const Activation& rhs) = delete;
+			Activation& operator=(Activation&& rhs) noexcept = delete;
+
+		private:
+			ScopeArena* mPrevious;
+		};
+
+		/// <summary>
+		/// Constructor. Does not allocate until the first Allocate.
+		/// </summary>
+		/// <param name="chunkSize">the size of each chunk of memory requested from the heap</param>
+		/// <exception cref="std::runtime_error">Throws exception if chunkSize is 0</exception>
+		explicit ScopeArena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+		/// <summary>
+		/// Destructor: releases every chunk. All scopes allocated from this arena must already be deleted:
+		/// deleting one later would free it into a destroyed arena, so the program is terminated instead.
+		/// </summary>
+		~ScopeArena();
+
+		ScopeArena(const ScopeArena& rhs) = delete;
+		ScopeArena(ScopeArena&& rhs) noexcept = delete;
+		ScopeArena& operator=(const ScopeArena& rhs) = delete;
+		ScopeArena& operator=(ScopeArena&& rhs) noexcept = delete;
+
+		/// <summary>
+		/// Allocates size bytes, aligned for any type. Reuses a deallocated block of the same size if there is one.
+		/// </summary>
+		/// <param name="size">the number of bytes to allocate</param>
+		/// <returns>The allocated memory</returns>
+		void* Allocate(size_t size);
+
+		/// <summary>
+		/// Marks an allocation as no longer in use and keeps its block for the next allocation of the same size.
+		/// Not thread safe, like Allocate: scopes from one arena must not be deleted on two threads at once.
+		/// </summary>
+		/// <param name="pointer">memory returned by Allocate</param>
+		/// <param name="size">the size pointer was allocated with</param>
+		void Deallocate(void* pointer, size_t size) noexcept;
+
+		/// <summary>
+		/// Releases every chunk in one go so the arena can be reused, e.g. between levels
+		/// </summary>
+		/// <exception cref="std::runtime_error">Throws exception if any allocation is still in use</exception>
+		void Release();
+
+		/// <summary>
+		/// The number of allocations that have not been deallocated
+		/// </summary>
+		/// <returns>The number of allocations still in use</returns>
+		size_t LiveAllocations() const noexcept;
+
+		/// <summary>
+		/// The total size of the chunks currently held
+		/// </summary>
+		/// <returns>The number of bytes requested from the heap</returns>
+		size_t BytesReserved() const noexcept;
+
+		/// <summary>
+		/// The arena new scopes are allocated from on this thread
+		/// </summary>
+		/// <returns>The active arena, or nullptr if scopes are allocated from the heap</returns>
+		static ScopeArena* Current() noexcept;
+
+	private:
+		//header at the start of every chunk, the chunks form a singly linked list
+		struct Chunk
+		{
+			Chunk* mPrevious;
+			size_t mSize;
+		};
+
+		//a deallocated block, linked to the next free block of the same size
+		struct FreeBlock
+		{
+			FreeBlock* mNext;
+		};
+
+		void ReleaseChunks() noexcept;
+
+		Hashmap<size_t, FreeBlock*> mFreeLists{ 11 };	//by aligned size. A size's list is created by its first Allocate, so Deallocate never allocates.
+		Chunk* mChunks = nullptr;
+		std::byte* mNext = nullptr;	//next free byte in the newest chunk
+		std::byte* mEnd = nullptr;	//end of the newest chunk
+		size_t mChunkSize;
+		size_t mLiveAllocations = 0;
+		size_t mBytesReserved = 0;
+
+		static thread_local ScopeArena* sCurrent;
+	};
+}
@@ -0,0 +1,105 @@
+#include "pch.h"
+#include "ScopePath.h"
+
+namespace Library
+{
+	ScopePath::ScopePath(const std::string& path) :
+		mPath(path)
+	{
+		size_t position = 0;
+		do
+		{
+			Segment segment;
+			size_t keyEnd = path.find_first_of(".[", position);
+			if (keyEnd == std::string::npos) { keyEnd = path.size(); }
+			segment.mKey = path.substr(position, keyEnd - position);
+			if (segment.mKey.empty())
+			{
+				throw std::runtime_error("Invalid scope path: " + path);
+			}
+			position = keyEnd;
+
+			//optional index
+			if (position < path.size() && path[position] == '[')
+			{
+				const size_t indexEnd = path.find(']', position);
+				if (indexEnd == std::string::npos || indexEnd == position + 1)
+				{
+					throw std::runtime_error("Invalid scope path: " + path);
+				}
+				for (size_t i = position + 1; i < indexEnd; ++i)
+				{
+					if (path[i] < '0' || path[i] > '9')
+					{
+						throw std::runtime_error("Invalid scope path: " + path);
+					}
+					segment.mIndex = segment.mIndex * 10 + (path[i] - '0');
+				}
+				position = indexEnd + 1;
+			}
+
+			mSegments.PushBack(std::move(segment));
+
+			if (position < path.size())
+			{
+				if (path[position] != '.')
+				{
+					throw std::runtime_error("Invalid scope path: " + path);
+				}
+				++position;
+				if (position == path.size())
+				{
+					throw std::runtime_error("Invalid scope path: " + path);	//trailing '.'
+				}
+			}
+		} while (position < path.size());
+	}
+
+	Datum* ScopePath::Resolve(Scope& root)
+	{
+		if (mDatum != nullptr && mRoot == &root && mSearchVersion == root.SearchVersion() && IsCurrent())
+		{
+			return mDatum;
+		}
+
+		mDatum = nullptr;
+		if (mSegments.IsEmpty()) { return nullptr; }
+
+		Scope* scope = nullptr;
+		Datum* datum = root.Search(mSegments[0].mKey, &scope);
+		for (size_t i = 0; datum != nullptr; ++i)
+		{
+			mSegments[i].mScope = scope;
+			mSegments[i].mVersion = scope->StructureVersion();
+			if (i + 1 == mSegments.Size()) { break; }
+
+			const size_t index = mSegments[i].mIndex;
+			if (datum->Type() != DatumType::Table || index >= datum->Size())
+			{
+				return nullptr;
+			}
+			scope = &datum->Get<Scope>(index);
+			datum = scope->Find(mSegments[i + 1].mKey);
+		}
+
+		//only successes are cached, a miss is resolved again next time
+		if (datum != nullptr)
+		{
+			mRoot = &root;
+			mDatum = datum;
+			mSearchVersion = root.SearchVersion();
+		}
+		return datum;
+	}
+
+	bool ScopePath::IsCurrent() const noexcept
+	{
+		//the root's search version still holding means the first scope is still an ancestor and alive. Checked in path order,
+		//a scope with the same structure still holds the same child at the next step, so that child is alive to ask in turn.
+		for (const Segment& segment : mSegments)
+		{
+			if (segment.mScope->StructureVersion() != segment.mVersion) { return false; }
+		}
+		return true;
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "Scope.h"
+#include "vector.h"
+
+namespace Library
+{
+	/// <summary>
+	/// A compiled address of a datum in a Scope tree, e.g. "Sectors[0].Entities[3].Health".
+	/// The path is parsed once. Resolving it caches the datum it leads to, which stays valid while the root's Scope::SearchVersion and the
+	/// Scope::StructureVersion of each scope the path runs through are unchanged, so code that reads or writes the same deep attribute every frame
+	/// only hashes its keys again after the part of the hierarchy the path runs through changes.
+	/// </summary>
+	/// <remarks>
+	/// A path is a list of keys separated by '.', each optionally followed by an index in brackets (default 0).
+	/// The first key is looked up with Search, so it can name an attribute of the root or any of its ancestors.
+	/// The remaining keys are looked up with Find in the scope selected by the previous key and index.
+	/// </remarks>
+	class ScopePath final
+	{
+	public:
+		/// <summary>
+		/// Default constructor: an empty path, which never resolves
+		/// </summary>
+		ScopePath() = default;
+
+		/// <summary>
+		/// Constructor: parses path
+		/// </summary>
+		/// <param name="path">the path to parse</param>
+		/// <exception cref="std::runtime_error">Throws exception if path is empty or malformed</exception>
+		explicit ScopePath(const std::string& path);
+
+		ScopePath(const ScopePath& rhs) = default;
+		ScopePath(ScopePath&& rhs) noexcept = default;
+		ScopePath& operator=(const ScopePath& rhs) = default;
+		ScopePath& operator=(ScopePath&& rhs) noexcept = default;
+		~ScopePath() = default;
+
+		/// <summary>
+		/// Finds the datum this path names, starting at root.
+		/// Returns the cached datum if root is the same as the last successful resolve, and nothing the path runs through has changed structure since.
+		/// </summary>
+		/// <param name="root">the scope to resolve the path from</param>
+		/// <returns>The address of the datum the last key names, or nullptr if any key or index along the way does not exist</returns>
+		Datum* Resolve(Scope& root);
+
+		/// <summary>
+		/// Gets the element of the resolved datum at the index given by the last key
+		/// </summary>
+		/// <param name="root">the scope to resolve the path from</param>
+		/// <returns>A reference to the element this path names</returns>
+		/// <exception cref="std::runtime_error">Throws exception if the path cannot be resolved, or the datum is not of type T or too small</exception>
+		template<typename T>
+		T& Get(Scope& root);
+
+		/// <summary>
+		/// The index given by the last key, the element of the resolved datum this path names
+		/// </summary>
+		/// <returns>The index of the last key, 0 for an empty path</returns>
+		size_t Index() const noexcept;
+
+		/// <summary>
+		/// The number of keys in this path
+		/// </summary>
+		/// <returns>The number of keys in this path</returns>
+		size_t Depth() const noexcept;
+
+		/// <summary>
+		/// The path this was compiled from
+		/// </summary>
+		/// <returns>The path this was compiled from</returns>
+		const std::string& ToString() const noexcept;
+
+	private:
+		//one key of the path, and the element of its datum to continue from
+		struct Segment
+		{
+			std::string mKey;
+			size_t mIndex = 0;
+			const Scope* mScope = nullptr;	//the scope the key was last found in
+			std::uint64_t mVersion = 0;	//the structure version of mScope then
+		};
+
+		/// <summary>
+		/// Whether every scope the last successful resolve ran through still has the structure it had then
+		/// </summary>
+		/// <returns>True if the cached datum is still the one the path leads to from mRoot</returns>
+		bool IsCurrent() const noexcept;
+
+		Vector<Segment> mSegments;
+		std::string mPath;
+
+		//cache of the last successful resolve
+		Scope* mRoot = nullptr;
+		Datum* mDatum = nullptr;
+		std::uint64_t mSearchVersion = 0;	//of mRoot
+	};
+}
+
+#include "ScopePath.inl"
@@ -0,0 +1,30 @@
+#include "ScopePath.h"
+
+namespace Library
+{
+	template<typename T>
+	inline T& ScopePath::Get(Scope& root)
+	{
+		Datum* datum = Resolve(root);
+		if (datum == nullptr)
+		{
+			throw std::runtime_error("Path not found: " + mPath);
+		}
+		return datum->Get<T>(Index());
+	}
+
+	inline size_t ScopePath::Index() const noexcept
+	{
+		return mSegments.IsEmpty() ? 0 : mSegments[mSegments.Size() - 1].mIndex;
+	}
+
+	inline size_t ScopePath::Depth() const noexcept
+	{
+		return mSegments.Size();
+	}
+
+	inline const std::string& ScopePath::ToString() const noexcept
+	{
+		return mPath;
+	}
+}
@@ -0,0 +1,61 @@
+#include "pch.h"
+#include "ScopeReclaimer.h"
+#include "Scope.h"
+
+namespace Library
+{
+	ScopeReclaimer::~ScopeReclaimer()
+	{
+		ReclaimAll();
+	}
+
+	void ScopeReclaimer::Defer(Scope& scope)
+	{
+		scope.Traverse([](Scope& waiting) { waiting.Quiesce(); });
+		scope.Orphan();
+		mPending.PushBack(&scope);
+	}
+
+	size_t ScopeReclaimer::Reclaim(std::chrono::microseconds budget)
+	{
+		using Clock = std::chrono::steady_clock;
+		const Clock::time_point deadline = Clock::now() + budget;
+		size_t reclaimed = 0;
+		while (!mPending.IsEmpty())
+		{
+			ReclaimOne();
+			++reclaimed;
+			if (Clock::now() >= deadline) { break; }
+		}
+		return reclaimed;
+	}
+
+	size_t ScopeReclaimer::ReclaimAll()
+	{
+		size_t reclaimed = 0;
+		while (!mPending.IsEmpty())
+		{
+			ReclaimOne();
+			++reclaimed;
+		}
+		return reclaimed;
+	}
+
+	size_t ScopeReclaimer::Pending() const noexcept
+	{
+		return mPending.Size();
+	}
+
+	bool ScopeReclaimer::IsEmpty() const noexcept
+	{
+		return mPending.IsEmpty();
+	}
+
+	void ScopeReclaimer::ReclaimOne()
+	{
+		Scope* scope = mPending[mPending.Size() - 1];
+		mPending.PopBack();
+		scope->DetachChildren(mPending);
+		delete(scope);
+	}
+}
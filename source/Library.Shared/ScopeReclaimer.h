@@ -0,0 +1,76 @@
+#pragma once
+#include "vector.h"
+#include <chrono>
+
+namespace Library
+{
+	class Scope; //forward declaration
+
+	/// <summary>
+	/// Deletes Scope trees a little at a time instead of all at once, so unloading a large sector does not stall a frame.
+	/// Defer detaches a subtree from its parent straight away. Reclaim then deletes scopes from it until a time budget is spent,
+	/// detaching the children of each scope before deleting it so no destructor has a subtree left to walk.
+	/// </summary>
+	/// <remarks>
+	/// Reclaiming runs on the calling thread. Scope destructors unsubscribe reactions, free arena allocations and invalidate searches,
+	/// none of which is safe to do beside the game loop, so the work is spread across frames rather than moved to another thread.
+	/// </remarks>
+	class ScopeReclaimer final
+	{
+	public:
+		/// <summary>
+		/// Default constructor: nothing to reclaim
+		/// </summary>
+		ScopeReclaimer() = default;
+
+		/// <summary>
+		/// Destructor: deletes everything still waiting to be reclaimed
+		/// </summary>
+		~ScopeReclaimer();
+
+		ScopeReclaimer(const ScopeReclaimer& rhs) = delete;
+		ScopeReclaimer(ScopeReclaimer&& rhs) noexcept = delete;
+		ScopeReclaimer& operator=(const ScopeReclaimer& rhs) = delete;
+		ScopeReclaimer& operator=(ScopeReclaimer&& rhs) noexcept = delete;
+
+		/// <summary>
+		/// Takes ownership of a heap allocated scope and its descendants, orphaning it so it is no longer part of any tree.
+		/// Every scope in the subtree is quiesced first (see Scope::Quiesce), so e.g. reactions stop receiving events while they wait.
+		/// </summary>
+		/// <param name="scope">the HEAP ALLOCATED scope to delete later</param>
+		void Defer(Scope& scope);
+
+		/// <summary>
+		/// Deletes deferred scopes until budget is spent. Always deletes at least one if any are waiting, so reclaiming keeps making progress.
+		/// </summary>
+		/// <param name="budget">how long to spend deleting scopes</param>
+		/// <returns>The number of scopes deleted</returns>
+		size_t Reclaim(std::chrono::microseconds budget);
+
+		/// <summary>
+		/// Deletes every deferred scope now
+		/// </summary>
+		/// <returns>The number of scopes deleted</returns>
+		size_t ReclaimAll();
+
+		/// <summary>
+		/// The number of scopes known to be waiting. Descendants are only counted once their parent has been deleted.
+		/// </summary>
+		/// <returns>The number of scopes waiting to be deleted</returns>
+		size_t Pending() const noexcept;
+
+		/// <summary>
+		/// Whether everything deferred has been deleted
+		/// </summary>
+		/// <returns>True if nothing is waiting to be deleted</returns>
+		bool IsEmpty() const noexcept;
+
+	private:
+		/// <summary>
+		/// Detaches the children of the next waiting scope, queueing them, then deletes it
+		/// </summary>
+		void ReclaimOne();
+
+		Vector<Scope*> mPending;	//detached scopes whose children, if any, are still attached to them. Order does not matter, so it is used as a stack.
+	};
+}
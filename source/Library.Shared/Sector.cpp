@@ -9,24 +9,18 @@ namespace Library
 
 	Sector::Sector() : Attributed(Sector::TypeIdClass())
 	{
-		mEntitiesDatum = Find(ENTITIES_STRING);
-		assert(mEntitiesDatum != nullptr);
 	}
 
 	Sector::Sector(const std::string& name, World* world) :
 		Attributed(Sector::TypeIdClass()), mName(name)
 	{
 		if (world != nullptr) { SetWorld(*world); }
-		mEntitiesDatum = Find(ENTITIES_STRING);
-		assert(mEntitiesDatum != nullptr);
 	}
 
 	Sector::Sector(std::string&& name, World* world) :
 		Attributed(Sector::TypeIdClass()), mName(name)
 	{
 		if (world != nullptr) { SetWorld(*world); }
-		mEntitiesDatum = Find(ENTITIES_STRING);
-		assert(mEntitiesDatum != nullptr);
 	}
 
 	const std::string& Sector::Name() const noexcept
@@ -50,7 +44,7 @@ namespace Library
 	{
 		Scope* parent = GetParent();
 		//sanity check: if parent isn't nullptr, make sure it is a sector
-		assert(parent != nullptr ? parent->Is(World::TypeIdClass()) : true);
+		assert(parent != nullptr ? parent->Is<World>() : true);
 		return static_cast<World*>(parent);
 	}
 
@@ -61,10 +55,12 @@ namespace Library
 
 	void Sector::Update(WorldState& state)
 	{
-		for (size_t i = 0; i < mEntitiesDatum->Size(); i++)
+		if (!IsMaterialized()) { return; }	//nothing was added to a deferred Entities table, resolving it would only materialize the layout
+		Datum& entities = Entities();
+		for (size_t i = 0; i < entities.Size(); i++)
 		{
-			Scope& entity = mEntitiesDatum->Get<Scope>(i);
-			assert(entity.Is(Entity::TypeIdClass()));
+			Scope& entity = entities.Get<Scope>(i);
+			assert(entity.Is<Entity>());
 			state.mEntity = &static_cast<Entity&>(entity);
 			static_cast<Entity&>(entity).Update(state);
 		}
@@ -73,14 +69,12 @@ namespace Library
 
 	Datum& Sector::Entities()
 	{
-		assert(mEntitiesDatum != nullptr); //sanity check
-		return *mEntitiesDatum;
+		return PrescribedAttribute(ENTITIES_INDEX);
 	}
 
 	const Datum& Sector::Entities() const
 	{
-		assert(mEntitiesDatum != nullptr); //sanity check
-		return *mEntitiesDatum;
+		return PrescribedAttribute(ENTITIES_INDEX);
 	}
 
 	Entity* Sector::CreateEntity(const std::string& className, const std::string& instanceName)
@@ -107,13 +101,14 @@ namespace Library
 		return new Sector(*this);
 	}
 
+	gsl::owner<Scope*> Sector::Relocate()
+	{
+		return RelocateAs(*this);
+	}
+
 	Vector<Signature> Sector::Signatures()
 	{
-		return Vector<Signature>
-		{
-			Signature("Name", DatumType::String, 1, offsetof(Sector, mName)),
-			Signature(ENTITIES_STRING, DatumType::Table, START_ENTITY_CAPACITY, 0)
-		};
+		return ToSignatures(StaticSignatures());
 	}
 
 }
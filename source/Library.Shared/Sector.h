@@ -37,7 +37,7 @@ namespace Library
 		explicit Sector(std::string&& name, World* world = nullptr);
 
 		/// <summary>
-		/// Default Scope Copy Constructor
+		/// Copy constructor: default scope copy constructor
 		/// </summary>
 		/// <param name="rhs">the sector to copy</param>
 		Sector(const Sector& rhs) = default;
@@ -54,11 +54,11 @@ namespace Library
 		~Sector() = default;
 
 		/// <summary>
-		/// Default scope copy assignment
+		/// Copy assignment: default scope copy assignment
 		/// </summary>
 		/// <param name="rhs">the sector to copy</param>
-		/// <returns>a copy of rhs</returns>
-		Sector& operator=(const Sector & rhs) = default;
+		/// <returns>A reference to this sector</returns>
+		Sector& operator=(const Sector& rhs) = default;
 
 		/// <summary>
 		/// Default scope move assignment
@@ -135,20 +135,43 @@ namespace Library
 		/// <returns>a pointer to a new sector</returns>
 		virtual gsl::owner<Sector*> Clone() const override;
 
+		/// <summary>
+		/// Moves this into a new heap allocated Sector, see Scope::Relocate
+		/// </summary>
+		/// <returns>the relocated scope</returns>
+		virtual gsl::owner<Scope*> Relocate() override;
+
 		/// <summary>
 		/// Gets the prescribed attributes for a Sector
 		/// </summary>
 		/// <returns>The prescribed attributes for a Sector</returns>
 		static Vector<Signature> Signatures();
 
+		/// <summary>
+		/// The prescribed attributes as a constexpr table, see Signatures()
+		/// </summary>
+		/// <returns>A StaticSignature for each prescribed attribute</returns>
+		static constexpr std::array<StaticSignature, 2> StaticSignatures();
+
 
 		static const inline std::string ENTITIES_STRING = "Entities";
+		static const size_t ENTITIES_INDEX;	//index of ENTITIES_STRING in Signatures(), looked up in StaticSignatures() below. See PrescribedAttribute
 	private:
 		std::string mName;
-		Datum* mEntitiesDatum = nullptr;
 		static const size_t START_ENTITY_CAPACITY = 23;
 	};
 
+	constexpr std::array<StaticSignature, 2> Sector::StaticSignatures()
+	{
+		return
+		{
+			SIGNATURE(Sector, "Name", DatumType::String, 1, mName),
+			TABLE_SIGNATURE("Entities", START_ENTITY_CAPACITY)
+		};
+	}
+
+	inline constexpr size_t Sector::ENTITIES_INDEX = SignatureIndex(Sector::StaticSignatures(), "Entities");
+
 	ConcreteFactory(Sector, Scope);
 }
 
@@ -1,9 +1,43 @@
 #pragma once
 #include <string>
+#include <string_view>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
 #include "Datum.h"
+#include "vector.h"
+
+/// <summary>
+/// Describes a prescribed attribute stored in a data member, as an entry of a constexpr StaticSignature table.
+/// Only usable where Class's members are accessible, i.e. in Class's own StaticSignatures().
+/// </summary>
+#define SIGNATURE(Class, Name, Type, Size, Member) Library::StaticSignature{ Name, Type, Size, offsetof(Class, Member) }
+
+/// <summary>
+/// Describes a prescribed attribute of type Custom stored in a data member, as an entry of a constexpr StaticSignature table
+/// </summary>
+#define CUSTOM_SIGNATURE(Class, Name, ValueClass, Size, Member) Library::StaticSignature{ Name, Library::DatumType::Custom, Size, offsetof(Class, Member), &Library::ValueType::Of<ValueClass> }
+
+/// <summary>
+/// Describes a prescribed table attribute with room for Capacity scopes, as an entry of a constexpr StaticSignature table
+/// </summary>
+#define TABLE_SIGNATURE(Name, Capacity) Library::StaticSignature{ Name, Library::DatumType::Table, Capacity, 0 }
 
 namespace Library
 {
+	/// <summary>
+	/// A compile time description of a prescribed attribute, see the SIGNATURE macros.
+	/// A type's table of them can be inspected in constant expressions, e.g. by SignatureIndex. Registering the type still copies it into Signatures, see ToSignatures.
+	/// </summary>
+	struct StaticSignature final
+	{
+		std::string_view mName;
+		DatumType mType;
+		size_t mSize;
+		size_t mOffset;
+		const ValueType& (*mValueType)() = nullptr;	//ValueType::Of<T> for Custom attributes
+	};
+
 	/// <summary>
 	/// Signature is used to describe an attribute (datum) of an attributed scope.
 	/// Holds the name, type, size, and offset of an attribute
@@ -17,8 +51,12 @@ namespace Library
 		Signature& operator=(Signature&& rhs) noexcept = default;
 		~Signature() = default;
 
-		Signature(std::string name, DatumType type, size_t size, size_t offset)
-			: mName(name), mType(type), mSize(size), mOffset(offset) {}
+		Signature(std::string name, DatumType type, size_t size, size_t offset, const ValueType* valueType = nullptr)
+			: mName(name), mType(type), mSize(size), mOffset(offset), mValueType(valueType) {}
+
+		explicit Signature(const StaticSignature& signature)
+			: mName(signature.mName), mType(signature.mType), mSize(signature.mSize), mOffset(signature.mOffset),
+			mValueType(signature.mValueType != nullptr ? &signature.mValueType() : nullptr) {}
 
 		bool operator==(const Signature& rhs) const noexcept = default;
 		bool operator!=(const Signature& rhs) const noexcept = default;
@@ -42,5 +80,30 @@ namespace Library
 		/// The offset to the class data member (for mapping to external storage)
 		/// </summary>
 		size_t mOffset;
+
+		/// <summary>
+		/// The value type of a Custom attribute (see ValueType::Of), nullptr for built in types
+		/// </summary>
+		const ValueType* mValueType = nullptr;
 	};
-}
\ No newline at end of file
+
+	/// <summary>
+	/// Converts a constexpr signature table into the signatures the type registry stores
+	/// </summary>
+	/// <param name="table">the table to convert, e.g. a type's StaticSignatures()</param>
+	/// <returns>A signature for each entry, in order</returns>
+	template<std::size_t N>
+	Vector<Signature> ToSignatures(const std::array<StaticSignature, N>& table);
+
+	/// <summary>
+	/// Looks an attribute up by name in a constexpr signature table, so index constants like Entity::ACTIONS_INDEX follow the table
+	/// </summary>
+	/// <param name="table">the table to search, e.g. a type's StaticSignatures()</param>
+	/// <param name="name">the name of the attribute</param>
+	/// <returns>The index of the attribute in table</returns>
+	/// <exception cref="std::runtime_error">Throws exception if table has no such attribute, which fails compilation when evaluated as a constant</exception>
+	template<std::size_t N>
+	constexpr size_t SignatureIndex(const std::array<StaticSignature, N>& table, std::string_view name);
+}
+
+#include "Signature.inl"
\ No newline at end of file
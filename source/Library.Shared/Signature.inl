@@ -0,0 +1,25 @@
+#include "Signature.h"
+
+namespace Library
+{
+	template<std::size_t N>
+	inline Vector<Signature> ToSignatures(const std::array<StaticSignature, N>& table)
+	{
+		Vector<Signature> signatures(N);
+		for (const StaticSignature& signature : table)
+		{
+			signatures.PushBack(Signature(signature));
+		}
+		return signatures;
+	}
+
+	template<std::size_t N>
+	constexpr size_t SignatureIndex(const std::array<StaticSignature, N>& table, std::string_view name)
+	{
+		for (size_t i = 0; i < N; ++i)
+		{
+			if (table[i].mName == name) { return i; }
+		}
+		throw std::runtime_error("No signature with that name");
+	}
+}
@@ -3,21 +3,111 @@
 #include "vector.h"
 #include "Signature.h"
 #include "Hashmap.h"
+#include "Scope.h"
+#include "CapacityProfile.h"
 
 namespace Library
 {
 	class TypeRegistry final
 	{
 	public: 
+		/// <summary>
+		/// When instances of a registered type put their prescribed attributes in their scope table
+		/// </summary>
+		enum class Materialization
+		{
+			Eager,	//at construction
+			OnFirstAccess	//on the first access by name, by index or by iteration. Native code uses the members directly either way.
+		};
+
 		static void Create();
 		static void Shutdown();
-		static void RegisterType(RTTI::IdType type, const Vector<Signature>& signatures);
+
+		/// <summary>
+		/// Registers a type's prescribed attributes, building the layout its instances start with.
+		/// The layout makes room for the attribute and table sizes CapacityProfile has for type, so load a profile before registering.
+		/// </summary>
+		/// <param name="type">the type to register</param>
+		/// <param name="signatures">the type's prescribed attributes</param>
+		/// <param name="materialization">when instances of type materialize their prescribed attributes</param>
+		/// <exception cref="std::runtime_error">Throws exception if one of type's RTTI ancestors is registered, as its attributes would be left out</exception>
+		static void RegisterType(RTTI::IdType type, const Vector<Signature>& signatures, Materialization materialization = Materialization::Eager);
+
+		/// <summary>
+		/// Registers a type that inherits the attributes of an already registered parent type.
+		/// The parent's signatures are flattened in once, here, so a derived type only lists the attributes it adds.
+		/// A signature named like one of the parent's replaces it in the parent's position.
+		/// </summary>
+		/// <param name="type">the type to register</param>
+		/// <param name="signatures">the attributes type adds to its parent's</param>
+		/// <param name="parentType">the registered type to inherit attributes from</param>
+		/// <param name="materialization">when instances of type materialize their prescribed attributes, not inherited from parentType</param>
+		/// <exception cref="std::runtime_error">Throws exception if parentType is not registered, or is not type's nearest registered RTTI ancestor</exception>
+		static void RegisterType(RTTI::IdType type, const Vector<Signature>& signatures, RTTI::IdType parentType, Materialization materialization = Materialization::Eager);
+
 		static size_t Size();
 		static const Vector<Signature>& GetSignatures(RTTI::IdType type);
+
+		/// <summary>
+		/// Finds the signature with the given name among a type's prescribed attributes, through a per type index built at registration
+		/// </summary>
+		/// <param name="type">the registered type</param>
+		/// <param name="name">the name of the attribute</param>
+		/// <returns>The signature, or nullptr if type has no prescribed attribute called name</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not registered</exception>
+		static const Signature* FindSignature(RTTI::IdType type, const std::string& name);
+
+		/// <summary>
+		/// Gets the layout instances of a type start with: "this" followed by a typed datum for each prescribed attribute, built at registration.
+		/// Attributed constructs from it and then points the datums at the instance's members.
+		/// </summary>
+		/// <param name="type">the registered type</param>
+		/// <returns>The layout for type</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not registered</exception>
+		static const Scope::Layout& GetLayout(RTTI::IdType type);
+
+		/// <summary>
+		/// Gets when instances of a type materialize their prescribed attributes.
+		/// Instances that defer it refer to the type's layout until then, so the type must stay registered while they exist.
+		/// </summary>
+		/// <param name="type">the registered type</param>
+		/// <returns>The materialization type was registered with</returns>
+		/// <exception cref="std::runtime_error">Throws exception if type is not registered</exception>
+		static Materialization GetMaterialization(RTTI::IdType type);
+
 		static void DeregisterType(RTTI::IdType type);
 	private:
 		TypeRegistry() = delete;
-		using MapType = Hashmap<RTTI::IdType, const Vector<Signature>>;
+
+		//what is kept for each registered type
+		struct TypeInfo final
+		{
+			TypeInfo(RTTI::IdType type, const Vector<Signature>& signatures, Materialization materialization);
+
+			Vector<Signature> mSignatures;	//flattened: inherited attributes first
+			Hashmap<std::string, size_t> mIndices;	//name to index in mSignatures
+			Scope::Layout mLayout;
+			Materialization mMaterialization;
+		};
+
+		static Vector<std::pair<std::string, Datum>> LayoutEntries(RTTI::IdType type, const Vector<Signature>& signatures);
+
+		/// <summary>
+		/// Finds the most derived of type's RTTI ancestors, not counting type itself, that is registered
+		/// </summary>
+		/// <param name="type">the type to look above</param>
+		/// <returns>The ancestor's id, or RTTI::TypeIdClass() if none is registered or type is not an RTTI type (e.g. a schema type)</returns>
+		static RTTI::IdType NearestRegisteredAncestor(RTTI::IdType type);
+
+		/// <summary>
+		/// Registers type with already flattened signatures
+		/// </summary>
+		/// <param name="type">the type to register</param>
+		/// <param name="signatures">all of type's prescribed attributes</param>
+		/// <param name="materialization">when instances of type materialize their prescribed attributes</param>
+		static void Insert(RTTI::IdType type, const Vector<Signature>& signatures, Materialization materialization);
+
+		using MapType = Hashmap<RTTI::IdType, const TypeInfo>;
 		using PairType = MapType::PairType;
 		static MapType* mRegistry;
 	};
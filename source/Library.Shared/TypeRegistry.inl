@@ -20,10 +20,91 @@ namespace Library
 		mRegistry = nullptr;
 	}
 
-	inline void TypeRegistry::RegisterType(RTTI::IdType type, const Vector<Signature>& signatures)
+	inline TypeRegistry::TypeInfo::TypeInfo(RTTI::IdType type, const Vector<Signature>& signatures, Materialization materialization) :
+		mSignatures(signatures), mIndices(std::max<size_t>(signatures.Size(), 1)),
+		mLayout(LayoutEntries(type, signatures), CapacityProfile::EntryCapacity(type)), mMaterialization(materialization)
+	{
+		for (size_t i = 0; i < mSignatures.Size(); ++i)
+		{
+			mIndices.Insert({ mSignatures[i].mName, i });
+		}
+	}
+
+	inline Vector<std::pair<std::string, Datum>> TypeRegistry::LayoutEntries(RTTI::IdType type, const Vector<Signature>& signatures)
+	{
+		Vector<std::pair<std::string, Datum>> entries(signatures.Size() + 1);
+		Datum self;
+		self.SetType(DatumType::Pointer);
+		entries.PushBack(std::make_pair(std::string("this"), std::move(self)));
+		for (const Signature& signature : signatures)
+		{
+			Datum datum;
+			if (signature.mType == DatumType::Custom && signature.mValueType != nullptr)
+			{
+				datum.SetType(*signature.mValueType);
+			}
+			else
+			{
+				datum.SetType(signature.mType);
+			}
+			if (signature.mType == DatumType::Table)
+			{
+				//scopes copy the reserved capacity from the layout, so a profiled table size costs nothing per instance
+				datum.Reserve(std::max(signature.mSize, CapacityProfile::TableCapacity(type, signature.mName)));
+			}
+			entries.PushBack(std::make_pair(signature.mName, std::move(datum)));
+		}
+		return entries;
+	}
+
+	inline RTTI::IdType TypeRegistry::NearestRegisteredAncestor(RTTI::IdType type)
+	{
+		const std::span<const RTTI::IdType> ancestry = RTTI::FindAncestry(type);
+		for (size_t i = ancestry.size(); i > 1; --i)	//the last entry is type itself
+		{
+			if (mRegistry->ContainsKey(ancestry[i - 2])) { return ancestry[i - 2]; }
+		}
+		return RTTI::TypeIdClass();
+	}
+
+	inline void TypeRegistry::Insert(RTTI::IdType type, const Vector<Signature>& signatures, Materialization materialization)
+	{
+		mRegistry->Insert({ type, TypeInfo(type, signatures, materialization) });
+	}
+
+	inline void TypeRegistry::RegisterType(RTTI::IdType type, const Vector<Signature>& signatures, Materialization materialization)
+	{
+		assert(mRegistry != nullptr);
+		if (NearestRegisteredAncestor(type) != RTTI::TypeIdClass())
+		{
+			throw std::runtime_error("A type with a registered ancestor must be registered with it as the parent type");
+		}
+		Insert(type, signatures, materialization);
+	}
+
+	inline void TypeRegistry::RegisterType(RTTI::IdType type, const Vector<Signature>& signatures, RTTI::IdType parentType, Materialization materialization)
 	{
 		assert(mRegistry != nullptr);
-		mRegistry->Insert({ type, signatures });
+		const TypeInfo& parent = mRegistry->At(parentType);
+		const RTTI::IdType ancestor = NearestRegisteredAncestor(type);
+		if (ancestor != parentType && ancestor != RTTI::TypeIdClass())
+		{
+			throw std::runtime_error("The parent type must be the type's nearest registered ancestor");
+		}
+		Vector<Signature> flattened = parent.mSignatures;
+		for (const Signature& signature : signatures)
+		{
+			auto it = parent.mIndices.Find(signature.mName);
+			if (it != parent.mIndices.end())
+			{
+				flattened[it->second] = signature;	//redeclared, e.g. with the derived class's offset
+			}
+			else
+			{
+				flattened.PushBack(signature);
+			}
+		}
+		Insert(type, flattened, materialization);
 	}
 
 	inline size_t TypeRegistry::Size()
@@ -35,7 +116,27 @@ namespace Library
 	inline const Vector<Signature>& TypeRegistry::GetSignatures(RTTI::IdType type)
 	{
 		assert(mRegistry != nullptr);
-		return mRegistry->At(type);
+		return mRegistry->At(type).mSignatures;
+	}
+
+	inline const Scope::Layout& TypeRegistry::GetLayout(RTTI::IdType type)
+	{
+		assert(mRegistry != nullptr);
+		return mRegistry->At(type).mLayout;
+	}
+
+	inline TypeRegistry::Materialization TypeRegistry::GetMaterialization(RTTI::IdType type)
+	{
+		assert(mRegistry != nullptr);
+		return mRegistry->At(type).mMaterialization;
+	}
+
+	inline const Signature* TypeRegistry::FindSignature(RTTI::IdType type, const std::string& name)
+	{
+		assert(mRegistry != nullptr);
+		const TypeInfo& info = mRegistry->At(type);
+		auto it = info.mIndices.Find(name);
+		return (it != info.mIndices.end() ? &info.mSignatures[it->second] : nullptr);
 	}
 	inline void TypeRegistry::DeregisterType(RTTI::IdType type)
 	{
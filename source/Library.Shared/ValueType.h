@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <concepts>
+#include <functional>
+
+namespace Library
+{
+	/// <summary>
+	/// Describes a trivially copyable user type that a Datum can store inline (DatumType::Custom),
+	/// so arrays of it are contiguous instead of one heap object per element behind an RTTI*.
+	/// There is exactly one ValueType per C++ type, so the address of the descriptor is its type id.
+	/// </summary>
+	/// <remarks>
+	/// Types whose equal values are equal bytes (std::has_unique_object_representations) are compared and hashed bytewise.
+	/// Any other type, e.g. one with padding or float members, must define operator== and specialize std::hash.
+	/// </remarks>
+	class ValueType final
+	{
+	public:
+		using IdType = const ValueType*;
+
+		ValueType(const ValueType& rhs) = delete;
+		ValueType(ValueType&& rhs) noexcept = delete;
+		ValueType& operator=(const ValueType& rhs) = delete;
+		ValueType& operator=(ValueType&& rhs) noexcept = delete;
+		~ValueType() = default;
+
+		/// <summary>
+		/// Registers T as a value type on first use and returns its descriptor
+		/// </summary>
+		/// <returns>The descriptor for T, the same object on every call</returns>
+		template<typename T>
+		static const ValueType& Of();
+
+		/// <summary>
+		/// The type id, unique per registered type
+		/// </summary>
+		/// <returns>The type id</returns>
+		IdType Id() const noexcept;
+
+		/// <summary>
+		/// The size of one element in bytes
+		/// </summary>
+		/// <returns>The size of one element in bytes</returns>
+		size_t Size() const noexcept;
+
+		/// <summary>
+		/// The alignment of one element in bytes
+		/// </summary>
+		/// <returns>The alignment of one element in bytes</returns>
+		size_t Alignment() const noexcept;
+
+		/// <summary>
+		/// Compares two arrays of this type element by element
+		/// </summary>
+		/// <param name="lhs">the first array</param>
+		/// <param name="rhs">the second array</param>
+		/// <param name="count">the number of elements in each</param>
+		/// <returns>True if every pair of elements is equal</returns>
+		bool Equal(const void* lhs, const void* rhs, size_t count) const;
+
+		/// <summary>
+		/// Hashes an array of this type, so that arrays Equal says are equal hash the same
+		/// </summary>
+		/// <param name="data">the array</param>
+		/// <param name="count">the number of elements</param>
+		/// <returns>The hash of the elements</returns>
+		size_t Hash(const void* data, size_t count) const;
+
+	private:
+		using EqualFunction = bool (*)(const void* lhs, const void* rhs, size_t count);
+		using HashFunction = size_t (*)(const void* data, size_t count);
+
+		ValueType(size_t size, size_t alignment, EqualFunction equal, HashFunction hash);
+
+		template<typename T>
+		static bool EqualElements(const void* lhs, const void* rhs, size_t count);
+
+		template<typename T>
+		static size_t HashElements(const void* data, size_t count);
+
+		size_t mSize;
+		size_t mAlignment;
+		EqualFunction mEqual;	//nullptr if elements compare bytewise
+		HashFunction mHash;	//nullptr if elements hash bytewise
+	};
+}
+
+#include "ValueType.inl"
@@ -0,0 +1,83 @@
+#include "ValueType.h"
+#include <cstring>
+#include <string_view>
+#include <algorithm>
+#include "DefaultHash.h"
+
+namespace Library
+{
+	inline ValueType::ValueType(size_t size, size_t alignment, EqualFunction equal, HashFunction hash) :
+		mSize(size), mAlignment(alignment), mEqual(equal), mHash(hash)
+	{
+	}
+
+	template<typename T>
+	inline const ValueType& ValueType::Of()
+	{
+		//Datum copies and relocates elements bytewise and allocates with malloc/realloc
+		static_assert(std::is_trivially_copyable<T>::value, "Value types must be trivially copyable");
+		static_assert(alignof(T) <= alignof(std::max_align_t), "Value types cannot be over aligned");
+
+		//padding bytes are not copied by assignment, and equal floats can differ in bytes, so only some types can be compared as bytes
+		constexpr bool bytewise = std::has_unique_object_representations_v<T>;
+		static_assert(bytewise || (std::equality_comparable<T> && requires(const T& value) { { std::hash<T>{}(value) } -> std::convertible_to<size_t>; }),
+			"Value types that are not compared bytewise must define operator== and specialize std::hash");
+
+		if constexpr (bytewise)
+		{
+			static const ValueType sValueType(sizeof(T), alignof(T), nullptr, nullptr);
+			return sValueType;
+		}
+		else
+		{
+			static const ValueType sValueType(sizeof(T), alignof(T), &EqualElements<T>, &HashElements<T>);
+			return sValueType;
+		}
+	}
+
+	inline ValueType::IdType ValueType::Id() const noexcept
+	{
+		return this;
+	}
+
+	inline size_t ValueType::Size() const noexcept
+	{
+		return mSize;
+	}
+
+	inline size_t ValueType::Alignment() const noexcept
+	{
+		return mAlignment;
+	}
+
+	inline bool ValueType::Equal(const void* lhs, const void* rhs, size_t count) const
+	{
+		return (mEqual != nullptr ? mEqual(lhs, rhs, count) : memcmp(lhs, rhs, count * mSize) == 0);
+	}
+
+	inline size_t ValueType::Hash(const void* data, size_t count) const
+	{
+		if (mHash != nullptr) { return mHash(data, count); }
+		return std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(data), count * mSize));
+	}
+
+	template<typename T>
+	inline bool ValueType::EqualElements(const void* lhs, const void* rhs, size_t count)
+	{
+		const T* lhsElements = reinterpret_cast<const T*>(lhs);
+		const T* rhsElements = reinterpret_cast<const T*>(rhs);
+		return std::equal(lhsElements, lhsElements + count, rhsElements);
+	}
+
+	template<typename T>
+	inline size_t ValueType::HashElements(const void* data, size_t count)
+	{
+		const T* elements = reinterpret_cast<const T*>(data);
+		size_t hash = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			hash = HashCombine(hash, std::hash<T>{}(elements[i]));
+		}
+		return hash;
+	}
+}
@@ -11,8 +11,6 @@ namespace Library
 
 	World::World() : Attributed(World::TypeIdClass()), mEventQueue(mClock)
 	{
-		mSectorsDatum = Find(SECTORS_STRING);
-		assert(mSectorsDatum != nullptr);
 		mClock.UpdateGameTime(mTime);
 		mState.SetGameTime(mTime);
 		mState.mWorld = this;
@@ -21,8 +19,6 @@ namespace Library
 	World::World(const std::string& name) :
 		Attributed(World::TypeIdClass()), mName(name), mEventQueue(mClock)
 	{
-		mSectorsDatum = Find(SECTORS_STRING);
-		assert(mSectorsDatum != nullptr);
 		mClock.UpdateGameTime(mTime);
 		mState.SetGameTime(mTime);
 		mState.mWorld = this;
@@ -31,13 +27,17 @@ namespace Library
 	World::World(std::string&& name) :
 		Attributed(World::TypeIdClass()), mName(std::move(name)), mEventQueue(mClock)
 	{
-		mSectorsDatum = Find(SECTORS_STRING);
-		assert(mSectorsDatum != nullptr);
 		mClock.UpdateGameTime(mTime);
 		mState.SetGameTime(mTime);
 		mState.mWorld = this;
 	}
 
+	World::~World()
+	{
+		mReclaimer.ReclaimAll();
+		Clear();
+	}
+
 	const GameClock& World::GetGameClock() const
 	{
 		return mClock;
@@ -85,35 +85,38 @@ namespace Library
 		mClock.UpdateGameTime(mTime);
 		mEventQueue.Update(mTime);
 		AddActions();
-		for (size_t i = 0; i < mSectorsDatum->Size(); i++)
+		Datum& sectors = Sectors();
+		for (size_t i = 0; i < sectors.Size();)
 		{
-			Scope& sector = mSectorsDatum->Get<Scope>(i);
-			assert(sector.Is(Sector::TypeIdClass()));
+			Scope& sector = sectors.Get<Scope>(i);
+			assert(sector.Is<Sector>());
 			mState.mSector = &static_cast<Sector&>(sector);
 			static_cast<Sector&>(sector).Update(mState);
+			//a sector that removed itself (e.g. DestroyDeferred) leaves the next one in its slot
+			if (i < sectors.Size() && &sectors.Get<Scope>(i) == &sector) { ++i; }
 		}
 		mState.mSector = nullptr; //reset sector ptr
 		DestroyActions();
+		mReclaimer.Reclaim(RECLAIM_BUDGET);
 	}
 
 	Datum& World::Sectors()
 	{
-		assert(mSectorsDatum != nullptr); //sanity check
-		return *mSectorsDatum;
+		return PrescribedAttribute(SECTORS_INDEX);
 	}
 
 	const Datum& World::Sectors() const
 	{
-		assert(mSectorsDatum != nullptr); //sanity check
-		return *mSectorsDatum;
+		return PrescribedAttribute(SECTORS_INDEX);
 	}
 
 	Sector* World::CreateSector(const std::string& instanceName)
 	{
 		//create sector
+		ScopeArena::Activation activation(*mArena);
 		auto newSector = Factory<Scope>::Create("Sector");
 		assert(newSector != nullptr);
-		assert(newSector->Is(Sector::TypeIdClass()));
+		assert(newSector->Is<Sector>());
 
 		//set sector info
 		Sector* newSecPtr = static_cast<Sector*>(newSector);
@@ -139,24 +142,83 @@ namespace Library
 		mDestroyActionList.PushBack(&action);
 	}
 
+	void World::DestroyDeferred(Scope& scope)
+	{
+		//the queues must not reach into the subtree once it is detached
+		auto inSubtree = [&scope](const Scope* queued)
+		{
+			for (; queued != nullptr; queued = queued->GetParent())
+			{
+				if (queued == &scope) { return true; }
+			}
+			return false;
+		};
+		Vector<AddActionInfo> addActions;
+		for (auto& actionInfo : mAddActionList)
+		{
+			if (!inSubtree(actionInfo.Target)) { addActions.PushBack(std::move(actionInfo)); }
+		}
+		mAddActionList = std::move(addActions);
+		Vector<Action*> destroyActions;
+		for (Action* action : mDestroyActionList)
+		{
+			if (!inSubtree(action)) { destroyActions.PushBack(action); }
+		}
+		mDestroyActionList = std::move(destroyActions);
+
+		mReclaimer.Defer(scope);
+	}
 
 	Vector<Signature> World::Signatures()
 	{
-		return Vector<Signature>
+		return ToSignatures(StaticSignatures());
+	}
+
+	ScopeArena& World::Arena()
+	{
+		return *mArena;
+	}
+
+	void World::Compact()
+	{
+		if (!mAddActionList.IsEmpty() || !mDestroyActionList.IsEmpty())
 		{
-			Signature("Name", DatumType::String, 1, offsetof(World, mName)),
-			Signature(SECTORS_STRING, DatumType::Table, START_SECTOR_CAPACITY, 0)
-		};
+			throw std::runtime_error("Cannot compact a world with actions queued for creation or destruction");
+		}
+
+		auto arena = std::make_unique<ScopeArena>();
+		try
+		{
+			Scope::Compact(*arena);
+		}
+		catch (...)
+		{
+			//subtrees relocated before the failure live in the new arena now
+			mRetiredArenas.PushBack(std::move(arena));
+			throw;
+		}
+		std::swap(mArena, arena);
+
+		//keep a replaced arena only while something allocated from it is alive
+		Vector<std::unique_ptr<ScopeArena>> inUse;
+		if (arena->LiveAllocations() > 0) { inUse.PushBack(std::move(arena)); }
+		for (auto& retired : mRetiredArenas)
+		{
+			if (retired->LiveAllocations() > 0) { inUse.PushBack(std::move(retired)); }
+		}
+		mRetiredArenas = std::move(inUse);
 	}
 
 	void World::AddActions()
 	{
+		//only the queued actions are the world's, scopes gameplay code creates during the rest of the update come from the heap
+		ScopeArena::Activation activation(*mArena);
 		for (auto& actionInfo : mAddActionList)
 		{
 			//create action
 			Scope* actionScope = Factory<Scope>::Create(actionInfo.PrototypeName);
 			assert(actionScope != nullptr);
-			assert(actionScope->Is(Action::TypeIdClass()));
+			assert(actionScope->Is<Action>());
 			Action* actionPtr = static_cast<Action*>(actionScope);
 			//set name
 			actionPtr->SetName(actionInfo.ActionName);
@@ -4,6 +4,9 @@
 #include "Signature.h"
 #include "WorldState.h"
 #include "EventQueue.h"
+#include "ScopeArena.h"
+#include "ScopeReclaimer.h"
+#include <memory>
 
 namespace Library
 {
@@ -31,7 +34,10 @@ namespace Library
 		/// <param name="name">The name of this World</param>
 		explicit World(std::string&& name);
 
-		~World() = default;
+		/// <summary>
+		/// Destructor: deletes the sectors, and anything still waiting in DestroyDeferred, before the arena they were allocated from
+		/// </summary>
+		~World();
 
 		//No move/copy semantics: Assumption = 1 world
 		World(const World& rhs) = delete;
@@ -123,13 +129,49 @@ namespace Library
 		/// <param name="action"></param>
 		void AddActionToDestroyQueue(Action& action);
 
+		/// <summary>
+		/// Detaches a scope from this world now and deletes it over the following updates, a time budget's worth each update,
+		/// so unloading a large sector does not stall a single frame.
+		/// Actions queued to be created in or destroyed from the subtree are dropped, and its reactions stop receiving events straight away.
+		/// </summary>
+		/// <param name="scope">the HEAP ALLOCATED scope to destroy, e.g. a sector</param>
+		void DestroyDeferred(Scope& scope);
+
 		/// <summary>
 		/// Gets the prescribed attributes for a World
 		/// </summary>
 		/// <returns>The prescribed attributes for a World</returns>
 		static Vector<Signature> Signatures();
 
+		/// <summary>
+		/// The prescribed attributes as a constexpr table, see Signatures()
+		/// </summary>
+		/// <returns>A StaticSignature for each prescribed attribute</returns>
+		static constexpr std::array<StaticSignature, 2> StaticSignatures();
+
+		/// <summary>
+		/// Gets the arena this world's scopes are allocated from.
+		/// CreateSector and the creation of queued actions (AddActionToCreateQueue) activate it; activate it with a ScopeArena::Activation around anything else
+		/// that builds this world, such as JSON parsing, and nothing that may outlive it. The rest of Update allocates from the heap.
+		/// Scopes allocated from it must not outlive this world. Compact replaces it, so do not hold on to the reference across a Compact.
+		/// </summary>
+		/// <returns>A reference to the arena owned by this world</returns>
+		ScopeArena& Arena();
+
+		/// <summary>
+		/// Relocates every scope in this world into a fresh arena in traversal order (see Scope::Compact), e.g. once a level has finished loading,
+		/// so Update walks contiguous memory instead of scopes scattered by the order they were created and destroyed in.
+		/// The old arena is released once nothing allocated from it is left.
+		/// </summary>
+		/// <exception cref="std::runtime_error">Throws exception if actions are queued for creation or destruction, as the queues point into the tree</exception>
+		/// <remarks>
+		/// Every sector, entity and action is moved into a new object: pointers and references to them, to their datums, and ScopePaths through them are invalidated.
+		/// Must not be called during Update.
+		/// </remarks>
+		void Compact();
+
 		static const inline std::string SECTORS_STRING = "Sectors";
+		static const size_t SECTORS_INDEX;	//index of SECTORS_STRING in Signatures(), looked up in StaticSignatures() below. See PrescribedAttribute
 	private:
 		void AddActions();
 		void DestroyActions();
@@ -137,8 +179,8 @@ namespace Library
 		GameTime mTime;
 		WorldState mState;
 		std::string mName;
-		Datum* mSectorsDatum = nullptr;
 		static const size_t START_SECTOR_CAPACITY = 23;
+		static constexpr std::chrono::microseconds RECLAIM_BUDGET = std::chrono::microseconds(500);	//time spent deleting deferred scopes per update
 		struct AddActionInfo 
 		{
 			std::string PrototypeName; //the name of the class of action
@@ -151,6 +193,20 @@ namespace Library
 		Vector<AddActionInfo> mAddActionList;
 		Vector<Action*> mDestroyActionList;
 		EventQueue mEventQueue;
+		std::unique_ptr<ScopeArena> mArena = std::make_unique<ScopeArena>();
+		Vector<std::unique_ptr<ScopeArena>> mRetiredArenas;	//arenas replaced by Compact that scopes outside the world were still allocated from
+		ScopeReclaimer mReclaimer;	//declared after the arenas so it is destroyed before them
 	};
+
+	constexpr std::array<StaticSignature, 2> World::StaticSignatures()
+	{
+		return
+		{
+			SIGNATURE(World, "Name", DatumType::String, 1, mName),
+			TABLE_SIGNATURE("Sectors", START_SECTOR_CAPACITY)
+		};
+	}
+
+	inline constexpr size_t World::SECTORS_INDEX = SignatureIndex(World::StaticSignatures(), "Sectors");
 }
 
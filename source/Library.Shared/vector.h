@@ -219,6 +219,15 @@ namespace Library
 		/// <remarks>Calling remove on a non-existent item immediately returns.</remarks>
 		void Remove(const Iterator& it);
 
+		/// <summary>
+		/// Removes the item the iterator points at by moving the last item into its place.
+		/// Constant time, but does not preserve the order of the remaining items.
+		/// </summary>
+		/// <param name="it">the iterator pointing at the data to remove</param>
+		/// <exception cref="std::runtime_error">Throws exception if owner is not this.</exception>
+		/// <remarks>Calling remove on a non-existent item immediately returns.</remarks>
+		void RemoveUnordered(const Iterator& it);
+
 	private:
 		size_t mSize = 0;		//elements currently in vector
 		size_t mCapacity = 0;	//how many elements vector has memory to hold
@@ -298,23 +298,14 @@ namespace Library
 	template<typename T>
 	inline typename Vector<T>::Iterator Vector<T>::Find(const T& value)
 	{
-		Iterator it = begin();
-		for (; it != end(); ++it)
-		{
-			if (*it == value) { break; }
-		}
-		return it;
+		//std::find over the raw array instead of iterators, the standard library vectorizes it for arithmetic types
+		return Iterator(*this, static_cast<size_t>(std::find(mData, mData + mSize, value) - mData));
 	}
 
 	template<typename T>
 	inline typename Vector<T>::ConstIterator Vector<T>::Find(const T& value) const
 	{
-		ConstIterator it = begin();
-		for (; it != end(); ++it)
-		{
-			if (*it == value) { break; }
-		}
-		return it;
+		return ConstIterator(*this, static_cast<size_t>(std::find(mData, mData + mSize, value) - mData));
 	}
 
 	template<typename T>
@@ -342,6 +333,28 @@ namespace Library
 		mSize--;
 	}
 
+	template<typename T>
+	void Vector<T>::RemoveUnordered(const Iterator& it)
+	{
+		if (it.mOwner != this)
+		{
+			throw std::runtime_error("Iterator does not belong to this list");
+		}
+
+		if (IsEmpty() || it == end() || it.mIndex >= mSize) { return; }
+
+		if (it.mIndex == mSize - 1)
+		{
+			PopBack();
+			return;
+		}
+
+		//destruct element we are removing, then move the last element into its place
+		mData[it.mIndex].~T();
+		memcpy((mData + it.mIndex), (mData + mSize - 1), sizeof(T));
+		mSize--;
+	}
+
 
 	/************************************************************************/
 	/*************************Iterator Functions*****************************/
@@ -77,10 +77,12 @@ namespace UnitTestLibraryDesktop
 #endif
 			TypeRegistry::Create();
 			TypeRegistry::RegisterType(EventMessageAttributed::TypeIdClass(), EventMessageAttributed::Signatures());
-			TypeRegistry::RegisterType(ActionEvent::TypeIdClass(), ActionEvent::Signatures());
+			TypeRegistry::RegisterType(Action::TypeIdClass(), Action::Signatures());
+			TypeRegistry::RegisterType(ActionList::TypeIdClass(), ActionList::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ActionEvent::TypeIdClass(), ActionEvent::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(TestAction::TypeIdClass(), TestAction::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ReactionAttributed::TypeIdClass(), ReactionAttributed::Signatures(), ActionList::TypeIdClass());
 			TypeRegistry::RegisterType(World::TypeIdClass(), World::Signatures());
-			TypeRegistry::RegisterType(TestAction::TypeIdClass(), TestAction::Signatures());
-			TypeRegistry::RegisterType(ReactionAttributed::TypeIdClass(), ReactionAttributed::Signatures());
 		}
 
 		//check for memory leaks
@@ -60,11 +60,11 @@ namespace UnitTestLibraryDesktop
 			_CrtMemCheckpoint(&sStartMemState);
 #endif
 			TypeRegistry::Create();
-			//TypeRegistry::RegisterType(Action::TypeIdClass(), Action::Signatures());
 			TypeRegistry::RegisterType(Entity::TypeIdClass(), Entity::Signatures());
-			TypeRegistry::RegisterType(ActionList::TypeIdClass(), ActionList::Signatures());
-			TypeRegistry::RegisterType(TestAction::TypeIdClass(), TestAction::Signatures());
-			TypeRegistry::RegisterType(ActionListSwitch::TypeIdClass(), ActionListSwitch::Signatures());
+			TypeRegistry::RegisterType(Action::TypeIdClass(), Action::Signatures());
+			TypeRegistry::RegisterType(ActionList::TypeIdClass(), ActionList::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(TestAction::TypeIdClass(), TestAction::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ActionListSwitch::TypeIdClass(), ActionListSwitch::Signatures(), ActionList::TypeIdClass());
 		}
 
 		//check for memory leaks
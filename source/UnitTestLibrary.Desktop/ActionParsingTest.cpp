@@ -71,14 +71,15 @@ namespace UnitTestLibraryDesktop
 #endif
 			TypeRegistry::Create();
 			TypeRegistry::RegisterType(Entity::TypeIdClass(), Entity::Signatures());
-			TypeRegistry::RegisterType(ActionList::TypeIdClass(), ActionList::Signatures());
-			TypeRegistry::RegisterType(TestAction::TypeIdClass(), TestAction::Signatures());
-			TypeRegistry::RegisterType(ActionIncrement::TypeIdClass(), ActionIncrement::Signatures());
-			TypeRegistry::RegisterType(ActionCreateAction::TypeIdClass(), ActionCreateAction::Signatures());
-			TypeRegistry::RegisterType(ActionDestroyAction::TypeIdClass(), ActionDestroyAction::Signatures());
+			TypeRegistry::RegisterType(Action::TypeIdClass(), Action::Signatures());
+			TypeRegistry::RegisterType(ActionList::TypeIdClass(), ActionList::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(TestAction::TypeIdClass(), TestAction::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ActionIncrement::TypeIdClass(), ActionIncrement::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ActionCreateAction::TypeIdClass(), ActionCreateAction::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ActionDestroyAction::TypeIdClass(), ActionDestroyAction::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ActionListSwitch::TypeIdClass(), ActionListSwitch::Signatures(), ActionList::TypeIdClass());
 			TypeRegistry::RegisterType(Sector::TypeIdClass(), Sector::Signatures());
 			TypeRegistry::RegisterType(World::TypeIdClass(), World::Signatures());
-			TypeRegistry::RegisterType(ActionListSwitch::TypeIdClass(), ActionListSwitch::Signatures());
 		}
 
 		//check for memory leaks
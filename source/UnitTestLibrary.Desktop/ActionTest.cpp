@@ -73,11 +73,12 @@ namespace UnitTestLibraryDesktop
 #endif
 			TypeRegistry::Create();
 			TypeRegistry::RegisterType(Entity::TypeIdClass(), Entity::Signatures());
-			TypeRegistry::RegisterType(ActionList::TypeIdClass(), ActionList::Signatures());
-			TypeRegistry::RegisterType(TestAction::TypeIdClass(), TestAction::Signatures());
-			TypeRegistry::RegisterType(ActionIncrement::TypeIdClass(), ActionIncrement::Signatures());
-			TypeRegistry::RegisterType(ActionCreateAction::TypeIdClass(), ActionCreateAction::Signatures());
-			TypeRegistry::RegisterType(ActionDestroyAction::TypeIdClass(), ActionDestroyAction::Signatures());
+			TypeRegistry::RegisterType(Action::TypeIdClass(), Action::Signatures());
+			TypeRegistry::RegisterType(ActionList::TypeIdClass(), ActionList::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(TestAction::TypeIdClass(), TestAction::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ActionIncrement::TypeIdClass(), ActionIncrement::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ActionCreateAction::TypeIdClass(), ActionCreateAction::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ActionDestroyAction::TypeIdClass(), ActionDestroyAction::Signatures(), Action::TypeIdClass());
 			TypeRegistry::RegisterType(Sector::TypeIdClass(), Sector::Signatures());
 			TypeRegistry::RegisterType(World::TypeIdClass(), World::Signatures());
 		}
@@ -289,6 +290,24 @@ namespace UnitTestLibraryDesktop
 			Assert::IsTrue(actionIncrement->Append("Step") == 5); //sanity check
 			entity.Update(state);
 			Assert::IsTrue(entity["Health"] == 26);
+
+			//test 4: the operand follows the action when it moves to another entity
+			Entity other;
+			other.AppendAuxiliaryAttribute("Health") = 100;
+			other.AdoptAction(*actionIncrement);
+			other.Update(state);
+			Assert::IsTrue(other["Health"] == 105);
+			Assert::IsTrue(entity["Health"] == 26);
+
+			//test 5: the operand is a path, and can be changed through the attribute
+			Datum& values = other.AppendScope("Stats").Append("Values");
+			values.PushBack(1);
+			values.PushBack(2);
+			actionIncrement->Append("Operand").Set("Stats.Values[1]"s);
+			other.Update(state);
+			Assert::AreEqual(1, values.Get<int>(0));
+			Assert::AreEqual(7, values.Get<int>(1));
+			Assert::IsTrue(other["Health"] == 105);
 		}
 
 		TEST_METHOD(ActionCreateActionTest)
@@ -0,0 +1,209 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "AttributedSchema.h"
+#include "SchemaInstance.h"
+#include "TypeRegistry.h"
+#include "Entity.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Library;
+using namespace std;
+using namespace std::string_literals;
+
+namespace Microsoft::VisualStudio::CppUnitTestFramework
+{
+	template<>
+	inline std::wstring ToString<Library::DatumType>(const Library::DatumType& t)
+	{
+		RETURN_WIDE_STRING(&t);
+	}
+}
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(AttributedSchemaTests)
+	{
+	public:
+		//check for memory leaks
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&sStartMemState);
+#endif
+			TypeRegistry::Create();
+			TypeRegistry::RegisterType(Entity::TypeIdClass(), Entity::Signatures());
+		}
+
+		//check for memory leaks
+		TEST_METHOD_CLEANUP(Cleanup)
+		{
+			AttributedSchema::Clear();
+			TypeRegistry::Shutdown();
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &sStartMemState, &endMemState))
+			{
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(Load)
+		{
+			AttributedSchema::Load(R"({ "classes": [
+				{ "class": "Enemy", "parent": "Entity", "attributes": [
+					{ "name": "Health", "type": "integer" },
+					{ "name": "Position", "type": "vector" },
+					{ "name": "Taunts", "type": "string", "size": 3 },
+					{ "name": "Loot", "type": "table" } ] },
+				{ "class": "Boss", "parent": "Enemy", "attributes": [ { "name": "Phase", "type": "float" } ] },
+				{ "class": "Marker" } ] })");
+			Assert::AreEqual(3_z, AttributedSchema::Size());
+
+			const AttributedSchema* enemy = AttributedSchema::Find("Enemy"s);
+			const AttributedSchema* boss = AttributedSchema::Find("Boss"s);
+			const AttributedSchema* marker = AttributedSchema::Find("Marker"s);
+			Assert::IsNotNull(enemy);
+			Assert::IsNotNull(boss);
+			Assert::IsNotNull(marker);
+			Assert::IsNull(AttributedSchema::Find("Entity"s));
+			Assert::AreEqual("Entity"s, enemy->ParentName());
+			Assert::AreEqual("Enemy"s, boss->ParentName());
+			Assert::AreEqual("Attributed"s, marker->ParentName());
+			Assert::IsTrue(boss->Is("Boss"s) && boss->Is("Enemy"s) && boss->Is("Entity"s));
+			Assert::IsFalse(enemy->Is("Boss"s) || marker->Is("Entity"s));
+
+			//inherited attributes come first and keep their place in the storage
+			Assert::AreEqual(4_z, enemy->Attributes().Size());
+			Assert::AreEqual(5_z, boss->Attributes().Size());
+			Assert::AreEqual("Phase"s, boss->Attributes()[4].mName);
+			for (size_t i = 0; i < enemy->Attributes().Size(); ++i)
+			{
+				Assert::AreEqual(enemy->Attributes()[i].mOffset, boss->Attributes()[i].mOffset);
+			}
+			Assert::AreEqual(0_z, enemy->Attributes()[1].mOffset % alignof(glm::vec4));
+			Assert::AreEqual(0_z, marker->StorageSize());
+
+			//registered under the parent's signatures
+			Assert::IsNotNull(TypeRegistry::FindSignature(boss->TypeId(), "Health"s));
+			Assert::IsNotNull(TypeRegistry::FindSignature(boss->TypeId(), "Name"s));
+			Assert::IsNotNull(Factory<Scope>::Find("Boss"s));
+
+			AttributedSchema::Clear();
+			Assert::AreEqual(0_z, AttributedSchema::Size());
+			Assert::IsNull(Factory<Scope>::Find("Boss"s));
+			Assert::AreEqual(1_z, TypeRegistry::Size());
+		}
+
+		TEST_METHOD(Instances)
+		{
+			AttributedSchema::Load(R"({ "classes": [
+				{ "class": "Enemy", "parent": "Entity", "attributes": [
+					{ "name": "Health", "type": "integer" },
+					{ "name": "Taunts", "type": "string", "size": 2 },
+					{ "name": "Loot", "type": "table" } ] },
+				{ "class": "Boss", "parent": "Enemy", "attributes": [ { "name": "Phase", "type": "float" } ] } ] })");
+			const AttributedSchema& boss = *AttributedSchema::Find("Boss"s);
+
+			Scope* scope = Factory<Scope>::Create("Boss"s);
+			Assert::IsNotNull(scope);
+			Entity* entity = scope->As<Entity>();
+			Assert::IsNotNull(entity);
+			auto* instance = scope->As<SchemaInstance<Entity>>();
+			Assert::IsNotNull(instance);
+			Assert::IsTrue(&boss == &instance->Schema());
+
+			//the schema's attributes are prescribed, and stored after the object
+			Assert::IsTrue(entity->IsPrescribedAttribute("Health"s));
+			Assert::IsTrue(entity->IsPrescribedAttribute("Phase"s));
+			Assert::IsTrue(entity->IsPrescribedAttribute("Loot"s));
+			Assert::IsTrue(entity->IsPrescribedAttribute("Name"s));
+			Assert::AreEqual(0_z, entity->AuxiliaryAttributes().Size());
+
+			const std::byte* storage = reinterpret_cast<const std::byte*>(instance) + SchemaInstance<Entity>::StorageOffset();
+			Datum& health = *entity->Find("Health"s);
+			Datum& taunts = *entity->Find("Taunts"s);
+			Assert::AreEqual(DatumType::Integer, health.Type());
+			Assert::AreEqual(0, health.Get<int>());
+			Assert::IsTrue(reinterpret_cast<const std::byte*>(&health.Get<int>()) == storage + boss.Attributes()[0].mOffset);
+			Assert::AreEqual(2_z, taunts.Size());
+			Assert::IsTrue(reinterpret_cast<const std::byte*>(&taunts.Get<std::string>(1)) == storage + boss.Attributes()[1].mOffset + sizeof(std::string));
+			Assert::AreEqual(DatumType::Table, entity->Find("Loot"s)->Type());
+
+			health.Set(100);
+			taunts.Set("Behold"s, 1);
+			entity->SetName("Dragon"s);
+			entity->AppendScope("Loot"s);
+
+			//clones get their own storage
+			Scope* clone = scope->Clone();
+			Assert::IsTrue(*clone == *scope);
+			Datum& cloneHealth = *clone->Find("Health"s);
+			Assert::AreNotSame(health.Get<int>(), cloneHealth.Get<int>());
+			Assert::AreEqual(100, cloneHealth.Get<int>());
+			Assert::AreEqual("Behold"s, clone->Find("Taunts"s)->Get<std::string>(1));
+			cloneHealth.Set(5);
+			Assert::AreEqual(100, health.Get<int>());
+			Assert::IsFalse(*clone == *scope);
+
+			delete(clone);
+			delete(scope);
+		}
+
+		TEST_METHOD(ClearWithInstances)
+		{
+			AttributedSchema::Load(R"({ "classes": [
+				{ "class": "Enemy", "parent": "Entity", "attributes": [ { "name": "Health", "type": "integer" } ] },
+				{ "class": "Boss", "parent": "Enemy" } ] })");
+			const AttributedSchema& enemy = *AttributedSchema::Find("Enemy"s);
+			const AttributedSchema& boss = *AttributedSchema::Find("Boss"s);
+
+			Scope* scope = boss.Create();
+			Scope* clone = scope->Clone();
+			Assert::AreEqual(2_z, boss.InstanceCount());
+			Assert::AreEqual(0_z, enemy.InstanceCount());
+
+			//the instances still read their schema, so nothing is removed
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Clear(); });
+			Assert::AreEqual(2_z, AttributedSchema::Size());
+			Assert::IsNotNull(Factory<Scope>::Find("Boss"s));
+			Assert::AreEqual(1_z, clone->As<SchemaInstance<Entity>>()->Schema().Attributes().Size());
+
+			delete(clone);
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Clear(); });
+			delete(scope);
+			Assert::AreEqual(0_z, boss.InstanceCount());
+			AttributedSchema::Clear();
+			Assert::AreEqual(0_z, AttributedSchema::Size());
+			Assert::IsNull(Factory<Scope>::Find("Boss"s));
+		}
+
+		TEST_METHOD(Errors)
+		{
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Load("{ \"classes\": "s); });
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Load(R"({ "types": [] })"s); });
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Load(R"({ "classes": [ { "parent": "Entity" } ] })"s); });
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Load(R"({ "classes": [ { "class": "Entity" } ] })"s); });
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Load(R"({ "classes": [ { "class": "A", "parent": "Sector" } ] })"s); });
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Load(R"({ "classes": [ { "class": "A", "attributes": [ { "name": "X", "type": "widget" } ] } ] })"s); });
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Load(R"({ "classes": [ { "class": "A", "attributes": [ { "name": "X", "type": "integer", "size": 0 } ] } ] })"s); });
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Load(R"({ "classes": [ { "class": "A", "attributes": [ { "name": "this", "type": "integer" } ] } ] })"s); });
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Load(R"({ "classes": [ { "class": "A", "parent": "Entity", "attributes": [ { "name": "Name", "type": "string" } ] } ] })"s); });
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Load(R"({ "classes": [ { "class": "A", "attributes": [ { "name": "X", "type": "integer" }, { "name": "X", "type": "float" } ] } ] })"s); });
+			Assert::AreEqual(0_z, AttributedSchema::Size());
+
+			//classes before the error stay defined
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::Load(R"({ "classes": [ { "class": "A" }, { "class": "A" } ] })"s); });
+			Assert::AreEqual(1_z, AttributedSchema::Size());
+			Assert::ExpectException<std::runtime_error>([] { AttributedSchema::LoadFromFile("Content/NoSuchSchema.json"s); });
+		}
+
+	private:
+		static _CrtMemState sStartMemState;	//for memory leak detection
+	};
+
+	_CrtMemState AttributedSchemaTests::sStartMemState;
+}
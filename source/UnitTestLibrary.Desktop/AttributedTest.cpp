@@ -91,7 +91,21 @@ namespace UnitTestLibraryDesktop
 			Assert::IsTrue(attrFoo.Is("Scope"));
 			Assert::IsFalse(attrFoo.Is(foo.TypeIdClass()));
 			Assert::IsFalse(attrFoo.Is("Foo"));
-			
+			Assert::IsFalse(attrFoo.Is("NotAType"));
+
+			//Is<T> and As<T>, by position in the ancestry
+			Assert::AreEqual(3_z, AttributedFoo::TypeDepth());
+			Assert::AreEqual(AttributedFoo::TypeDepth(), attrFoo.AncestryInstance().size());
+			Assert::AreEqual(AttributedFoo::TypeIdClass(), attrFoo.AncestryInstance().back());	//the same id, whether or not static initialization has run
+			Assert::AreEqual(Scope::TypeIdClass(), attrFoo.AncestryInstance().front());
+			Assert::IsTrue(attrFoo.Is<AttributedFoo>());
+			Assert::IsTrue(attrFoo.Is<Attributed>());
+			Assert::IsTrue(attrFoo.Is<Scope>());
+			Assert::IsFalse(attrFoo.Is<Foo>());
+			Assert::IsFalse(scope.Is<Attributed>());
+			Scope& asScope = attrFoo;
+			Assert::IsTrue(asScope.As<AttributedFoo>() == &attrFoo);
+			Assert::IsNull(scope.As<AttributedFoo>());
 		}
 
 		TEST_METHOD(CtorAndPopulate)
@@ -182,6 +196,49 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(copyFoo, foo);
 		}
 
+		TEST_METHOD(CloneTree)
+		{
+			AttributedFoo foo;
+			foo.ExternalInteger = 55;
+			foo.AppendAuxiliaryAttribute("Aux") = 3;
+			AttributedFoo* child = new AttributedFoo();
+			child->ExternalInteger = 7;
+			foo.Adopt(*child, "Children");
+			foo.AppendScope("Children").Append("Nested") = "Value"s;
+
+			Scope* clone = foo.Clone();
+			Assert::IsTrue(clone->Is(AttributedFoo::TypeIdClass()));
+			AttributedFoo& fooClone = static_cast<AttributedFoo&>(*clone);
+			Assert::AreEqual(fooClone, foo);
+
+			//same order, prescribed attributes point at the clone
+			const auto& attributes = foo.Attributes();
+			const auto& cloneAttributes = fooClone.Attributes();
+			Assert::AreEqual(attributes.Size(), cloneAttributes.Size());
+			for (size_t i = 0; i < attributes.Size(); ++i)
+			{
+				Assert::AreEqual(attributes[i]->first, cloneAttributes[i]->first);
+			}
+			Assert::IsTrue(fooClone["this"].Get<Library::RTTI*>() == &fooClone);
+			fooClone.ExternalInteger = 10;
+			Assert::AreEqual(10, fooClone["ExternalInteger"].Get<int>());
+			Assert::AreEqual(55, foo["ExternalInteger"].Get<int>());
+
+			//children are deep copied and parented to the clone
+			Datum& children = fooClone["Children"];
+			Assert::AreEqual(2_z, children.Size());
+			Assert::IsTrue(&children[0] != child);
+			Assert::IsTrue(children[0].GetParent() == &fooClone);
+			Assert::IsTrue(children[1].GetParent() == &fooClone);
+			AttributedFoo& childClone = static_cast<AttributedFoo&>(children[0]);
+			childClone.ExternalInteger = 8;
+			Assert::AreEqual(8, childClone["ExternalInteger"].Get<int>());
+			Assert::AreEqual(7, child->ExternalInteger);
+			Assert::AreEqual("Value"s, children[1]["Nested"].Get<std::string>());
+
+			delete(clone);
+		}
+
 		TEST_METHOD(MoveSemantics)
 		{
 			//move constructor
@@ -306,6 +363,63 @@ namespace UnitTestLibraryDesktop
 			Assert::IsTrue(foo2.AuxiliaryAttributes().IsEmpty());
 		}
 
+		TEST_METHOD(PrescribedAttributeByIndex)
+		{
+			AttributedFoo foo;
+			foo.AppendAuxiliaryAttribute("Health") = 50;
+			Assert::AreEqual(foo.Find("ExternalInteger"), &foo.PrescribedAttribute(0));
+			Assert::AreEqual(foo.Find("ExternalFloat"), &foo.PrescribedAttribute(1));
+
+			//still right in a copy, which keeps the order
+			const AttributedFoo copy(foo);
+			Assert::AreEqual(copy.Find("ExternalFloat"), &copy.PrescribedAttribute(1));
+			Assert::AreEqual(&copy.ExternalInteger, &copy.PrescribedAttribute(0).Get<int>());
+
+			//an index past the prescribed attributes is not an auxiliary one
+			const size_t prescribedCount = TypeRegistry::GetSignatures(AttributedFoo::TypeIdClass()).Size();
+			Assert::ExpectException<std::runtime_error>([&foo, prescribedCount] { foo.PrescribedAttribute(prescribedCount); });
+			Assert::ExpectException<std::runtime_error>([&copy, prescribedCount] { copy.PrescribedAttribute(prescribedCount); });
+		}
+
+		TEST_METHOD(MaterializeOnFirstAccess)
+		{
+			TypeRegistry::DeregisterType(AttributedFoo::TypeIdClass());
+			TypeRegistry::RegisterType(AttributedFoo::TypeIdClass(), AttributedFoo::Signatures(), TypeRegistry::Materialization::OnFirstAccess);
+			const size_t attributeCount = TypeRegistry::GetSignatures(AttributedFoo::TypeIdClass()).Size() + 1;	//+1 because "this"
+
+			//nothing is in the table until it is used, but it looks the same from outside
+			AttributedFoo foo;
+			Assert::IsFalse(foo.IsMaterialized());
+			Assert::AreEqual(attributeCount, foo.Size());
+			foo.ExternalInteger = 10;
+			Assert::IsFalse(foo.IsMaterialized());
+			Assert::AreEqual(10, foo.Find("ExternalInteger")->Get<int>());
+			Assert::IsTrue(foo.IsMaterialized());
+			Assert::AreEqual(&foo.ExternalInteger, &foo.PrescribedAttribute(0).Get<int>());
+			Assert::IsTrue(foo["this"].Get<Library::RTTI*>() == &foo);
+
+			//copies stay deferred, and compare equal to materialized ones
+			AttributedFoo other;
+			AttributedFoo copy(other);
+			Assert::IsFalse(copy.IsMaterialized());
+			Assert::AreNotEqual(foo, copy);
+			copy.ExternalInteger = 10;
+			Assert::AreEqual(foo, copy);
+			Assert::IsTrue(copy.IsMaterialized());
+			Assert::AreEqual(&copy.ExternalInteger, &copy.PrescribedAttribute(0).Get<int>());
+
+			//auxiliary attributes still come after the prescribed ones
+			AttributedFoo auxiliary;
+			auxiliary.AppendAuxiliaryAttribute("Health") = 50;
+			Assert::AreEqual(attributeCount + 1, auxiliary.Size());
+			Assert::AreEqual(1_z, auxiliary.AuxiliaryAttributes().Size());
+			Assert::AreEqual(attributeCount, auxiliary.PrescribedAttributes().Size());
+
+			//so does searching
+			AttributedFoo searched;
+			Assert::AreEqual(&searched.ExternalInteger, &searched.Search("ExternalInteger")->Get<int>());
+		}
+
 	private:
 		static _CrtMemState sStartMemState;	//for memory leak detection
 	};
@@ -0,0 +1,178 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "CapacityProfile.h"
+#include "TypeRegistry.h"
+#include "Entity.h"
+#include <cstdio>
+#include <fstream>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Library;
+using namespace std;
+using namespace std::string_literals;
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(CapacityProfileTests)
+	{
+	public:
+		//check for memory leaks
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&sStartMemState);
+#endif
+			TypeRegistry::Create();
+			TypeRegistry::RegisterType(Entity::TypeIdClass(), Entity::Signatures());
+		}
+
+		//check for memory leaks
+		TEST_METHOD_CLEANUP(Cleanup)
+		{
+			CapacityProfile::Clear();
+			TypeRegistry::Shutdown();
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &sStartMemState, &endMemState))
+			{
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(Observe)
+		{
+			Entity entity;
+			for (size_t i = 0; i < 4; ++i)
+			{
+				entity.AppendScope("Actions"s);
+			}
+			Scope& item = entity.AppendScope("Items"s);
+			entity.AppendScope("Items"s);
+			for (size_t i = 0; i < 7; ++i)
+			{
+				item.Append("Key" + std::to_string(i));
+			}
+
+			Assert::AreEqual(Scope::DEFAULT_CAPACITY, CapacityProfile::ScopeCapacity());
+			CapacityProfile::Observe(entity);
+			Assert::AreEqual(2_z, CapacityProfile::Size());
+
+			const CapacityProfile::TypeProfile* entityProfile = CapacityProfile::Find(Entity::TypeName());
+			Assert::IsNotNull(entityProfile);
+			Assert::IsTrue(entityProfile == CapacityProfile::Find(Entity::TypeIdClass()));
+			Assert::AreEqual(entity.Size(), entityProfile->mEntries);
+			Assert::AreEqual(4_z, entityProfile->mTables.At("Actions"s));
+			Assert::AreEqual(2_z, entityProfile->mTables.At("Items"s));
+			Assert::AreEqual(4_z, CapacityProfile::TableCapacity(Entity::TypeIdClass(), "Actions"s));
+			Assert::AreEqual(0_z, CapacityProfile::TableCapacity(Entity::TypeIdClass(), "Missing"s));
+
+			//plain scopes keep the peak of every instance
+			Assert::AreEqual(7_z, CapacityProfile::Find(Scope::TypeName())->mEntries);
+			Assert::AreEqual(7_z, CapacityProfile::ScopeCapacity());
+			Assert::AreEqual(7_z, entity.AppendScope("Items"s).Capacity());
+
+			CapacityProfile::Clear();
+			Assert::AreEqual(0_z, CapacityProfile::Size());
+			Assert::IsNull(CapacityProfile::Find(Entity::TypeIdClass()));
+			Assert::AreEqual(Scope::DEFAULT_CAPACITY, CapacityProfile::ScopeCapacity());
+		}
+
+		TEST_METHOD(LongChains)
+		{
+			//one bucket for many entries, the next run should spread them out
+			Scope scope(1);
+			for (size_t i = 0; i < 6; ++i)
+			{
+				scope.Append("Key" + std::to_string(i));
+			}
+			CapacityProfile::Observe(scope);
+
+			const CapacityProfile::TypeProfile* profile = CapacityProfile::Find(Scope::TypeName());
+			Assert::AreEqual(6_z, profile->mLongestChain);
+			Assert::AreEqual(6_z, profile->mBuckets);
+			Assert::AreEqual(6_z, profile->Capacity());
+		}
+
+		TEST_METHOD(SaveLoad)
+		{
+			const std::string filename = "CapacityProfileTest.json"s;
+			{
+				Entity entity;
+				for (size_t i = 0; i < 30; ++i)
+				{
+					entity.AppendScope("Actions"s);
+				}
+				entity.Append("Health"s) = 10;
+				CapacityProfile::Observe(entity);
+			}
+			const size_t entries = CapacityProfile::Find(Entity::TypeName())->mEntries;
+			CapacityProfile::Save(filename);
+			CapacityProfile::Clear();
+
+			CapacityProfile::Load(filename);
+			Assert::AreEqual(2_z, CapacityProfile::Size());
+			const CapacityProfile::TypeProfile* profile = CapacityProfile::Find(Entity::TypeName());
+			Assert::IsNotNull(profile);
+			Assert::AreEqual(entries, profile->mEntries);
+			Assert::AreEqual(30_z, CapacityProfile::TableCapacity(Entity::TypeIdClass(), "Actions"s));
+
+			//loading again keeps the larger sizes
+			CapacityProfile::Load(filename);
+			Assert::AreEqual(entries, CapacityProfile::Find(Entity::TypeName())->mEntries);
+			std::remove(filename.c_str());
+
+			//types registered after loading start with room for what was observed
+			TypeRegistry::DeregisterType(Entity::TypeIdClass());
+			TypeRegistry::RegisterType(Entity::TypeIdClass(), Entity::Signatures());
+			Assert::AreEqual(entries, TypeRegistry::GetLayout(Entity::TypeIdClass()).Capacity());
+			Entity entity;
+			Assert::AreEqual(entries, entity.Capacity());
+			Assert::AreEqual(30_z, entity.Find("Actions"s)->Capacity());
+
+			Assert::ExpectException<std::runtime_error>([] { CapacityProfile::Load("Content/NoSuchProfile.json"s); });
+		}
+
+		TEST_METHOD(LoadTooLarge)
+		{
+			const std::string filename = "CapacityProfileTooLarge.json"s;
+			const auto write = [&filename](size_t entries, size_t actions)
+			{
+				std::ofstream file(filename);
+				file << R"({ "types": { "Entity": { "entries": )" << entries << R"(, "tables": { "Actions": )" << actions << " } } } }";
+			};
+
+			write(CapacityProfile::MAX_SIZE, CapacityProfile::MAX_SIZE);
+			CapacityProfile::Load(filename);
+			Assert::AreEqual(CapacityProfile::MAX_SIZE, CapacityProfile::Find(Entity::TypeName())->mEntries);
+			CapacityProfile::Clear();
+
+			write(CapacityProfile::MAX_SIZE + 1, 1);
+			Assert::ExpectException<std::runtime_error>([&filename] { CapacityProfile::Load(filename); });
+			write(1, 4000000000);
+			Assert::ExpectException<std::runtime_error>([&filename] { CapacityProfile::Load(filename); });
+			Assert::AreEqual(0_z, CapacityProfile::Size());
+
+			//a bad type later in the file leaves the profile as it was, including the types before it
+			write(5, 2);
+			CapacityProfile::Load(filename);
+			{
+				std::ofstream file(filename);
+				file << R"({ "types": { "Entity": { "entries": 9 }, "Sector": { "entries": )" << CapacityProfile::MAX_SIZE + 1 << " } } }";
+			}
+			Assert::ExpectException<std::runtime_error>([&filename] { CapacityProfile::Load(filename); });
+			Assert::AreEqual(1_z, CapacityProfile::Size());
+			Assert::AreEqual(5_z, CapacityProfile::Find(Entity::TypeName())->mEntries);
+			Assert::IsNull(CapacityProfile::Find("Sector"s));
+			std::remove(filename.c_str());
+		}
+
+	private:
+		static _CrtMemState sStartMemState;	//for memory leak detection
+	};
+
+	_CrtMemState CapacityProfileTests::sStartMemState;
+}
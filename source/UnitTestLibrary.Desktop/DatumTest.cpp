@@ -15,6 +15,57 @@ using namespace UnitTests;
 using namespace std;
 using namespace std::string_literals;
 
+namespace UnitTestLibraryDesktop
+{
+	//a value type with float members, so it has to say how it is compared and hashed
+	struct Particle
+	{
+		int Id;
+		float X;
+		float Y;
+		float Z;
+
+		bool operator==(const Particle& rhs) const { return Id == rhs.Id && X == rhs.X && Y == rhs.Y && Z == rhs.Z; }
+	};
+
+	//a value type with padding after Tag
+	struct Padded
+	{
+		char Tag;
+		int Id;
+
+		bool operator==(const Padded& rhs) const { return Tag == rhs.Tag && Id == rhs.Id; }
+	};
+
+	//a value type compared bytewise
+	struct Other
+	{
+		int Id;
+		int X;
+		int Y;
+		int Z;
+	};
+}
+
+template<>
+struct std::hash<UnitTestLibraryDesktop::Particle>
+{
+	size_t operator()(const UnitTestLibraryDesktop::Particle& particle) const
+	{
+		//+ 0.0f so that -0 and 0 hash the same, as they compare equal
+		return std::hash<int>{}(particle.Id) ^ std::hash<float>{}(particle.X + 0.0f) ^ std::hash<float>{}(particle.Y + 0.0f) ^ std::hash<float>{}(particle.Z + 0.0f);
+	}
+};
+
+template<>
+struct std::hash<UnitTestLibraryDesktop::Padded>
+{
+	size_t operator()(const UnitTestLibraryDesktop::Padded& padded) const
+	{
+		return std::hash<char>{}(padded.Tag) ^ std::hash<int>{}(padded.Id);
+	}
+};
+
 namespace Microsoft::VisualStudio::CppUnitTestFramework
 {
 	template<>
@@ -2487,6 +2538,41 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(RTTIDatum.ToString(), "RTTI"s);
 		}
 
+		TEST_METHOD(ToStringBuffer)
+		{
+			char buffer[32];
+
+			//test 1: default constructed datum (throw exception)
+			Datum defaultDatum;
+			Assert::ExpectException<std::runtime_error>([&defaultDatum, &buffer] { defaultDatum.ToString(buffer, sizeof(buffer)); });
+
+			//test 2: matches the string version
+			Datum floatDatum;
+			floatDatum.PushBack(5.0f);
+			floatDatum.PushBack(-2.5f);
+			size_t length = floatDatum.ToString(buffer, sizeof(buffer), 1);
+			Assert::AreEqual(string(buffer, length), floatDatum.ToString(1));
+			Assert::AreEqual(string(buffer, length), "-2.500000"s);
+
+			//test 3: buffer too small, reports full length and writes what fits
+			Datum vectorDatum;
+			vectorDatum = glm::vec4(5);
+			length = vectorDatum.ToString(buffer, sizeof(buffer));
+			Assert::AreEqual(vectorDatum.ToString().size(), length);
+			Assert::AreEqual(string(buffer, sizeof(buffer)), vectorDatum.ToString().substr(0, sizeof(buffer)));
+
+			//test 4: representation longer than the internal buffer of ToString(index)
+			Datum matrixDatum;
+			matrixDatum = glm::mat4(glm::vec4(1234567890.0f), glm::vec4(-1234567890.0f), glm::vec4(1234567890.0f), glm::vec4(-1234567890.0f));
+			string matrixString = matrixDatum.ToString();
+			Assert::IsTrue(matrixString.size() > 256);
+			Assert::AreEqual(matrixDatum.ToString(nullptr, 0), matrixString.size());
+			Datum parsedMatrix(DatumType::Matrix);
+			parsedMatrix.Resize(1, true);
+			parsedMatrix.SetFromString<glm::mat4>(matrixString);
+			Assert::AreEqual(matrixDatum, parsedMatrix);
+		}
+
 		TEST_METHOD(SetFromString)
 		{
 			//int tests
@@ -2499,6 +2585,10 @@ namespace UnitTestLibraryDesktop
 				datum.SetFromString<int>(str2, 1);
 				Assert::AreEqual(datum.Get<int>(), 5);
 				Assert::AreEqual(datum.Get<int>(1), 10);
+				datum.SetFromString<int>(" +15"s, 2);
+				datum.SetFromString<int>("-7"s, 3);
+				Assert::AreEqual(datum.Get<int>(2), 15);
+				Assert::AreEqual(datum.Get<int>(3), -7);
 
 				//invalid string
 				Assert::ExpectException<invalid_argument>([&datum] { datum.SetFromString<int>("bleh"s); });
@@ -2558,6 +2648,451 @@ namespace UnitTestLibraryDesktop
 			}
 		}
 
+		TEST_METHOD(CompactTypes)
+		{
+			//bool
+			{
+				Datum datum;
+				datum = true;
+				Assert::AreEqual(DatumType::Boolean, datum.Type());
+				Assert::IsTrue(datum == true);
+				Assert::IsTrue(datum != false);
+				datum.PushBack(false);
+				Assert::AreEqual(1_z, datum.Find(false));
+				Assert::AreEqual("false"s, datum.ToString(1));
+				datum.SetFromString<bool>("false"s);
+				datum.SetFromString<bool>("true"s, 1);
+				Assert::IsFalse(datum.Get<bool>());
+				Assert::IsTrue(datum.Get<bool>(1));
+				Assert::IsTrue(datum.Remove(false));
+				Assert::AreEqual(1_z, datum.Size());
+				Assert::ExpectException<invalid_argument>([&datum] { datum.SetFromString<bool>("bleh"s); });
+				Assert::ExpectException<invalid_argument>([&datum] { datum.SetFromString<bool>("10"s); });
+				Assert::ExpectException<invalid_argument>([&datum] { datum.SetFromString<bool>("truex"s); });
+				Assert::ExpectException<invalid_argument>([&datum] { datum.SetFromString<bool>("false0"s); });
+				Assert::ExpectException<invalid_argument>([&datum] { datum.SetFromString<bool>(""s); });
+				datum.SetFromString<bool>(" 1 "s);
+				Assert::IsTrue(datum.Get<bool>());
+				Assert::ExpectException<std::runtime_error>([&datum] { datum = 5; });
+			}
+
+			//int64
+			{
+				const std::int64_t big = 9000000000000000001;
+				Datum datum;
+				datum = big;
+				Assert::AreEqual(DatumType::Integer64, datum.Type());
+				Assert::IsTrue(datum == big);
+				datum.PushBack(std::int64_t(-1));
+				Assert::AreEqual(1_z, datum.Find(std::int64_t(-1)));
+				Assert::AreEqual("9000000000000000001"s, datum.ToString());
+				datum.Set(std::int64_t(0), 1);
+				datum.SetFromString<std::int64_t>(datum.ToString(), 1);
+				Assert::AreEqual(big, datum.Get<std::int64_t>(1));
+				Assert::ExpectException<out_of_range>([&datum] { datum.SetFromString<std::int64_t>("99999999999999999999"s); });
+			}
+
+			//double
+			{
+				Datum datum;
+				datum = 0.1;
+				Assert::AreEqual(DatumType::Double, datum.Type());
+				Assert::IsTrue(datum == 0.1);
+				datum.PushBack(1e300);
+				Assert::AreEqual(1_z, datum.Find(1e300));
+				Assert::AreEqual("0.1"s, datum.ToString());
+				datum.SetFromString<double>("2.5"s, 1);
+				Assert::AreEqual(2.5, datum.Get<double>(1));
+			}
+
+			//vec2
+			{
+				Datum datum;
+				datum = glm::vec2(1.0f, 2.0f);
+				Assert::AreEqual(DatumType::Vector2, datum.Type());
+				Assert::IsTrue(datum == glm::vec2(1.0f, 2.0f));
+				datum.PushBack(glm::vec2(3.0f));
+				Assert::AreEqual(1_z, datum.Find(glm::vec2(3.0f)));
+				Assert::AreEqual("vec2(1.000000, 2.000000)"s, datum.ToString());
+				datum.SetFromString<glm::vec2>("vec2(5.500000, -1.000000)"s, 1);
+				Assert::IsTrue(datum.Get<glm::vec2>(1) == glm::vec2(5.5f, -1.0f));
+				Assert::ExpectException<std::runtime_error>([&datum] { datum.SetFromString<glm::vec2>("vec4(1, 2, 3, 4)"s); });
+			}
+
+			//vec3
+			{
+				Datum datum;
+				datum = glm::vec3(1.0f, 2.0f, 3.0f);
+				Assert::AreEqual(DatumType::Vector3, datum.Type());
+				Assert::IsTrue(datum == glm::vec3(1.0f, 2.0f, 3.0f));
+				datum.PushBack(glm::vec3(3.0f));
+				Assert::AreEqual(1_z, datum.Find(glm::vec3(3.0f)));
+				Assert::AreEqual("vec3(1.000000, 2.000000, 3.000000)"s, datum.ToString());
+				datum.SetFromString<glm::vec3>(datum.ToString(), 1);
+				Assert::IsTrue(datum.Get<glm::vec3>(1) == glm::vec3(1.0f, 2.0f, 3.0f));
+			}
+
+			//quat
+			{
+				const glm::quat rotation(0.5f, 0.5f, -0.5f, 0.5f);
+				Datum datum;
+				datum = rotation;
+				Assert::AreEqual(DatumType::Quaternion, datum.Type());
+				Assert::IsTrue(datum == rotation);
+				datum.PushBack(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+				Assert::AreEqual(0_z, datum.Find(rotation));
+				Assert::AreEqual("quat(0.500000, 0.500000, -0.500000, 0.500000)"s, datum.ToString());
+				datum.SetFromString<glm::quat>(datum.ToString(), 1);
+				Assert::IsTrue(datum.Get<glm::quat>(1) == rotation);
+			}
+
+			//external storage
+			{
+				glm::vec2 positions[3];
+				Datum datum;
+				datum.SetStorage(positions, 3);
+				datum.Set(glm::vec2(7.0f), 2);
+				Assert::IsTrue(positions[2] == glm::vec2(7.0f));
+				Assert::ExpectException<std::runtime_error>([&datum] { datum.PushBack(glm::vec2(1.0f)); });
+			}
+
+			//string literals still pick the string overloads
+			{
+				Datum datum;
+				datum = "Meow";
+				Assert::AreEqual(DatumType::String, datum.Type());
+				Assert::IsTrue(datum == "Meow");
+				datum.PushBack("Woof");
+				Assert::AreEqual(1_z, datum.Find("Woof"));
+				Assert::IsTrue(datum.Remove("Meow"));
+			}
+		}
+
+		TEST_METHOD(EveryTypeCopyCompareClear)
+		{
+			for (DatumType type = DatumType::Begin; type <= DatumType::End; type = static_cast<DatumType>(static_cast<int>(type) + 1))
+			{
+				Datum datum(type);
+				if (type == DatumType::Table)
+				{
+					Assert::ExpectException<std::runtime_error>([&datum] { datum.Resize(3, true); });
+					continue;
+				}
+				if (type == DatumType::Custom)
+				{
+					Assert::ExpectException<std::runtime_error>([&datum] { datum.Resize(3, true); });
+					datum.SetType(ValueType::Of<Particle>());
+				}
+
+				datum.Resize(3, true);
+				Assert::AreEqual(3_z, datum.Size());
+
+				Datum copy(datum);
+				Assert::AreEqual(datum, copy);
+				copy.PopBack();
+				Assert::AreNotEqual(datum, copy);
+
+				copy = datum;
+				Assert::AreEqual(datum, copy);
+				Assert::IsTrue(copy.RemoveAt(1));
+				Assert::AreEqual(2_z, copy.Size());
+
+				datum.Clear();
+				Assert::AreEqual(0_z, datum.Size());
+				Assert::AreEqual(3_z, datum.Capacity());
+			}
+		}
+
+		TEST_METHOD(CustomValueTypes)
+		{
+			Datum datum;
+			Assert::IsNull(datum.CustomType());
+			datum.PushBack(Particle{ 1, 2.0f, 3.0f });
+			datum.PushBack(Particle{ 4, 5.0f, 6.0f });
+			Assert::AreEqual(DatumType::Custom, datum.Type());
+			Assert::IsTrue(datum.CustomType() == &ValueType::Of<Particle>());
+			Assert::AreEqual(sizeof(Particle), datum.CustomType()->Size());
+			Assert::AreEqual(2_z, datum.Size());
+			Assert::AreEqual(4, datum.Get<Particle>(1).Id);
+			Assert::AreEqual(5.0f, datum.Get<Particle>(1).X);
+
+			datum.Set(Particle{ 7, 8.0f, 9.0f }, 0);
+			Assert::AreEqual(7, datum.Get<Particle>().Id);
+			Assert::ExpectException<std::runtime_error>([&datum] { datum.Set(Particle{}, 2); });
+			Assert::ExpectException<std::runtime_error>([&datum] { datum.Get<Particle>(2); });
+
+			//elements are contiguous and editable in place
+			gsl::span<Particle> particles = datum.Span<Particle>();
+			Assert::AreEqual(2_z, particles.size());
+			for (Particle& particle : particles)
+			{
+				particle.Y += 1.0f;
+			}
+			Assert::AreEqual(10.0f, datum.Get<Particle>(0).Y);
+			Assert::AreEqual(7.0f, datum.Get<Particle>(1).Y);
+
+			//wrong type
+			Assert::ExpectException<std::runtime_error>([&datum] { datum.Get<Other>(); });
+			Assert::ExpectException<std::runtime_error>([&datum] { datum.Get<int>(); });
+			Assert::ExpectException<std::runtime_error>([&datum] { datum.PushBack(Other{}); });
+			Assert::ExpectException<std::runtime_error>([&datum] { datum.Span<Other>(); });
+			Assert::ExpectException<std::runtime_error>([&datum] { datum.SetType(ValueType::Of<Other>()); });
+			Assert::ExpectException<std::runtime_error>([&datum] { datum.PushBack(1); });
+
+			//no string form
+			Assert::ExpectException<std::runtime_error>([&datum] { datum.ToString(); });
+
+			//copy and compare
+			Datum copy = datum;
+			Assert::AreEqual(datum, copy);
+			copy.Get<Particle>(1).Id = 42;
+			Assert::AreNotEqual(datum, copy);
+			const Datum& constCopy = copy;
+			Assert::AreEqual(42, constCopy.Get<Particle>(1).Id);
+			Assert::AreEqual(2_z, constCopy.Span<Particle>().size());
+
+			//same layout, different type
+			Datum other;
+			other.PushBack(Other{ 7, 10, 9 });
+			other.PushBack(Other{ 4, 7, 6 });
+			Assert::AreNotEqual(datum, other);
+
+			//value types are zero initialized
+			datum.Resize(4, true);
+			Assert::AreEqual(0, datum.Get<Particle>(3).Id);
+			Assert::AreEqual(0.0f, datum.Get<Particle>(3).Z);
+
+			Datum moved = std::move(datum);
+			Assert::IsTrue(moved.CustomType() == &ValueType::Of<Particle>());
+			Assert::AreEqual(4_z, moved.Size());
+		}
+
+		TEST_METHOD(CustomValueTypeEquality)
+		{
+			//equal by operator==, not by bytes
+			Datum zero;
+			zero.PushBack(Particle{ 1, 0.0f, 0.0f, 0.0f });
+			Datum negativeZero;
+			negativeZero.PushBack(Particle{ 1, -0.0f, 0.0f, 0.0f });
+			Assert::AreEqual(zero, negativeZero);
+			Assert::AreEqual(zero.Hash(), negativeZero.Hash());
+
+			//padding bytes that differ do not matter
+			Datum clean;
+			clean.SetType(ValueType::Of<Padded>());
+			clean.Resize(1, true);
+			Datum dirty;
+			dirty.SetType(ValueType::Of<Padded>());
+			dirty.Resize(1, true);
+			clean.Set(Padded{ 'a', 5 });
+			memset(&dirty.Get<Padded>(), 0xFF, sizeof(Padded));
+			dirty.Get<Padded>().Tag = 'a';
+			dirty.Get<Padded>().Id = 5;
+			Assert::AreEqual(clean, dirty);
+			Assert::AreEqual(clean.Hash(), dirty.Hash());
+			dirty.Get<Padded>().Id = 6;
+			Assert::AreNotEqual(clean, dirty);
+		}
+
+		TEST_METHOD(FloatEquality)
+		{
+			//== compares floats by value, like Find
+			Datum zero;
+			zero = 0.0f;
+			Datum negativeZero;
+			negativeZero = -0.0f;
+			Assert::AreEqual(0_z, negativeZero.Find(0.0f));
+			Assert::AreEqual(zero, negativeZero);
+			Assert::AreEqual(zero.Hash(), negativeZero.Hash());
+
+			Datum vectors;
+			vectors = glm::vec4(0.0f, -0.0f, 1.0f, 2.0f);
+			Datum otherVectors;
+			otherVectors = glm::vec4(-0.0f, 0.0f, 1.0f, 2.0f);
+			Assert::AreEqual(vectors, otherVectors);
+			Assert::AreEqual(vectors.Hash(), otherVectors.Hash());
+
+			Datum doubles;
+			doubles = -0.0;
+			Datum otherDoubles;
+			otherDoubles = 0.0;
+			Assert::AreEqual(doubles, otherDoubles);
+			Assert::AreEqual(doubles.Hash(), otherDoubles.Hash());
+
+			//NaN is not equal to anything, itself included
+			Datum nan;
+			nan = std::numeric_limits<float>::quiet_NaN();
+			Datum copy = nan;
+			Assert::AreEqual(nan.Size(), nan.Find(std::numeric_limits<float>::quiet_NaN()));
+			Assert::AreNotEqual(nan, copy);
+		}
+
+		TEST_METHOD(RemoveAtUnordered)
+		{
+			Datum ints;
+			Assert::IsFalse(ints.RemoveAtUnordered(0));
+			for (int i = 0; i < 5; ++i)
+			{
+				ints.PushBack(i);
+			}
+
+			Assert::IsTrue(ints.RemoveAtUnordered(1));
+			Assert::AreEqual(4_z, ints.Size());
+			Assert::AreEqual(4, ints.Get<int>(1));
+			Assert::AreEqual(3, ints.Get<int>(3));
+			Assert::IsTrue(ints.RemoveAtUnordered(3));
+			Assert::AreEqual(3_z, ints.Size());
+			Assert::AreEqual(2, ints.Get<int>(2));
+			Assert::IsFalse(ints.RemoveAtUnordered(3));
+
+			Datum strings;
+			strings.PushBack("a string long enough to be allocated on the heap"s);
+			strings.PushBack("b"s);
+			strings.PushBack("another string long enough to be allocated on the heap"s);
+			Assert::IsTrue(strings.RemoveAtUnordered(0));
+			Assert::AreEqual(2_z, strings.Size());
+			Assert::AreEqual("another string long enough to be allocated on the heap"s, strings.Get<std::string>(0));
+			Assert::AreEqual("b"s, strings.Get<std::string>(1));
+			Assert::AreEqual(0_z, strings.Find("another string long enough to be allocated on the heap"));
+			Assert::AreEqual(2_z, strings.Find("a string long enough to be allocated on the heap"));
+
+			int external[2] = { 1, 2 };
+			Datum externalDatum;
+			externalDatum.SetStorage(external, 2);
+			Assert::ExpectException<std::runtime_error>([&externalDatum] { externalDatum.RemoveAtUnordered(0); });
+		}
+
+		TEST_METHOD(Hash)
+		{
+			//equal datums hash the same
+			Datum strings;
+			strings.PushBack("Hello"s);
+			strings.PushBack("World"s);
+			Datum stringsCopy = strings;
+			Assert::AreEqual(strings.Hash(), stringsCopy.Hash());
+			stringsCopy.Set("There"s, 1);
+			Assert::AreNotEqual(strings.Hash(), stringsCopy.Hash());
+
+			Datum vectors;
+			vectors.PushBack(glm::vec4(1, 2, 3, 4));
+			Datum vectorsCopy = vectors;
+			Assert::AreEqual(vectors.Hash(), vectorsCopy.Hash());
+			vectorsCopy.Set(glm::vec4(1, 2, 3, 5));
+			Assert::AreNotEqual(vectors.Hash(), vectorsCopy.Hash());
+
+			//same bytes, different type
+			Datum integer;
+			integer = 0;
+			Datum floating;
+			floating = 0.0f;
+			Assert::AreNotEqual(integer.Hash(), floating.Hash());
+
+			//the element order matters
+			Datum ints;
+			ints.PushBack(1);
+			ints.PushBack(2);
+			Datum reversed;
+			reversed.PushBack(2);
+			reversed.PushBack(1);
+			Assert::AreNotEqual(ints.Hash(), reversed.Hash());
+
+			//empty
+			Datum empty;
+			Assert::AreEqual(empty.Hash(), Datum().Hash());
+		}
+
+		TEST_METHOD(SharedStorage)
+		{
+			Datum floats;
+			for (int i = 0; i < 100; ++i)
+			{
+				floats.PushBack(static_cast<float>(i));
+			}
+			floats.EnableSharedStorage();
+			Assert::IsFalse(floats.IsStorageShared());
+
+			//copies share the array until one of them is modified
+			Datum copy = floats;
+			const Datum& constCopy = copy;
+			Assert::IsTrue(floats.IsStorageShared());
+			Assert::IsTrue(copy.IsStorageShared());
+			Assert::IsTrue(&floats.Get<float>(0) != &constCopy.Get<float>(0));
+			Assert::IsFalse(floats.IsStorageShared());
+			Assert::IsFalse(copy.IsStorageShared());
+
+			copy = floats;
+			Assert::AreEqual(5.0f, constCopy.Get<float>(5));
+			Assert::AreEqual(100_z, constCopy.Span<float>().size());
+			Assert::IsTrue(copy.IsStorageShared());
+			Assert::AreEqual(floats, copy);
+
+			copy.Set(-1.0f, 5);
+			Assert::IsFalse(copy.IsStorageShared());
+			Assert::AreEqual(5.0f, floats.Get<float>(5));
+			Assert::AreEqual(-1.0f, copy.Get<float>(5));
+			Assert::AreEqual(100_z, copy.Size());
+
+			//every kind of modification copies first
+			{
+				Datum pushed = floats;
+				pushed.PushBack(100.0f);
+				Assert::AreEqual(100_z, floats.Size());
+				Assert::AreEqual(101_z, pushed.Size());
+			}
+			{
+				Datum popped = floats;
+				popped.PopBack();
+				Assert::AreEqual(100_z, floats.Size());
+				Assert::IsTrue(popped.RemoveAt(0));
+				Assert::AreEqual(0.0f, floats.Get<float>(0));
+				Assert::AreEqual(1.0f, popped.Get<float>(0));
+			}
+			{
+				Datum cleared = floats;
+				cleared.Clear();
+				Assert::AreEqual(0_z, cleared.Size());
+				Assert::AreEqual(floats.Capacity(), cleared.Capacity());
+				Assert::AreEqual(100_z, floats.Size());
+			}
+			{
+				Datum resized = floats;
+				resized.Resize(10);
+				Assert::AreEqual(10_z, resized.Size());
+				resized.Reserve(1000);
+				Assert::AreEqual(100_z, floats.Size());
+				resized = 3.0f;
+				Assert::AreEqual(99.0f, floats.Get<float>(99));
+			}
+			Assert::IsFalse(floats.IsStorageShared());
+
+			//the last owner frees the array, strings are destructed once
+			Datum strings;
+			strings.PushBack("a string long enough to be allocated on the heap"s);
+			strings.PushBack("another string long enough to be allocated on the heap"s);
+			strings.EnableSharedStorage();
+			Datum* stringCopy = new Datum(strings);
+			Datum moved = std::move(strings);
+			Assert::IsTrue(moved.IsStorageShared());
+			Assert::AreEqual(*stringCopy, moved);
+			stringCopy->Set("changed"s, 1);
+			Assert::AreEqual("another string long enough to be allocated on the heap"s, moved.Get<std::string>(1));
+			Datum another(*stringCopy);
+			delete stringCopy;
+			Assert::AreEqual("changed"s, another.Get<std::string>(1));
+			moved = another;
+			Assert::IsTrue(another.IsStorageShared());
+			moved.Clear();
+			Assert::AreEqual(2_z, another.Size());
+
+			//external and table storage can't be shared
+			int external[2] = { 1, 2 };
+			Datum externalDatum;
+			externalDatum.SetStorage(external, 2);
+			Assert::ExpectException<std::runtime_error>([&externalDatum] { externalDatum.EnableSharedStorage(); });
+			Datum tableDatum(DatumType::Table);
+			Assert::ExpectException<std::runtime_error>([&tableDatum] { tableDatum.EnableSharedStorage(); });
+		}
+
 	private:
 		static _CrtMemState sStartMemState;	//for memory leak detection
 	};
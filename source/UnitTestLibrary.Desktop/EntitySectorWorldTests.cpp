@@ -103,10 +103,11 @@ namespace UnitTestLibraryDesktop
 #endif
 			TypeRegistry::Create();
 			TypeRegistry::RegisterType(Entity::TypeIdClass(), Entity::Signatures());
-			TypeRegistry::RegisterType(TestEntity::TypeIdClass(), TestEntity::Signatures());
+			TypeRegistry::RegisterType(TestEntity::TypeIdClass(), TestEntity::Signatures(), Entity::TypeIdClass());
 			TypeRegistry::RegisterType(Sector::TypeIdClass(), Sector::Signatures());
 			TypeRegistry::RegisterType(World::TypeIdClass(), World::Signatures());
-			TypeRegistry::RegisterType(TestAction::TypeIdClass(), TestAction::Signatures());
+			TypeRegistry::RegisterType(Action::TypeIdClass(), Action::Signatures());
+			TypeRegistry::RegisterType(TestAction::TypeIdClass(), TestAction::Signatures(), Action::TypeIdClass());
 		}
 
 		//check for memory leaks
@@ -343,6 +344,28 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(act2.mUpdateCount, 3);
 			Assert::AreEqual(act3.mUpdateCount, 3);
 		}
+
+		TEST_METHOD(EntityDeferred)
+		{
+			TypeRegistry::DeregisterType(Entity::TypeIdClass());
+			TypeRegistry::RegisterType(Entity::TypeIdClass(), Entity::Signatures(), TypeRegistry::Materialization::OnFirstAccess);
+			SectorFactory sectorFactory;
+			World world("World"s);
+			Sector* sector = world.CreateSector("Sector"s);
+			Entity* entity = new Entity("Entity"s, sector);
+
+			//neither constructing nor updating resolves the Actions table
+			Assert::IsFalse(entity->IsMaterialized());
+			world.Update();
+			Assert::IsFalse(entity->IsMaterialized());
+
+			//searches pass a deferred scope whose layout cannot have the key, and materialize one that might
+			Assert::IsTrue(entity->Search(World::SECTORS_STRING) == &world.Sectors());
+			Assert::IsFalse(entity->IsMaterialized());
+			Assert::AreEqual("Entity"s, entity->Search("Name"s)->Get<std::string>());
+			Assert::IsTrue(entity->IsMaterialized());
+			Assert::AreEqual(0_z, entity->Actions().Size());
+		}
 		
 		/************************************************************************/
 		/**************************Sector Functions******************************/
@@ -599,6 +622,17 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(ent1.mUpdateCount, 3);
 			Assert::AreEqual(ent2.mUpdateCount, 3);
 			Assert::AreEqual(ent3.mUpdateCount, 3);
+
+			//a sector removed during the update does not make the world skip the next one, and the rest keep their order
+			ent1.mOrphansParent = true;
+			world.Update();
+			Assert::AreEqual(ent1.mUpdateCount, 4);
+			Assert::AreEqual(ent2.mUpdateCount, 4);
+			Assert::AreEqual(ent3.mUpdateCount, 4);
+			Assert::AreEqual(world.Sectors().Size(), 2_z);
+			Assert::IsTrue(&world.Sectors().Get<Scope>(0) == &sector2);
+			Assert::IsTrue(&world.Sectors().Get<Scope>(1) == &sector3);
+			Assert::IsNull(sector1.GetParent());
 		}
 
 		TEST_METHOD(WorldClockState) 
@@ -218,6 +218,28 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(hashmap0.Insert(a), hashmap0.end());*/
 		}
 
+		TEST_METHOD(InsertUnique)
+		{
+			std::pair<int, Foo> a(1, Foo(1)), b(2, Foo(2)), d(11, Foo(11));
+			Hashmap<int, Foo> hashmap(10);
+			auto it = hashmap.InsertUnique(a);
+			Assert::AreEqual((*it).second, a.second);
+			Assert::AreEqual(hashmap.Size(), 1_z);
+
+			it = hashmap.InsertUnique(b);
+			Assert::AreEqual((*it).second, b.second);
+			Assert::AreEqual(hashmap.Size(), 2_z);
+
+			//same bucket as a
+			it = hashmap.InsertUnique(d);
+			Assert::AreEqual((*it).second, d.second);
+			Assert::AreEqual(hashmap.Size(), 3_z);
+
+			Assert::AreEqual(hashmap.Find(1), hashmap.Insert(a).first);
+			Assert::AreEqual(hashmap.Find(11)->second, d.second);
+			Assert::AreEqual(hashmap.Size(), 3_z);
+		}
+
 		TEST_METHOD(Find)
 		{
 			std::pair<int, Foo> a(1, Foo(1)), b(2, Foo(2)), c(3, Foo(3)), d(11, Foo(11));
@@ -541,6 +563,18 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(it, hashmap.cbegin());
 		}
 
+		TEST_METHOD(LongestChain)
+		{
+			Hashmap<int, Foo> hashmap(1);
+			Assert::AreEqual(0_z, hashmap.LongestChain());
+			hashmap.Insert(std::make_pair(1, Foo(1)));
+			hashmap.Insert(std::make_pair(2, Foo(2)));
+			hashmap.Insert(std::make_pair(3, Foo(3)));
+			Assert::AreEqual(3_z, hashmap.LongestChain());
+			hashmap.Remove(2);
+			Assert::AreEqual(2_z, hashmap.LongestChain());
+		}
+
 	private:
 		static _CrtMemState sStartMemState;	//for memory leak detection
 	};
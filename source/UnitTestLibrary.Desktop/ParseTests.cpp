@@ -603,6 +603,33 @@ namespace UnitTestLibraryDesktop
 			Assert::IsTrue(nestedScope4["DPS"] == 22.3f);
 		}
 
+		TEST_METHOD(CompactTypes)
+		{
+			Scope scope;
+			TableSharedData sharedData(scope);
+			JsonParseMaster master(sharedData);
+			JsonTableParseHelper helper;
+			master.AddHelper(helper);
+			master.Initialize();
+
+			std::string jsonStr =
+				R"json({
+					"Visible": { "type": "bool", "value": "true" },
+					"Id": { "type": "int64", "value": "8589934592" },
+					"Time": { "type": "double", "value": "0.125" },
+					"Position": { "type": "vec2", "value": "vec2(1.000000, 2.000000)" },
+					"Scale": { "type": "vec3", "value": "vec3(1.000000, 2.000000, 3.000000)" },
+					"Rotation": { "type": "quat", "value": "quat(1.000000, 0.000000, 0.000000, 0.000000)" }
+				})json";
+			Assert::IsTrue(master.Parse(jsonStr));
+			Assert::IsTrue(scope["Visible"] == true);
+			Assert::IsTrue(scope["Id"] == std::int64_t(8589934592));
+			Assert::IsTrue(scope["Time"] == 0.125);
+			Assert::IsTrue(scope["Position"] == glm::vec2(1.0f, 2.0f));
+			Assert::IsTrue(scope["Scale"] == glm::vec3(1.0f, 2.0f, 3.0f));
+			Assert::IsTrue(scope["Rotation"] == glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+		}
+
 	private:
 		static _CrtMemState sStartMemState;	//for memory leak detection
 	};
@@ -61,12 +61,14 @@ namespace UnitTestLibraryDesktop
 			_CrtMemCheckpoint(&sStartMemState);
 #endif
 			TypeRegistry::Create();
-			TypeRegistry::RegisterType(ReactionAttributed::TypeIdClass(), ReactionAttributed::Signatures());
+			TypeRegistry::RegisterType(Action::TypeIdClass(), Action::Signatures());
+			TypeRegistry::RegisterType(ActionList::TypeIdClass(), ActionList::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ReactionAttributed::TypeIdClass(), ReactionAttributed::Signatures(), ActionList::TypeIdClass());
+			TypeRegistry::RegisterType(TestAction::TypeIdClass(), TestAction::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ActionIncrement::TypeIdClass(), ActionIncrement::Signatures(), Action::TypeIdClass());
 			TypeRegistry::RegisterType(EventMessageAttributed::TypeIdClass(), EventMessageAttributed::Signatures());
 			TypeRegistry::RegisterType(World::TypeIdClass(), World::Signatures());
 			TypeRegistry::RegisterType(Entity::TypeIdClass(), Entity::Signatures());
-			TypeRegistry::RegisterType(TestAction::TypeIdClass(), TestAction::Signatures());
-			TypeRegistry::RegisterType(ActionIncrement::TypeIdClass(), ActionIncrement::Signatures());
 		}
 
 		//check for memory leaks
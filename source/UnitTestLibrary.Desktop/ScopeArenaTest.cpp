@@ -0,0 +1,315 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "ScopeArena.h"
+#include "TypeRegistry.h"
+#include "Entity.h"
+#include "Sector.h"
+#include "World.h"
+#include "ActionListSwitch.h"
+#include "WorldState.h"
+#include "TestAction.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Library;
+using namespace std;
+using namespace std::string_literals;
+
+namespace Microsoft::VisualStudio::CppUnitTestFramework
+{
+	template<>
+	inline std::wstring ToString<ScopeArena>(ScopeArena* t)
+	{
+		RETURN_WIDE_STRING(t);
+	}
+}
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(ScopeArenaTests)
+	{
+	public:
+		//check for memory leaks
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&sStartMemState);
+#endif
+			TypeRegistry::Create();
+			TypeRegistry::RegisterType(Entity::TypeIdClass(), Entity::Signatures());
+			TypeRegistry::RegisterType(Sector::TypeIdClass(), Sector::Signatures());
+			TypeRegistry::RegisterType(World::TypeIdClass(), World::Signatures());
+			TypeRegistry::RegisterType(Action::TypeIdClass(), Action::Signatures());
+			TypeRegistry::RegisterType(ActionList::TypeIdClass(), ActionList::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ActionListSwitch::TypeIdClass(), ActionListSwitch::Signatures(), ActionList::TypeIdClass());
+			TypeRegistry::RegisterType(UnitTests::TestAction::TypeIdClass(), UnitTests::TestAction::Signatures(), Action::TypeIdClass());
+		}
+
+		//check for memory leaks
+		TEST_METHOD_CLEANUP(Cleanup)
+		{
+			TypeRegistry::Shutdown();
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &sStartMemState, &endMemState))
+			{
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(Allocate)
+		{
+			Assert::ExpectException<std::runtime_error>([] { ScopeArena arena(0); });
+
+			ScopeArena arena(256);
+			Assert::AreEqual(size_t(0), arena.BytesReserved());
+
+			void* first = arena.Allocate(1);
+			void* second = arena.Allocate(1);
+			Assert::AreEqual(size_t(2), arena.LiveAllocations());
+			Assert::IsTrue(arena.BytesReserved() >= 256);
+			Assert::AreEqual(size_t(0), reinterpret_cast<uintptr_t>(first) % alignof(std::max_align_t));
+			Assert::AreEqual(size_t(0), reinterpret_cast<uintptr_t>(second) % alignof(std::max_align_t));
+			Assert::AreNotEqual(first, second);
+
+			//larger than a chunk gets its own chunk
+			void* large = arena.Allocate(1024);
+			Assert::IsTrue(arena.BytesReserved() >= 256 + 1024);
+
+			Assert::ExpectException<std::runtime_error>([&arena] { arena.Release(); });
+			arena.Deallocate(first, 1);
+			arena.Deallocate(second, 1);
+			arena.Deallocate(large, 1024);
+			Assert::AreEqual(size_t(0), arena.LiveAllocations());
+
+			//freed blocks are reused by allocations of the same size
+			const size_t reserved = arena.BytesReserved();
+			Assert::AreEqual(second, arena.Allocate(1));
+			Assert::AreEqual(first, arena.Allocate(1));
+			Assert::AreEqual(large, arena.Allocate(1024));
+			Assert::AreEqual(reserved, arena.BytesReserved());
+			arena.Deallocate(first, 1);
+			arena.Deallocate(second, 1);
+			arena.Deallocate(large, 1024);
+
+			arena.Release();
+			Assert::AreEqual(size_t(0), arena.BytesReserved());
+
+			//reusable after release
+			void* again = arena.Allocate(8);
+			Assert::AreEqual(size_t(1), arena.LiveAllocations());
+			arena.Deallocate(again, 8);
+		}
+
+		TEST_METHOD(Activation)
+		{
+			Assert::IsNull(ScopeArena::Current());
+			ScopeArena outer;
+			ScopeArena inner;
+			{
+				ScopeArena::Activation outerActivation(outer);
+				Assert::AreEqual(&outer, ScopeArena::Current());
+				{
+					ScopeArena::Activation innerActivation(inner);
+					Assert::AreEqual(&inner, ScopeArena::Current());
+				}
+				Assert::AreEqual(&outer, ScopeArena::Current());
+			}
+			Assert::IsNull(ScopeArena::Current());
+		}
+
+		TEST_METHOD(ScopesFromArena)
+		{
+			ScopeArena arena;
+			Scope* heapScope = new Scope();
+			{
+				ScopeArena::Activation activation(arena);
+				Scope* root = new Scope();
+				Scope& child = root->AppendScope("Child");
+				child.AppendScope("Grandchild").Append("Value") = 5;
+				Assert::AreEqual(size_t(3), arena.LiveAllocations());
+
+				//copies made while the arena is active come from it too
+				Scope* copy = root->Clone();
+				Assert::AreEqual(size_t(6), arena.LiveAllocations());
+				Assert::IsTrue(*copy == *root);
+
+				//a heap scope can adopt an arena scope and still be deleted while the arena is active
+				heapScope->Adopt(*copy, "Copy");
+				delete(root);
+				Assert::AreEqual(size_t(3), arena.LiveAllocations());
+			}
+
+			Assert::ExpectException<std::runtime_error>([&arena] { arena.Release(); });
+			delete(heapScope);
+			Assert::AreEqual(size_t(0), arena.LiveAllocations());
+			arena.Release();
+		}
+
+		TEST_METHOD(WorldArena)
+		{
+			SectorFactory sectorFactory;
+			{
+				World world("World");
+				Assert::AreEqual(size_t(0), world.Arena().LiveAllocations());
+
+				Sector* first = world.CreateSector("First");
+				Sector* second = world.CreateSector("Second");
+				Assert::AreEqual(size_t(2), world.Arena().LiveAllocations());
+				Assert::IsNull(ScopeArena::Current());
+
+				{
+					ScopeArena::Activation activation(world.Arena());
+					first->AppendScope("Child");
+				}
+				Assert::AreEqual(size_t(3), world.Arena().LiveAllocations());
+
+				delete(second);
+				Assert::AreEqual(size_t(2), world.Arena().LiveAllocations());
+				Assert::AreEqual(size_t(1), world.Sectors().Size());
+
+				//queued actions are built into the world's arena, nothing else created during the update is
+				ActionListFactory actionListFactory;
+				world.AddActionToCreateQueue("ActionList", "Queued", first, "Actions");
+				world.Update();
+				Assert::AreEqual(size_t(3), world.Arena().LiveAllocations());
+				Assert::IsNull(ScopeArena::Current());
+			}
+			//world deleted its sectors before the arena
+		}
+
+		TEST_METHOD(WorldChurn)
+		{
+			SectorFactory sectorFactory;
+			EntityFactory entityFactory;
+			World world("World");
+			Sector* sector = world.CreateSector("Sector");
+
+			//spawning and destroying reuses the blocks the destroyed objects had
+			size_t reserved = 0;
+			for (size_t i = 0; i < 1000; ++i)
+			{
+				{
+					ScopeArena::Activation activation(world.Arena());
+					delete(sector->CreateEntity("Entity", "Spawned"));
+				}
+				delete(world.CreateSector("Spawned"));
+				if (i == 0) { reserved = world.Arena().BytesReserved(); }
+			}
+			Assert::AreEqual(reserved, world.Arena().BytesReserved());
+			Assert::AreEqual(size_t(1), world.Arena().LiveAllocations());
+		}
+
+		TEST_METHOD(Compact)
+		{
+			Scope root;
+			Scope& first = root.AppendScope("First");
+			first.AppendScope("Child").Append("Value") = 1;
+			root.AppendScope("Second").Append("Value") = 2;
+			first.AppendScope("Child").Append("Value") = 3;
+			Scope expected(root);
+			const Datum* value = root["Second"][0].Find("Value");
+
+			ScopeArena arena;
+			root.Compact(arena);
+			Assert::AreEqual(size_t(4), arena.LiveAllocations());
+			Assert::IsTrue(root == expected);
+
+			//the scopes were moved, not copied: their datums came along
+			Assert::IsTrue(root["Second"][0].Find("Value") == value);
+
+			//parents are fixed up and the scopes are laid out in pre-order
+			Vector<Scope*> order;
+			root.Traverse([&order](Scope& scope) { order.PushBack(&scope); });
+			Assert::AreEqual(size_t(5), order.Size());
+			for (size_t i = 1; i < order.Size(); ++i)
+			{
+				Scope& scope = *order[i];
+				Assert::IsNotNull(scope.GetParent());
+				Assert::IsTrue(scope.GetParent()->FindContainedScope(scope).first != nullptr);
+				if (i > 1) { Assert::IsTrue(order[i - 1] < order[i]); }
+			}
+			Assert::AreEqual(3, root["First"][0]["Child"][1]["Value"].Get<int>());
+
+			delete(&root["First"][0]);
+			delete(&root["Second"][0]);
+			Assert::AreEqual(size_t(0), arena.LiveAllocations());
+		}
+
+		TEST_METHOD(WorldCompact)
+		{
+			SectorFactory sectorFactory;
+			EntityFactory entityFactory;
+			{
+				World world("World");
+				for (int i = 0; i < 3; ++i)
+				{
+					Sector* sector = world.CreateSector("Sector"s + std::to_string(i));
+					ScopeArena::Activation activation(world.Arena());
+					sector->CreateEntity("Entity", "First");
+					sector->CreateEntity("Entity", "Second");
+				}
+				Assert::AreEqual(size_t(9), world.Arena().LiveAllocations());
+				ScopeArena* before = &world.Arena();
+
+				world.Compact();
+				Assert::AreNotEqual(before, &world.Arena());
+				Assert::AreEqual(size_t(9), world.Arena().LiveAllocations());
+
+				//relocated sectors use their own entities datum and name storage
+				Sector& sector = static_cast<Sector&>(world.Sectors().Get<Scope>(1));
+				Assert::AreEqual("Sector1"s, sector.Name());
+				Assert::AreEqual("Sector1"s, sector["Name"].Get<std::string>());
+				Assert::AreEqual(sector.Find(Sector::ENTITIES_STRING), &sector.Entities());
+				Assert::AreEqual(size_t(2), sector.Entities().Size());
+				Assert::IsTrue(sector.GetParent() == &world);
+				Assert::IsTrue(sector.Entities().Get<Scope>(0).GetParent() == &sector);
+				world.Update();
+
+				//the action queues point into the tree
+				world.AddActionToCreateQueue("ActionList", "Queued", &sector, "Actions");
+				Assert::ExpectException<std::runtime_error>([&world] { world.Compact(); });
+			}
+		}
+
+		TEST_METHOD(WorldCompactSwitch)
+		{
+			SectorFactory sectorFactory;
+			EntityFactory entityFactory;
+			World world("World");
+			Entity* entity = world.CreateSector("Sector"s)->CreateEntity("Entity", "Entity");
+			ActionListSwitch* actionSwitch = new ActionListSwitch();
+			entity->AdoptAction(*actionSwitch);
+			actionSwitch->AddCase(*new UnitTests::TestAction(), "Idle");
+			actionSwitch->AddCase(*new UnitTests::TestAction(), "Attack");
+			actionSwitch->SetValue("Attack");
+			world.Update();
+
+			//the relocated switch runs its own copy of the case, not the deleted original
+			world.Compact();
+			entity = static_cast<Entity*>(&static_cast<Sector&>(world.Sectors().Get<Scope>(0)).Entities().Get<Scope>(0));
+			actionSwitch = static_cast<ActionListSwitch*>(&entity->Actions().Get<Scope>(0));
+			Assert::AreEqual(size_t(2), actionSwitch->GetCases().Size());
+			auto* attack = static_cast<UnitTests::TestAction*>(actionSwitch->GetCases()["Attack"]);
+			Assert::IsTrue(attack->GetParent() == actionSwitch);
+			Assert::AreEqual(1, attack->mUpdateCount);
+			world.Update();
+			Assert::AreEqual(2, attack->mUpdateCount);
+			Assert::AreEqual(0, static_cast<UnitTests::TestAction*>(actionSwitch->GetCases()["Idle"])->mUpdateCount);
+
+			//so does a copy
+			ActionListSwitch copy(*actionSwitch);
+			WorldState state;
+			copy.Update(state);
+			Assert::AreEqual(2, attack->mUpdateCount);
+			Assert::AreEqual(3, static_cast<UnitTests::TestAction*>(copy.GetCases()["Attack"])->mUpdateCount);
+		}
+
+	private:
+		static _CrtMemState sStartMemState;	//for memory leak detection
+	};
+	_CrtMemState ScopeArenaTests::sStartMemState;
+}
@@ -0,0 +1,153 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "ScopePath.h"
+#include "Scope.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Library;
+using namespace std;
+using namespace std::string_literals;
+
+namespace Microsoft::VisualStudio::CppUnitTestFramework
+{
+	template<>
+	inline std::wstring ToString<Library::Datum>(Library::Datum* t)
+	{
+		RETURN_WIDE_STRING(t);
+	}
+}
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(ScopePathTests)
+	{
+	public:
+		//check for memory leaks
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&sStartMemState);
+#endif
+		}
+
+		//check for memory leaks
+		TEST_METHOD_CLEANUP(Cleanup)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &sStartMemState, &endMemState))
+			{
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(Parse)
+		{
+			ScopePath empty;
+			Assert::AreEqual(0_z, empty.Depth());
+			Assert::AreEqual(0_z, empty.Index());
+
+			ScopePath simple("Health");
+			Assert::AreEqual(1_z, simple.Depth());
+			Assert::AreEqual(0_z, simple.Index());
+			Assert::AreEqual("Health"s, simple.ToString());
+
+			ScopePath deep("Sectors[0].Entities[13].Position[2]");
+			Assert::AreEqual(3_z, deep.Depth());
+			Assert::AreEqual(2_z, deep.Index());
+
+			Assert::ExpectException<std::runtime_error>([] { ScopePath path(""); });
+			Assert::ExpectException<std::runtime_error>([] { ScopePath path("."); });
+			Assert::ExpectException<std::runtime_error>([] { ScopePath path("A."); });
+			Assert::ExpectException<std::runtime_error>([] { ScopePath path(".A"); });
+			Assert::ExpectException<std::runtime_error>([] { ScopePath path("A..B"); });
+			Assert::ExpectException<std::runtime_error>([] { ScopePath path("A[]"); });
+			Assert::ExpectException<std::runtime_error>([] { ScopePath path("A[1"); });
+			Assert::ExpectException<std::runtime_error>([] { ScopePath path("A[x]"); });
+			Assert::ExpectException<std::runtime_error>([] { ScopePath path("A[1]B"); });
+			Assert::ExpectException<std::runtime_error>([] { ScopePath path("[1]"); });
+		}
+
+		TEST_METHOD(Resolve)
+		{
+			Scope root;
+			Scope& sector = root.AppendScope("Sectors");
+			sector.AppendScope("Entities").Append("Health") = 10;
+			Scope& second = sector.AppendScope("Entities");
+			Datum& health = second.Append("Health");
+			health = 20;
+			health.PushBack(30);
+
+			ScopePath path("Sectors.Entities[1].Health[1]");
+			Assert::AreEqual(&health, path.Resolve(root));
+			Assert::AreEqual(30, path.Get<int>(root));
+			path.Get<int>(root) = 35;
+			Assert::AreEqual(35, health.Get<int>(1));
+
+			//cached while the hierarchy is unchanged, and while other hierarchies change
+			const auto version = root.StructureVersion();
+			Assert::AreEqual(&health, path.Resolve(root));
+			Assert::AreEqual(version, root.StructureVersion());
+			Scope unrelated;
+			unrelated.AppendScope("Sectors").Append("Health");
+			Assert::AreEqual(version, root.StructureVersion());
+			Assert::AreEqual(&health, path.Resolve(root));
+
+			//missing keys, out of range indices, and indexing a datum that is not a table
+			Assert::IsNull(ScopePath("Missing").Resolve(root));
+			Assert::IsNull(ScopePath("Sectors.Entities[2].Health").Resolve(root));
+			Assert::IsNull(ScopePath("Sectors.Entities.Missing").Resolve(root));
+			Assert::IsNull(ScopePath("Sectors.Entities.Health.Value").Resolve(root));
+			Assert::IsNull(ScopePath().Resolve(root));
+			Assert::ExpectException<std::runtime_error>([&root] { ScopePath("Missing").Get<int>(root); });
+			Assert::ExpectException<std::runtime_error>([&root] { ScopePath("Sectors.Entities[1].Health[2]").Get<int>(root); });
+
+			//the first key is searched for up the hierarchy
+			root.Append("Gravity") = 9.8f;
+			ScopePath gravity("Gravity");
+			Assert::AreEqual(9.8f, gravity.Get<float>(second));
+
+			//a different root resolves again
+			Scope other;
+			Assert::IsNull(path.Resolve(other));
+		}
+
+		TEST_METHOD(Revalidate)
+		{
+			Scope root;
+			Scope* first = new Scope();
+			first->Append("Health") = 1;
+			Scope* second = new Scope();
+			second->Append("Health") = 2;
+			root.Adopt(*first, "Entities");
+			root.Adopt(*second, "Entities");
+
+			ScopePath path("Entities[1].Health");
+			Assert::AreEqual(2, path.Get<int>(root));
+
+			//removing a sibling changes what index 1 is
+			delete(first);
+			Assert::IsNull(path.Resolve(root));
+			Assert::AreEqual(2, ScopePath("Entities[0].Health").Get<int>(root));
+
+			Scope* third = new Scope();
+			third->Append("Health") = 3;
+			root.Adopt(*third, "Entities");
+			Assert::AreEqual(3, path.Get<int>(root));
+
+			//a copy resolves against its own tree
+			Scope copy = root;
+			path.Get<int>(copy) = 4;
+			Assert::AreEqual(4, path.Get<int>(copy));
+			Assert::AreEqual(3, path.Get<int>(root));
+		}
+
+	private:
+		static _CrtMemState sStartMemState;	//for memory leak detection
+	};
+	_CrtMemState ScopePathTests::sStartMemState;
+}
@@ -0,0 +1,165 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "ScopeReclaimer.h"
+#include "Scope.h"
+#include "TypeRegistry.h"
+#include "Entity.h"
+#include "Sector.h"
+#include "World.h"
+#include "ActionList.h"
+#include "ReactionAttributed.h"
+#include "EventMessageAttributed.h"
+#include "Event.h"
+#include "TestAction.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Library;
+using namespace std;
+using namespace std::string_literals;
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(ScopeReclaimerTests)
+	{
+	public:
+		//check for memory leaks
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&sStartMemState);
+#endif
+			TypeRegistry::Create();
+			TypeRegistry::RegisterType(Entity::TypeIdClass(), Entity::Signatures());
+			TypeRegistry::RegisterType(Sector::TypeIdClass(), Sector::Signatures());
+			TypeRegistry::RegisterType(World::TypeIdClass(), World::Signatures());
+		}
+
+		//check for memory leaks
+		TEST_METHOD_CLEANUP(Cleanup)
+		{
+			TypeRegistry::Shutdown();
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &sStartMemState, &endMemState))
+			{
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(Reclaim)
+		{
+			ScopeReclaimer reclaimer;
+			Assert::IsTrue(reclaimer.IsEmpty());
+			Assert::AreEqual(size_t(0), reclaimer.Reclaim(std::chrono::microseconds(1000)));
+
+			Scope root;
+			Scope& level = root.AppendScope("Level");
+			for (int i = 0; i < 10; ++i)
+			{
+				level.AppendScope("Child").AppendScope("Grandchild").Append("Value") = i;
+			}
+			root.AppendScope("Level");
+
+			//detached straight away, the rest of the tree is untouched
+			reclaimer.Defer(level);
+			Assert::IsNull(level.GetParent());
+			Assert::AreEqual(size_t(1), root["Level"].Size());
+			Assert::AreEqual(size_t(1), reclaimer.Pending());
+
+			//an empty budget still deletes one scope, queueing its children
+			Assert::AreEqual(size_t(1), reclaimer.Reclaim(std::chrono::microseconds(0)));
+			Assert::AreEqual(size_t(10), reclaimer.Pending());
+
+			Assert::AreEqual(size_t(20), reclaimer.ReclaimAll());
+			Assert::IsTrue(reclaimer.IsEmpty());
+		}
+
+		TEST_METHOD(DestructorReclaims)
+		{
+			ScopeReclaimer reclaimer;
+			Scope* scope = new Scope();
+			Scope* child = scope;
+			for (int i = 0; i < 1000; ++i)
+			{
+				child = &child->AppendScope("Child");
+			}
+			reclaimer.Defer(*scope);
+			reclaimer.Reclaim(std::chrono::microseconds(0));
+			Assert::IsFalse(reclaimer.IsEmpty());
+			//the destructor deletes what is left, Cleanup checks for leaks
+		}
+
+		TEST_METHOD(WorldDestroyDeferred)
+		{
+			SectorFactory sectorFactory;
+			EntityFactory entityFactory;
+			{
+				World world("World");
+				Sector* sector = world.CreateSector("Level");
+				{
+					ScopeArena::Activation activation(world.Arena());
+					for (int i = 0; i < 100; ++i)
+					{
+						sector->CreateEntity("Entity", "Entity"s + std::to_string(i));
+					}
+				}
+				world.CreateSector("Kept");
+				Assert::AreEqual(size_t(102), world.Arena().LiveAllocations());
+
+				world.DestroyDeferred(*sector);
+				Assert::AreEqual(size_t(1), world.Sectors().Size());
+
+				//each update frees some of it
+				world.Update();
+				Assert::IsTrue(world.Arena().LiveAllocations() < 102);
+
+				//whatever is left is freed with the world, before its arena
+				world.DestroyDeferred(world.Sectors().Get<Scope>());
+				Assert::AreEqual(size_t(0), world.Sectors().Size());
+			}
+		}
+
+		TEST_METHOD(WorldDestroyDeferredQuiesces)
+		{
+			TypeRegistry::RegisterType(Action::TypeIdClass(), Action::Signatures());
+			TypeRegistry::RegisterType(ActionList::TypeIdClass(), ActionList::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(ReactionAttributed::TypeIdClass(), ReactionAttributed::Signatures(), ActionList::TypeIdClass());
+			TypeRegistry::RegisterType(UnitTests::TestAction::TypeIdClass(), UnitTests::TestAction::Signatures(), Action::TypeIdClass());
+			TypeRegistry::RegisterType(EventMessageAttributed::TypeIdClass(), EventMessageAttributed::Signatures());
+			SectorFactory sectorFactory;
+			EntityFactory entityFactory;
+			ActionListFactory actionListFactory;
+			{
+				World world("World");
+				Sector* sector = world.CreateSector("Level");
+				Entity* entity = sector->CreateEntity("Entity", "Listener");
+				ReactionAttributed* reaction = new ReactionAttributed("Subtype");
+				UnitTests::TestAction* response = new UnitTests::TestAction();
+				reaction->AdoptAction(*response);
+				entity->AdoptAction(*reaction);
+				world.AddActionToCreateQueue("ActionList", "Queued", entity, "Actions");
+				world.AddActionToDestroyQueue(*response);
+				Assert::AreEqual(size_t(1), Event<EventMessageAttributed>::GetSubscribers().Size());
+
+				//the waiting reaction no longer hears events
+				world.DestroyDeferred(*sector);
+				Assert::AreEqual(size_t(0), Event<EventMessageAttributed>::GetSubscribers().Size());
+				Event<EventMessageAttributed> event(EventMessageAttributed("Subtype", &world));
+				event.Deliver();
+				Assert::AreEqual(0, response->mUpdateCount);
+
+				//nor do the queues reach into it: Compact refuses a world with queued actions, and the reclaimer alone deletes the response
+				world.Compact();
+				world.Update();
+			}
+		}
+
+	private:
+		static _CrtMemState sStartMemState;	//for memory leak detection
+	};
+	_CrtMemState ScopeReclaimerTests::sStartMemState;
+}
@@ -3,6 +3,7 @@
 #include "Scope.h"
 #include "Foo.h"
 #include "Datum.h"
+#include <atomic>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace Library;
@@ -244,6 +245,87 @@ namespace UnitTestLibraryDesktop
 			Assert::IsNull(childConst.Search("M"));
 		}
 
+		TEST_METHOD(SearchCacheInvalidation)
+		{
+			Scope root;
+			root["X"] = 1;
+			Scope& middle = root.AppendScope("Middle");
+			Scope& leaf = middle.AppendScope("Leaf");
+			Scope* foundScope = nullptr;
+
+			//repeated hits and misses give the same answer
+			Assert::IsTrue(leaf.Search("X", &foundScope) == &root["X"]);
+			Assert::IsTrue(foundScope == &root);
+			Assert::IsTrue(leaf.Search("X", &foundScope) == &root["X"]);
+			Assert::IsTrue(foundScope == &root);
+			Assert::IsNull(leaf.Search("Z", &foundScope));
+			Assert::IsNull(foundScope);
+			Assert::IsNull(leaf.Search("Z"));
+
+			//appending an entry closer to the searching scope hides the cached one
+			Datum& middleX = middle.Append("X");
+			Assert::IsTrue(leaf.Search("X", &foundScope) == &middleX);
+			Assert::IsTrue(foundScope == &middle);
+
+			//a miss is found once the key is added
+			root["Z"] = 2;
+			Assert::IsTrue(leaf.Search("Z", &foundScope) == &root["Z"]);
+
+			//searches for more keys than the cache holds still hit
+			for (int i = 0; i < 100; ++i)
+			{
+				root["Key" + std::to_string(i)] = i;
+			}
+			for (int i = 0; i < 100; ++i)
+			{
+				Assert::IsTrue(leaf.Search("Key" + std::to_string(i)) == root.Find("Key" + std::to_string(i)));
+				Assert::IsNull(leaf.Search("NoKey" + std::to_string(i)));
+			}
+			Assert::IsTrue(leaf.Search("X") == &middleX);
+
+			//reparenting changes the ancestors
+			Scope other;
+			Datum& otherZ = other.Append("Z");
+			other.Adopt(middle, "Middle");
+			Assert::IsTrue(leaf.Search("Z", &foundScope) == &otherZ);
+			Assert::IsTrue(foundScope == &other);
+
+			middle.Orphan();
+			Assert::IsNull(leaf.Search("Z"));
+			Assert::IsTrue(leaf.Search("X") == &middleX);
+			delete &middle;
+		}
+
+		TEST_METHOD(SearchVersionIsPerHierarchy)
+		{
+			Scope root;
+			Scope& left = root.AppendScope("Left");
+			Scope& leaf = left.AppendScope("Leaf");
+			Scope& right = root.AppendScope("Right");
+			const std::uint64_t leafVersion = leaf.SearchVersion();
+			const std::uint64_t rootStructure = root.StructureVersion();
+			const std::uint64_t leftStructure = left.StructureVersion();
+
+			//entries in other hierarchies, and in scopes that are not ancestors, cannot change what leaf finds
+			Scope unrelated;
+			unrelated.Append("X");
+			right.Append("X");
+			right.AppendScope("Child");
+			Assert::AreEqual(leafVersion, leaf.SearchVersion());
+			Assert::AreEqual(leftStructure, left.StructureVersion());
+			Assert::AreEqual(rootStructure, root.StructureVersion());	//only right's own entries changed
+
+			//an ancestor's new entry does
+			left.Append("Y");
+			Assert::AreNotEqual(leafVersion, leaf.SearchVersion());
+			Assert::AreNotEqual(leftStructure, left.StructureVersion());
+			Assert::AreEqual(leaf.SearchVersion(), left.SearchVersion());
+			Assert::IsTrue(leaf.Search("Y") == left.Find("Y"));
+
+			//a new scope never shares a stamp with an old one
+			Assert::AreNotEqual(unrelated.SearchVersion(), Scope().SearchVersion());
+		}
+
 		TEST_METHOD(Equality)
 		{
 			{
@@ -470,6 +552,59 @@ namespace UnitTestLibraryDesktop
 
 		}
 
+		TEST_METHOD(OrphanSiblings)
+		{
+			Scope scope;
+			Scope* children[5];
+			for (auto& child : children)
+			{
+				child = new Scope();
+				scope.Adopt(*child, "Children");
+			}
+			Scope& appended = scope.AppendScope("Children");
+			Datum& datum = scope["Children"];
+			Assert::AreEqual(6_z, datum.Size());
+
+			//orphaning from the middle keeps the order and the remaining siblings can still orphan
+			children[1]->Orphan();
+			Assert::AreEqual(5_z, datum.Size());
+			Assert::IsTrue(&datum.Get<Scope>(1) == children[2]);
+			children[3]->Orphan();
+			Assert::IsTrue(&datum.Get<Scope>(2) == children[4]);
+			appended.Orphan();
+			Assert::AreEqual(3_z, datum.Size());
+			Assert::IsTrue(&datum.Get<Scope>(0) == children[0]);
+			Assert::IsTrue(&datum.Get<Scope>(1) == children[2]);
+			Assert::IsTrue(&datum.Get<Scope>(2) == children[4]);
+
+			//the datum keeps back references accurate when it is rearranged outside of Scope
+			datum.RemoveAtUnordered(0);
+			Assert::IsTrue(&datum.Get<Scope>(0) == children[4]);
+			children[4]->Orphan();
+			Assert::AreEqual(1_z, datum.Size());
+			Assert::IsTrue(&datum.Get<Scope>(0) == children[2]);
+			Assert::IsNull(children[4]->GetParent());
+
+			//a scope already removed from the datum only forgets its parent
+			children[0]->Orphan();
+			Assert::IsNull(children[0]->GetParent());
+			Assert::AreEqual(1_z, datum.Size());
+
+			//moving a child puts the new scope in its slot
+			Scope* moved = new Scope(std::move(*children[2]));
+			Assert::IsTrue(&datum.Get<Scope>(0) == moved);
+			Assert::IsTrue(moved->GetParent() == &scope);
+			moved->Orphan();
+			Assert::IsTrue(datum.IsEmpty());
+
+			delete moved;
+			delete &appended;
+			for (auto& child : children)
+			{
+				delete child;
+			}
+		}
+
 		TEST_METHOD(Find)
 		{
 			bool entryCreated;
@@ -578,6 +713,396 @@ namespace UnitTestLibraryDesktop
 			Assert::ExpectException<std::runtime_error>([&scopeConst] { scopeConst[3]; });
 		}
 
+		TEST_METHOD(StructuralHashAndDiff)
+		{
+			Scope scope;
+			scope["Name"] = "Bob"s;
+			scope["Health"] = 100;
+			Scope& child = scope.AppendScope("Children");
+			child["Position"] = glm::vec4(1, 2, 3, 4);
+			scope.AppendScope("Children")["Position"] = glm::vec4(5, 6, 7, 8);
+
+			//test 1: equal trees have equal hashes and no differences
+			Scope copy = scope;
+			Assert::AreEqual(scope, copy);
+			Assert::AreEqual(scope.StructuralHash(), copy.StructuralHash());
+			Assert::AreEqual(0_z, Scope::Diff(scope, copy).Size());
+
+			//test 2: order of entries does not matter
+			Scope reordered;
+			reordered["Health"] = 100;
+			reordered["Name"] = "Bob"s;
+			Scope other;
+			other["Name"] = "Bob"s;
+			other["Health"] = 100;
+			Assert::AreEqual(reordered, other);
+			Assert::AreEqual(reordered.StructuralHash(), other.StructuralHash());
+
+			//test 3: a change deep in the tree changes the hash, and diff finds it
+			copy["Children"][1]["Position"] = glm::vec4(5, 6, 7, 9);
+			Assert::AreNotEqual(scope.StructuralHash(), copy.StructuralHash());
+			Vector<std::string> paths = Scope::Diff(scope, copy);
+			Assert::AreEqual(1_z, paths.Size());
+			Assert::AreEqual("Children[1].Position"s, paths[0]);
+
+			//test 4: entries only in one scope, and tables of different sizes
+			copy["Health"] = 50;
+			copy["Armor"] = 10;
+			scope["Speed"] = 2.0f;
+			copy.AppendScope("Children");
+			paths = Scope::Diff(scope, copy);
+			Assert::AreEqual(4_z, paths.Size());
+			Assert::AreEqual("Health"s, paths[0]);
+			Assert::AreEqual("Children"s, paths[1]);
+			Assert::AreEqual("Speed"s, paths[2]);
+			Assert::AreEqual("Armor"s, paths[3]);
+		}
+
+		TEST_METHOD(CachedStructuralHash)
+		{
+			Scope scope;
+			scope["Health"] = 100;
+			scope.AppendScope("Children")["Position"] = glm::vec4(1, 2, 3, 4);
+			scope.AppendScope("Children")["Position"] = glm::vec4(5, 6, 7, 8);
+			Scope copy = scope;
+			scope.EnableChangeTracking();
+			copy.EnableChangeTracking();
+
+			const size_t hash = scope.StructuralHash();
+			Assert::AreEqual(hash, scope.StructuralHash());
+			Assert::AreEqual(hash, copy.StructuralHash());
+
+			//a write deep in the tree drops the cached hashes on its way up, and differing hashes rule out equality
+			Datum& position = copy["Children"][1]["Position"];
+			position = glm::vec4(5, 6, 7, 9);
+			Assert::AreNotEqual(hash, copy.StructuralHash());
+			Assert::AreNotEqual(scope, copy);
+			position = glm::vec4(5, 6, 7, 8);
+			Assert::AreEqual(hash, copy.StructuralHash());
+			Assert::AreEqual(scope, copy);
+
+			//so do writes through Get, and changes to the structure
+			copy["Health"].Get<int>() = 50;
+			Assert::AreNotEqual(hash, copy.StructuralHash());
+			copy["Health"] = 100;
+			delete(&copy["Children"][0]);
+			Assert::AreNotEqual(hash, copy.StructuralHash());
+			Assert::AreNotEqual(scope, copy);
+		}
+
+		TEST_METHOD(ChangeTracking)
+		{
+			Scope root;
+			Datum& name = root["Name"];
+			name = "Root"s;
+			Scope& child = root.AppendScope("Children");
+			Datum& health = child["Health"];
+			health = 100;
+			Scope& clean = root.AppendScope("Children");
+			clean["Health"] = 50;
+
+			//test 1: nothing is tracked until enabled
+			Vector<Scope::Change> changes;
+			Assert::IsFalse(root.HasChanges());
+			Assert::IsFalse(health.IsDirty());
+			root.EnableChangeTracking();
+			Assert::IsTrue(child.IsChangeTrackingEnabled());
+			root.CollectChanges(changes);
+			Assert::AreEqual(0_z, changes.Size());
+
+			//test 2: a write marks the datum and flags every ancestor
+			health.Set(90);
+			Assert::IsTrue(health.IsDirty());
+			Assert::IsTrue(child.HasChanges());
+			Assert::IsTrue(root.HasChanges());
+			Assert::IsFalse(clean.HasChanges());
+			health.Get<int>() -= 5;
+			root.CollectChanges(changes);
+			Assert::AreEqual(1_z, changes.Size());
+			Assert::IsTrue(changes[0].mScope == &child);
+			Assert::AreEqual("Health"s, *changes[0].mName);
+			Assert::IsTrue(changes[0].mDatum == &health);
+			Assert::IsFalse(health.IsDirty());
+			Assert::IsFalse(root.HasChanges());
+
+			//test 3: reading does not count, even through a non-const Get, iterating children does not count
+			const Datum& constHealth = health;
+			Assert::AreEqual(85, constHealth.Get<int>());
+			Assert::AreEqual(85, health.Get<int>());
+			Assert::AreEqual(2_z, root["Children"].Size());
+			root["Children"].Get<Scope>(1).Find("Health");
+			Assert::IsFalse(root.HasChanges());
+
+			//a write through a reference is recorded with MarkDirty
+			health.Get<int>() += 5;
+			Assert::IsFalse(health.IsDirty());
+			health.MarkDirty();
+			Assert::IsTrue(health.IsDirty());
+			Assert::IsTrue(root.HasChanges());
+			changes.Clear();
+			root.CollectChanges(changes);
+			Assert::AreEqual(1_z, changes.Size());
+			Assert::IsTrue(changes[0].mDatum == &health);
+
+			//test 4: every kind of write, collected once per datum
+			name = "Renamed"s;
+			name.PushBack("Other"s);
+			clean["Health"].Clear();
+			child.Append("Armor");
+			changes.Clear();
+			root.CollectChanges(changes);
+			Assert::AreEqual(3_z, changes.Size());
+			Assert::AreEqual("Name"s, *changes[0].mName);
+			Assert::AreEqual("Armor"s, *changes[1].mName);
+			Assert::AreEqual("Health"s, *changes[2].mName);
+			Assert::IsTrue(changes[2].mScope == &clean);
+
+			//test 5: scopes added later are tracked, and adding them changes the table
+			Scope* adopted = new Scope();
+			(*adopted)["Speed"] = 1.0f;
+			root.Adopt(*adopted, "Children");
+			Assert::IsTrue(adopted->IsChangeTrackingEnabled());
+			Scope& appended = child.AppendScope("Grandchildren");
+			Assert::IsTrue(appended.IsChangeTrackingEnabled());
+			changes.Clear();
+			root.CollectChanges(changes);
+			Assert::AreEqual(2_z, changes.Size());
+			Assert::AreEqual("Children"s, *changes[0].mName);
+			Assert::AreEqual("Grandchildren"s, *changes[1].mName);
+
+			(*adopted)["Speed"] = 2.0f;
+			changes.Clear();
+			root.CollectChanges(changes);
+			Assert::AreEqual(1_z, changes.Size());
+			Assert::IsTrue(changes[0].mScope == adopted);
+
+			//test 6: orphaning changes the table it was in
+			adopted->Orphan();
+			changes.Clear();
+			root.CollectChanges(changes);
+			Assert::AreEqual(1_z, changes.Size());
+			Assert::AreEqual("Children"s, *changes[0].mName);
+			delete(adopted);
+
+			//test 7: copies are not tracked, assigning to a tracked scope changes everything in it
+			Scope copy = root;
+			Assert::IsFalse(copy.IsChangeTrackingEnabled());
+			copy["Name"] = "Copy"s;
+			Assert::IsFalse(copy.HasChanges());
+			child = clean;
+			Assert::IsTrue(child.IsChangeTrackingEnabled());
+			changes.Clear();
+			root.CollectChanges(changes);
+			Assert::AreEqual(1_z, changes.Size());
+			Assert::IsTrue(changes[0].mScope == &child);
+		}
+
+		TEST_METHOD(Traverse)
+		{
+			//      A
+			//    B   E
+			//   C D   F
+			Scope a;
+			a["Name"] = "A"s;
+			Scope& b = a.AppendScope("Children");
+			b["Name"] = "B"s;
+			b.AppendScope("Children")["Name"] = "C"s;
+			b.AppendScope("Children")["Name"] = "D"s;
+			Scope& e = a.AppendScope("Other");
+			e["Name"] = "E"s;
+			e.AppendScope("Children")["Name"] = "F"s;
+
+			std::string visited;
+			auto visitor = [&visited](Scope& scope) { visited += scope["Name"].Get<std::string>(); };
+
+			//test 1: every order
+			a.Traverse(visitor);
+			Assert::AreEqual("ABCDEF"s, visited);
+			visited.clear();
+			a.Traverse(visitor, TraversalOrder::PostOrder);
+			Assert::AreEqual("CDBFEA"s, visited);
+			visited.clear();
+			a.Traverse(visitor, TraversalOrder::BreadthFirst);
+			Assert::AreEqual("ABECDF"s, visited);
+
+			//test 2: pruning
+			auto notB = [](const Scope& scope) { return scope.Find("Name")->Get<std::string>() != "B"; };
+			visited.clear();
+			a.Traverse(visitor, TraversalOrder::PreOrder, notB);
+			Assert::AreEqual("ABEF"s, visited);
+			visited.clear();
+			a.Traverse(visitor, TraversalOrder::PostOrder, notB);
+			Assert::AreEqual("BFEA"s, visited);
+			visited.clear();
+			a.Traverse(visitor, TraversalOrder::BreadthFirst, notB);
+			Assert::AreEqual("ABEF"s, visited);
+
+			//test 3: a subtree
+			visited.clear();
+			b.Traverse(visitor);
+			Assert::AreEqual("BCD"s, visited);
+		}
+
+		TEST_METHOD(TraverseParallel)
+		{
+			Scope root;
+			const int childCount = 64;
+			for (int i = 0; i < childCount; ++i)
+			{
+				Scope& child = root.AppendScope("Children");
+				child["Value"] = i;
+				child.AppendScope("Children")["Value"] = i;
+			}
+			root["Value"] = 0;
+
+			//test 1: every scope is visited once, the root first in pre order
+			std::atomic<int> count = 0;
+			bool rootFirst = false;
+			root.TraverseParallel([&count, &rootFirst, &root](Scope& scope)
+			{
+				if (&scope == &root) { rootFirst = (count == 0); }
+				++count;
+				scope["Value"].Get<int>() += 1;
+			});
+			Assert::AreEqual(childCount * 2 + 1, count.load());
+			Assert::IsTrue(rootFirst);
+			Assert::AreEqual(6, root["Children"][5]["Value"].Get<int>());
+			Assert::AreEqual(6, root["Children"][5]["Children"][0]["Value"].Get<int>());
+
+			//test 2: the root last in post order, pruning
+			count = 0;
+			bool rootLast = false;
+			root.TraverseParallel([&count, &rootLast, &root](Scope& scope)
+			{
+				++count;
+				if (&scope == &root) { rootLast = (count == childCount + 1); }
+			}, TraversalOrder::PostOrder, [&root](const Scope& scope) { return &scope == &root; });
+			Assert::AreEqual(childCount + 1, count.load());
+			Assert::IsTrue(rootLast);
+
+			//test 3: exceptions are rethrown on the calling thread
+			Assert::ExpectException<std::runtime_error>([&root]
+			{
+				root.TraverseParallel([](Scope& scope)
+				{
+					if (scope["Value"].Get<int>() == 10) { throw std::runtime_error("Visitor failed"); }
+				});
+			});
+		}
+
+		TEST_METHOD(TraverseParallelWrites)
+		{
+			Datum names;
+			names.EnableSharedStorage();
+			names.PushBack("Shared"s);
+			Scope root;
+			root["Speed"] = 2;
+			const int childCount = 256;
+			for (int i = 0; i < childCount; ++i)
+			{
+				Scope& child = root.AppendScope("Children");
+				child["Value"] = i;
+				child["Names"] = names;
+			}
+			root.EnableChangeTracking();
+			Vector<Scope::Change> changes;
+			root.CollectChanges(changes);
+			const size_t hash = root.StructuralHash();
+
+			//every visitor writes with tracking on, appends, searches above itself and stops sharing an array with the others
+			root.TraverseParallel([&root](Scope& scope)
+			{
+				if (&scope == &root) { return; }
+				Datum& value = scope["Value"];
+				value.Set(value.Get<int>() * scope.Search("Speed")->Get<int>());
+				scope["Names"].Set(std::to_string(value.Get<int>()));
+				scope.Append("Visited") = 1;
+			});
+
+			Assert::IsTrue(root.HasChanges());
+			Assert::AreNotEqual(hash, root.StructuralHash());
+			changes.Clear();
+			root.CollectChanges(changes);
+			Assert::AreEqual(childCount * 3_z, changes.Size());	//reading Speed through the non-const Get is not a change
+			for (int i = 0; i < childCount; ++i)
+			{
+				Scope& child = root["Children"][i];
+				Assert::AreEqual(i * 2, child["Value"].Get<int>());
+				Assert::AreEqual(std::to_string(i * 2), child["Names"].Get<std::string>());
+				Assert::AreEqual(1, child["Visited"].Get<int>());
+			}
+			Assert::AreEqual("Shared"s, names.Get<std::string>());
+			Assert::IsFalse(names.IsStorageShared());
+		}
+
+		TEST_METHOD(DeepTree)
+		{
+			//deep enough to overflow the stack if traversal or deletion recursed
+			const size_t depth = 100000;
+			Scope* root = new Scope();
+			Scope* scope = root;
+			for (size_t i = 0; i < depth; ++i)
+			{
+				scope = &scope->AppendScope("Child");
+			}
+
+			size_t count = 0;
+			root->Traverse([&count](Scope&) { ++count; }, TraversalOrder::PostOrder);
+			Assert::AreEqual(depth + 1, count);
+			delete(root);
+		}
+
+		TEST_METHOD(AppendEntries)
+		{
+			Scope scope;
+			scope["Existing"] = 1;
+
+			//names: existing entries are returned as they are
+			Vector<Datum*> datums = scope.AppendEntries(Vector<std::string>{ "A", "Existing", "B" });
+			Assert::AreEqual(size_t(3), datums.Size());
+			Assert::AreEqual(scope.Find("A"), datums[0]);
+			Assert::AreEqual(1, datums[1]->Get<int>());
+			Assert::AreEqual(size_t(3), scope.Size());
+			Assert::ExpectException<std::runtime_error>([&scope] { scope.AppendEntries(Vector<std::string>{ "C", "" }); });
+
+			//pairs: datums are moved in, in order
+			Vector<std::pair<std::string, Datum>> entries;
+			Datum integer;
+			integer = 5;
+			Datum text;
+			text = "Text"s;
+			entries.PushBack(std::make_pair("Integer"s, std::move(integer)));
+			entries.PushBack(std::make_pair("String"s, std::move(text)));
+			scope.AppendEntries(std::move(entries));
+			Assert::AreEqual(5, scope["Integer"].Get<int>());
+			Assert::AreEqual("Text"s, scope["String"].Get<std::string>());
+			Assert::AreEqual(scope.Find("String"), &scope[scope.Size() - 1]);
+
+			//a duplicate leaves the scope as it was
+			const size_t size = scope.Size();
+			Vector<std::pair<std::string, Datum>> duplicates;
+			duplicates.PushBack(std::make_pair("New"s, Datum()));
+			duplicates.PushBack(std::make_pair("Integer"s, Datum()));
+			Assert::ExpectException<std::runtime_error>([&scope, &duplicates] { scope.AppendEntries(std::move(duplicates)); });
+			Assert::AreEqual(size, scope.Size());
+			Assert::IsNull(scope.Find("New"));
+			Vector<std::pair<std::string, Datum>> repeated;
+			repeated.PushBack(std::make_pair("Twice"s, Datum()));
+			repeated.PushBack(std::make_pair("Twice"s, Datum()));
+			Assert::ExpectException<std::runtime_error>([&scope, &repeated] { scope.AppendEntries(std::move(repeated)); });
+			Assert::IsNull(scope.Find("Twice"));
+
+			//an empty scope is given enough buckets for the batch
+			Scope fresh;
+			Vector<Scope*> children = fresh.AppendScopes(Vector<std::string>{ "A", "B", "C", "D", "E", "F", "G", "A" });
+			Assert::AreEqual(size_t(8), children.Size());
+			Assert::AreEqual(size_t(7), fresh.Size());
+			Assert::IsTrue(fresh.Capacity() >= 8);
+			Assert::AreEqual(size_t(2), fresh["A"].Size());
+			Assert::IsTrue(&fresh["A"][1] == children[7]);
+			Assert::IsTrue(children[1]->GetParent() == &fresh);
+		}
+
 	private:
 		static _CrtMemState sStartMemState;	//for memory leak detection
 	};
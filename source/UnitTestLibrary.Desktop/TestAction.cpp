@@ -14,9 +14,7 @@ namespace UnitTests
 
 	Vector<Signature> TestAction::Signatures()
 	{
-		return Vector<Signature>
-		{
-			Signature("Name", DatumType::String, 1, offsetof(TestAction, mName))
-		};
+		//everything is inherited from Action, see the registration
+		return Vector<Signature>();
 	}
 }
\ No newline at end of file
@@ -13,8 +13,9 @@ namespace UnitTests
 		TestEntity() : Entity(TypeIdClass()) {};
 		explicit TestEntity(const std::string& name, Sector* sector = nullptr) : Entity(TypeIdClass(), name, sector) {};
 		explicit TestEntity(std::string&& name, Sector* sector = nullptr) : Entity(TypeIdClass(), std::move(name), sector) {};
-		void Update(WorldState& state) override { state;  mUpdateCount++; }; //note does not update actions here
+		void Update(WorldState& state) override { state;  mUpdateCount++; if (mOrphansParent) { GetParent()->Orphan(); } }; //note does not update actions here
 		int mUpdateCount = 0;
+		bool mOrphansParent = false;	//removes its sector from the world during Update
 		virtual gsl::owner<TestEntity*> Clone() const override { return new TestEntity(*this); };
 		static Vector<Signature> Signatures();
 	};
@@ -1,6 +1,8 @@
 #include "pch.h"
 #include "CppUnitTest.h"
 #include "TypeRegistry.h"
+#include "Entity.h"
+#include "ActionListSwitch.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace Library;
@@ -103,6 +105,110 @@ namespace UnitTestLibraryDesktop
 			TypeRegistry::Shutdown();
 		}
 
+		TEST_METHOD(RegisterWithParent)
+		{
+			TypeRegistry::Create();
+			Vector<Signature> parent;
+			parent.PushBack(Signature("Name"s, DatumType::String, 1, 8));
+			parent.PushBack(Signature("Health"s, DatumType::Integer, 1, 40));
+			TypeRegistry::RegisterType(0, parent);
+
+			//the parent's attributes come first, a redeclared one keeps the parent's position
+			Vector<Signature> child;
+			child.PushBack(Signature("Armor"s, DatumType::Float, 1, 48));
+			child.PushBack(Signature("Health"s, DatumType::Integer, 1, 44));
+			TypeRegistry::RegisterType(1, child, 0);
+			const Vector<Signature>& flattened = TypeRegistry::GetSignatures(1);
+			Assert::AreEqual(3_z, flattened.Size());
+			Assert::AreEqual("Name"s, flattened[0].mName);
+			Assert::AreEqual(44_z, flattened[1].mOffset);
+			Assert::AreEqual("Armor"s, flattened[2].mName);
+
+			//lookup by name
+			const Signature* health = TypeRegistry::FindSignature(1, "Health"s);
+			Assert::IsNotNull(health);
+			Assert::AreEqual(44_z, health->mOffset);
+			Assert::AreEqual(40_z, TypeRegistry::FindSignature(0, "Health"s)->mOffset);
+			Assert::IsNull(TypeRegistry::FindSignature(0, "Armor"s));
+			Assert::ExpectException<std::runtime_error>([] { TypeRegistry::FindSignature(2, "Name"s); });
+
+			//the parent must be registered first
+			Assert::ExpectException<std::runtime_error>([&child] { TypeRegistry::RegisterType(3, child, 2); });
+
+			TypeRegistry::Shutdown();
+		}
+
+		TEST_METHOD(Layout)
+		{
+			TypeRegistry::Create();
+			Vector<Signature> signatures;
+			signatures.PushBack(Signature("Health"s, DatumType::Integer, 1, 0));
+			signatures.PushBack(Signature("Name"s, DatumType::String, 1, 8));
+			TypeRegistry::RegisterType(0, signatures);
+
+			//"this" and one entry per signature
+			Assert::AreEqual(3_z, TypeRegistry::GetLayout(0).Size());
+			Assert::ExpectException<std::runtime_error>([] { TypeRegistry::GetLayout(1); });
+
+			Vector<std::pair<std::string, Datum>> entries;
+			entries.PushBack(std::make_pair("A"s, Datum()));
+			entries.PushBack(std::make_pair("A"s, Datum()));
+			Assert::ExpectException<std::runtime_error>([&entries] { Scope::Layout layout(std::move(entries)); });
+
+			TypeRegistry::Shutdown();
+		}
+
+		TEST_METHOD(StaticSignatures)
+		{
+			//the tables are usable at compile time
+			static_assert(Entity::StaticSignatures().size() == 2);
+			static_assert(Entity::StaticSignatures()[Entity::ACTIONS_INDEX].mType == DatumType::Table);
+			static_assert(SignatureIndex(Entity::StaticSignatures(), "Name") == 0);
+			static_assert(ActionList::ACTIONS_INDEX == Action::StaticSignatures().size());
+			Assert::ExpectException<std::runtime_error>([] { SignatureIndex(Entity::StaticSignatures(), "Missing"); });
+
+			constexpr StaticSignature health = { "Health", DatumType::Integer, 1, 40 };
+			Assert::AreEqual(Signature("Health"s, DatumType::Integer, 1, 40), Signature(health));
+
+			const Vector<Signature> signatures = Entity::Signatures();
+			Assert::AreEqual(2_z, signatures.Size());
+			Assert::AreEqual(Entity::ACTIONS_STRING, signatures[Entity::ACTIONS_INDEX].mName);
+
+			TypeRegistry::Create();
+			TypeRegistry::RegisterType(Entity::TypeIdClass(), ToSignatures(Entity::StaticSignatures()));
+			Assert::AreEqual(signatures, TypeRegistry::GetSignatures(Entity::TypeIdClass()));
+			TypeRegistry::Shutdown();
+		}
+
+		TEST_METHOD(ActionHierarchy)
+		{
+			//actions only declare what they add, "Name" comes from Action
+			TypeRegistry::Create();
+			TypeRegistry::RegisterType(Action::TypeIdClass(), Action::Signatures());
+			TypeRegistry::RegisterType(ActionList::TypeIdClass(), ActionList::Signatures(), Action::TypeIdClass());
+
+			//leaving out a registered ancestor would leave out its attributes
+			Assert::ExpectException<std::runtime_error>([] { TypeRegistry::RegisterType(ActionListSwitch::TypeIdClass(), ActionListSwitch::Signatures()); });
+			Assert::ExpectException<std::runtime_error>([] { TypeRegistry::RegisterType(ActionListSwitch::TypeIdClass(), ActionListSwitch::Signatures(), Action::TypeIdClass()); });
+			Assert::AreEqual(2_z, TypeRegistry::Size());
+
+			TypeRegistry::RegisterType(ActionListSwitch::TypeIdClass(), ActionListSwitch::Signatures(), ActionList::TypeIdClass());
+			const Vector<Signature>& signatures = TypeRegistry::GetSignatures(ActionListSwitch::TypeIdClass());
+			Assert::AreEqual(3_z, signatures.Size());
+			Assert::AreEqual("Name"s, signatures[0].mName);
+			Assert::AreEqual(ActionList::ACTIONS_STRING, signatures[ActionList::ACTIONS_INDEX].mName);
+			Assert::AreEqual("CaseValue"s, signatures[2].mName);
+
+			{
+				ActionListSwitch actionSwitch;
+				Assert::AreEqual("Switch"s, actionSwitch["Name"].Get<std::string>());
+				actionSwitch.SetName("Renamed"s);
+				Assert::AreEqual("Renamed"s, actionSwitch["Name"].Get<std::string>());
+				Assert::IsTrue(actionSwitch.IsPrescribedAttribute("CaseValue"s));
+			}
+			TypeRegistry::Shutdown();
+		}
+
 	private:
 		static _CrtMemState sStartMemState;	//for memory leak detection
 	};
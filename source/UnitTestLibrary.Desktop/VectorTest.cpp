@@ -493,6 +493,43 @@ namespace UnitTestLibraryDesktop
 
 		}
 
+		TEST_METHOD(RemoveUnordered)
+		{
+			Foo a(5), b(10), c(11), d(12);
+
+			//remove from empty list
+			Vector<Foo> list;
+			list.RemoveUnordered(list.begin());
+
+			//remove the only element in the list
+			list.PushBack(a);
+			list.RemoveUnordered(list.Find(a));
+			Assert::IsTrue(list.IsEmpty());
+
+			//remove last element
+			list.PushBack(a);
+			list.PushBack(b);
+			list.PushBack(c);
+			list.RemoveUnordered(list.Find(c));
+			Assert::AreEqual(list.Size(), 2_z);
+			Assert::AreEqual(list[0], a);
+			Assert::AreEqual(list[1], b);
+
+			//remove from the front, the last element takes its place
+			list.PushBack(c);
+			list.PushBack(d);
+			list.RemoveUnordered(list.Find(a));
+			Assert::AreEqual(list.Size(), 3_z);
+			Assert::AreEqual(list[0], d);
+			Assert::AreEqual(list[1], b);
+			Assert::AreEqual(list[2], c);
+			Assert::IsTrue(list.Find(a) == list.end());
+
+			//iterator does not belong to this list
+			Vector<Foo> list2;
+			Assert::ExpectException<std::runtime_error>([&list, &list2] { list.RemoveUnordered(list2.begin()); });
+		}
+
 		/************************************************************************/
 		/*************************Iterator Functions*****************************/
 		/************************************************************************/